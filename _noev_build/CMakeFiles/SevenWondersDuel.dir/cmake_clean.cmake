@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/SevenWondersDuel.dir/src/main.cpp.o"
+  "CMakeFiles/SevenWondersDuel.dir/src/main.cpp.o.d"
+  "SevenWondersDuel"
+  "SevenWondersDuel.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/SevenWondersDuel.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
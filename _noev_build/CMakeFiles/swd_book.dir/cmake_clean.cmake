@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/swd_book.dir/src/tools/book.cpp.o"
+  "CMakeFiles/swd_book.dir/src/tools/book.cpp.o.d"
+  "swd_book"
+  "swd_book.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/swd_book.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
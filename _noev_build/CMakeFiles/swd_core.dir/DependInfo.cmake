@@ -0,0 +1,55 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/ai/BatchPlayout.cpp" "CMakeFiles/swd_core.dir/src/ai/BatchPlayout.cpp.o" "gcc" "CMakeFiles/swd_core.dir/src/ai/BatchPlayout.cpp.o.d"
+  "/root/repo/src/ai/Determinize.cpp" "CMakeFiles/swd_core.dir/src/ai/Determinize.cpp.o" "gcc" "CMakeFiles/swd_core.dir/src/ai/Determinize.cpp.o.d"
+  "/root/repo/src/ai/GreedyBot.cpp" "CMakeFiles/swd_core.dir/src/ai/GreedyBot.cpp.o" "gcc" "CMakeFiles/swd_core.dir/src/ai/GreedyBot.cpp.o.d"
+  "/root/repo/src/ai/HeuristicEval.cpp" "CMakeFiles/swd_core.dir/src/ai/HeuristicEval.cpp.o" "gcc" "CMakeFiles/swd_core.dir/src/ai/HeuristicEval.cpp.o.d"
+  "/root/repo/src/ai/Mlp.cpp" "CMakeFiles/swd_core.dir/src/ai/Mlp.cpp.o" "gcc" "CMakeFiles/swd_core.dir/src/ai/Mlp.cpp.o.d"
+  "/root/repo/src/ai/NetBot.cpp" "CMakeFiles/swd_core.dir/src/ai/NetBot.cpp.o" "gcc" "CMakeFiles/swd_core.dir/src/ai/NetBot.cpp.o.d"
+  "/root/repo/src/ai/NetEvaluator.cpp" "CMakeFiles/swd_core.dir/src/ai/NetEvaluator.cpp.o" "gcc" "CMakeFiles/swd_core.dir/src/ai/NetEvaluator.cpp.o.d"
+  "/root/repo/src/ai/OpeningBook.cpp" "CMakeFiles/swd_core.dir/src/ai/OpeningBook.cpp.o" "gcc" "CMakeFiles/swd_core.dir/src/ai/OpeningBook.cpp.o.d"
+  "/root/repo/src/ai/PonderBot.cpp" "CMakeFiles/swd_core.dir/src/ai/PonderBot.cpp.o" "gcc" "CMakeFiles/swd_core.dir/src/ai/PonderBot.cpp.o.d"
+  "/root/repo/src/ai/ReferenceTableData.cpp" "CMakeFiles/swd_core.dir/src/ai/ReferenceTableData.cpp.o" "gcc" "CMakeFiles/swd_core.dir/src/ai/ReferenceTableData.cpp.o.d"
+  "/root/repo/src/ai/ReferenceTables.cpp" "CMakeFiles/swd_core.dir/src/ai/ReferenceTables.cpp.o" "gcc" "CMakeFiles/swd_core.dir/src/ai/ReferenceTables.cpp.o.d"
+  "/root/repo/src/ai/Search.cpp" "CMakeFiles/swd_core.dir/src/ai/Search.cpp.o" "gcc" "CMakeFiles/swd_core.dir/src/ai/Search.cpp.o.d"
+  "/root/repo/src/cards/Card.cpp" "CMakeFiles/swd_core.dir/src/cards/Card.cpp.o" "gcc" "CMakeFiles/swd_core.dir/src/cards/Card.cpp.o.d"
+  "/root/repo/src/cards/CardSignature.cpp" "CMakeFiles/swd_core.dir/src/cards/CardSignature.cpp.o" "gcc" "CMakeFiles/swd_core.dir/src/cards/CardSignature.cpp.o.d"
+  "/root/repo/src/cards/CardStructure.cpp" "CMakeFiles/swd_core.dir/src/cards/CardStructure.cpp.o" "gcc" "CMakeFiles/swd_core.dir/src/cards/CardStructure.cpp.o.d"
+  "/root/repo/src/cards/PyramidTempo.cpp" "CMakeFiles/swd_core.dir/src/cards/PyramidTempo.cpp.o" "gcc" "CMakeFiles/swd_core.dir/src/cards/PyramidTempo.cpp.o.d"
+  "/root/repo/src/cards/Wonder.cpp" "CMakeFiles/swd_core.dir/src/cards/Wonder.cpp.o" "gcc" "CMakeFiles/swd_core.dir/src/cards/Wonder.cpp.o.d"
+  "/root/repo/src/core/Board.cpp" "CMakeFiles/swd_core.dir/src/core/Board.cpp.o" "gcc" "CMakeFiles/swd_core.dir/src/core/Board.cpp.o.d"
+  "/root/repo/src/core/Game.cpp" "CMakeFiles/swd_core.dir/src/core/Game.cpp.o" "gcc" "CMakeFiles/swd_core.dir/src/core/Game.cpp.o.d"
+  "/root/repo/src/core/GameArena.cpp" "CMakeFiles/swd_core.dir/src/core/GameArena.cpp.o" "gcc" "CMakeFiles/swd_core.dir/src/core/GameArena.cpp.o.d"
+  "/root/repo/src/core/Move.cpp" "CMakeFiles/swd_core.dir/src/core/Move.cpp.o" "gcc" "CMakeFiles/swd_core.dir/src/core/Move.cpp.o.d"
+  "/root/repo/src/core/Snapshot.cpp" "CMakeFiles/swd_core.dir/src/core/Snapshot.cpp.o" "gcc" "CMakeFiles/swd_core.dir/src/core/Snapshot.cpp.o.d"
+  "/root/repo/src/engine/EngineProtocol.cpp" "CMakeFiles/swd_core.dir/src/engine/EngineProtocol.cpp.o" "gcc" "CMakeFiles/swd_core.dir/src/engine/EngineProtocol.cpp.o.d"
+  "/root/repo/src/env/DatasetWriter.cpp" "CMakeFiles/swd_core.dir/src/env/DatasetWriter.cpp.o" "gcc" "CMakeFiles/swd_core.dir/src/env/DatasetWriter.cpp.o.d"
+  "/root/repo/src/env/ObservationEncoder.cpp" "CMakeFiles/swd_core.dir/src/env/ObservationEncoder.cpp.o" "gcc" "CMakeFiles/swd_core.dir/src/env/ObservationEncoder.cpp.o.d"
+  "/root/repo/src/env/VecEnv.cpp" "CMakeFiles/swd_core.dir/src/env/VecEnv.cpp.o" "gcc" "CMakeFiles/swd_core.dir/src/env/VecEnv.cpp.o.d"
+  "/root/repo/src/instrument/AllocTracker.cpp" "CMakeFiles/swd_core.dir/src/instrument/AllocTracker.cpp.o" "gcc" "CMakeFiles/swd_core.dir/src/instrument/AllocTracker.cpp.o.d"
+  "/root/repo/src/instrument/PositionSketch.cpp" "CMakeFiles/swd_core.dir/src/instrument/PositionSketch.cpp.o" "gcc" "CMakeFiles/swd_core.dir/src/instrument/PositionSketch.cpp.o.d"
+  "/root/repo/src/instrument/Profiler.cpp" "CMakeFiles/swd_core.dir/src/instrument/Profiler.cpp.o" "gcc" "CMakeFiles/swd_core.dir/src/instrument/Profiler.cpp.o.d"
+  "/root/repo/src/instrument/Sketch.cpp" "CMakeFiles/swd_core.dir/src/instrument/Sketch.cpp.o" "gcc" "CMakeFiles/swd_core.dir/src/instrument/Sketch.cpp.o.d"
+  "/root/repo/src/instrument/Tracer.cpp" "CMakeFiles/swd_core.dir/src/instrument/Tracer.cpp.o" "gcc" "CMakeFiles/swd_core.dir/src/instrument/Tracer.cpp.o.d"
+  "/root/repo/src/player/CostCalculator.cpp" "CMakeFiles/swd_core.dir/src/player/CostCalculator.cpp.o" "gcc" "CMakeFiles/swd_core.dir/src/player/CostCalculator.cpp.o.d"
+  "/root/repo/src/player/Player.cpp" "CMakeFiles/swd_core.dir/src/player/Player.cpp.o" "gcc" "CMakeFiles/swd_core.dir/src/player/Player.cpp.o.d"
+  "/root/repo/src/view/ConsoleEventLog.cpp" "CMakeFiles/swd_core.dir/src/view/ConsoleEventLog.cpp.o" "gcc" "CMakeFiles/swd_core.dir/src/view/ConsoleEventLog.cpp.o.d"
+  "/root/repo/src/view/ConsoleView.cpp" "CMakeFiles/swd_core.dir/src/view/ConsoleView.cpp.o" "gcc" "CMakeFiles/swd_core.dir/src/view/ConsoleView.cpp.o.d"
+  "/root/repo/src/view/FrameRenderer.cpp" "CMakeFiles/swd_core.dir/src/view/FrameRenderer.cpp.o" "gcc" "CMakeFiles/swd_core.dir/src/view/FrameRenderer.cpp.o.d"
+  "/root/repo/src/view/ctrller.cpp" "CMakeFiles/swd_core.dir/src/view/ctrller.cpp.o" "gcc" "CMakeFiles/swd_core.dir/src/view/ctrller.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
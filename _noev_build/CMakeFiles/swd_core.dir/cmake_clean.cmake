@@ -0,0 +1,83 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/swd_core.dir/src/ai/BatchPlayout.cpp.o"
+  "CMakeFiles/swd_core.dir/src/ai/BatchPlayout.cpp.o.d"
+  "CMakeFiles/swd_core.dir/src/ai/Determinize.cpp.o"
+  "CMakeFiles/swd_core.dir/src/ai/Determinize.cpp.o.d"
+  "CMakeFiles/swd_core.dir/src/ai/GreedyBot.cpp.o"
+  "CMakeFiles/swd_core.dir/src/ai/GreedyBot.cpp.o.d"
+  "CMakeFiles/swd_core.dir/src/ai/HeuristicEval.cpp.o"
+  "CMakeFiles/swd_core.dir/src/ai/HeuristicEval.cpp.o.d"
+  "CMakeFiles/swd_core.dir/src/ai/Mlp.cpp.o"
+  "CMakeFiles/swd_core.dir/src/ai/Mlp.cpp.o.d"
+  "CMakeFiles/swd_core.dir/src/ai/NetBot.cpp.o"
+  "CMakeFiles/swd_core.dir/src/ai/NetBot.cpp.o.d"
+  "CMakeFiles/swd_core.dir/src/ai/NetEvaluator.cpp.o"
+  "CMakeFiles/swd_core.dir/src/ai/NetEvaluator.cpp.o.d"
+  "CMakeFiles/swd_core.dir/src/ai/OpeningBook.cpp.o"
+  "CMakeFiles/swd_core.dir/src/ai/OpeningBook.cpp.o.d"
+  "CMakeFiles/swd_core.dir/src/ai/PonderBot.cpp.o"
+  "CMakeFiles/swd_core.dir/src/ai/PonderBot.cpp.o.d"
+  "CMakeFiles/swd_core.dir/src/ai/ReferenceTableData.cpp.o"
+  "CMakeFiles/swd_core.dir/src/ai/ReferenceTableData.cpp.o.d"
+  "CMakeFiles/swd_core.dir/src/ai/ReferenceTables.cpp.o"
+  "CMakeFiles/swd_core.dir/src/ai/ReferenceTables.cpp.o.d"
+  "CMakeFiles/swd_core.dir/src/ai/Search.cpp.o"
+  "CMakeFiles/swd_core.dir/src/ai/Search.cpp.o.d"
+  "CMakeFiles/swd_core.dir/src/cards/Card.cpp.o"
+  "CMakeFiles/swd_core.dir/src/cards/Card.cpp.o.d"
+  "CMakeFiles/swd_core.dir/src/cards/CardSignature.cpp.o"
+  "CMakeFiles/swd_core.dir/src/cards/CardSignature.cpp.o.d"
+  "CMakeFiles/swd_core.dir/src/cards/CardStructure.cpp.o"
+  "CMakeFiles/swd_core.dir/src/cards/CardStructure.cpp.o.d"
+  "CMakeFiles/swd_core.dir/src/cards/PyramidTempo.cpp.o"
+  "CMakeFiles/swd_core.dir/src/cards/PyramidTempo.cpp.o.d"
+  "CMakeFiles/swd_core.dir/src/cards/Wonder.cpp.o"
+  "CMakeFiles/swd_core.dir/src/cards/Wonder.cpp.o.d"
+  "CMakeFiles/swd_core.dir/src/core/Board.cpp.o"
+  "CMakeFiles/swd_core.dir/src/core/Board.cpp.o.d"
+  "CMakeFiles/swd_core.dir/src/core/Game.cpp.o"
+  "CMakeFiles/swd_core.dir/src/core/Game.cpp.o.d"
+  "CMakeFiles/swd_core.dir/src/core/GameArena.cpp.o"
+  "CMakeFiles/swd_core.dir/src/core/GameArena.cpp.o.d"
+  "CMakeFiles/swd_core.dir/src/core/Move.cpp.o"
+  "CMakeFiles/swd_core.dir/src/core/Move.cpp.o.d"
+  "CMakeFiles/swd_core.dir/src/core/Snapshot.cpp.o"
+  "CMakeFiles/swd_core.dir/src/core/Snapshot.cpp.o.d"
+  "CMakeFiles/swd_core.dir/src/engine/EngineProtocol.cpp.o"
+  "CMakeFiles/swd_core.dir/src/engine/EngineProtocol.cpp.o.d"
+  "CMakeFiles/swd_core.dir/src/env/DatasetWriter.cpp.o"
+  "CMakeFiles/swd_core.dir/src/env/DatasetWriter.cpp.o.d"
+  "CMakeFiles/swd_core.dir/src/env/ObservationEncoder.cpp.o"
+  "CMakeFiles/swd_core.dir/src/env/ObservationEncoder.cpp.o.d"
+  "CMakeFiles/swd_core.dir/src/env/VecEnv.cpp.o"
+  "CMakeFiles/swd_core.dir/src/env/VecEnv.cpp.o.d"
+  "CMakeFiles/swd_core.dir/src/instrument/AllocTracker.cpp.o"
+  "CMakeFiles/swd_core.dir/src/instrument/AllocTracker.cpp.o.d"
+  "CMakeFiles/swd_core.dir/src/instrument/PositionSketch.cpp.o"
+  "CMakeFiles/swd_core.dir/src/instrument/PositionSketch.cpp.o.d"
+  "CMakeFiles/swd_core.dir/src/instrument/Profiler.cpp.o"
+  "CMakeFiles/swd_core.dir/src/instrument/Profiler.cpp.o.d"
+  "CMakeFiles/swd_core.dir/src/instrument/Sketch.cpp.o"
+  "CMakeFiles/swd_core.dir/src/instrument/Sketch.cpp.o.d"
+  "CMakeFiles/swd_core.dir/src/instrument/Tracer.cpp.o"
+  "CMakeFiles/swd_core.dir/src/instrument/Tracer.cpp.o.d"
+  "CMakeFiles/swd_core.dir/src/player/CostCalculator.cpp.o"
+  "CMakeFiles/swd_core.dir/src/player/CostCalculator.cpp.o.d"
+  "CMakeFiles/swd_core.dir/src/player/Player.cpp.o"
+  "CMakeFiles/swd_core.dir/src/player/Player.cpp.o.d"
+  "CMakeFiles/swd_core.dir/src/view/ConsoleEventLog.cpp.o"
+  "CMakeFiles/swd_core.dir/src/view/ConsoleEventLog.cpp.o.d"
+  "CMakeFiles/swd_core.dir/src/view/ConsoleView.cpp.o"
+  "CMakeFiles/swd_core.dir/src/view/ConsoleView.cpp.o.d"
+  "CMakeFiles/swd_core.dir/src/view/FrameRenderer.cpp.o"
+  "CMakeFiles/swd_core.dir/src/view/FrameRenderer.cpp.o.d"
+  "CMakeFiles/swd_core.dir/src/view/ctrller.cpp.o"
+  "CMakeFiles/swd_core.dir/src/view/ctrller.cpp.o.d"
+  "libswd_core.a"
+  "libswd_core.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/swd_core.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
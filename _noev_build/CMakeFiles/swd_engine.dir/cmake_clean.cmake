@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/swd_engine.dir/src/tools/engine.cpp.o"
+  "CMakeFiles/swd_engine.dir/src/tools/engine.cpp.o.d"
+  "swd_engine"
+  "swd_engine.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/swd_engine.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
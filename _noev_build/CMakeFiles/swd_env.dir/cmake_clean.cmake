@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/swd_env.dir/src/capi/swd_env.cpp.o"
+  "CMakeFiles/swd_env.dir/src/capi/swd_env.cpp.o.d"
+  "libswd_env.pdb"
+  "libswd_env.so"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/swd_env.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/swd_fuzz.dir/src/tools/fuzz.cpp.o"
+  "CMakeFiles/swd_fuzz.dir/src/tools/fuzz.cpp.o.d"
+  "swd_fuzz"
+  "swd_fuzz.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/swd_fuzz.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,22 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/net/GameServer.cpp" "CMakeFiles/swd_net.dir/src/net/GameServer.cpp.o" "gcc" "CMakeFiles/swd_net.dir/src/net/GameServer.cpp.o.d"
+  "/root/repo/src/net/Protocol.cpp" "CMakeFiles/swd_net.dir/src/net/Protocol.cpp.o" "gcc" "CMakeFiles/swd_net.dir/src/net/Protocol.cpp.o.d"
+  "/root/repo/src/net/SessionStore.cpp" "CMakeFiles/swd_net.dir/src/net/SessionStore.cpp.o" "gcc" "CMakeFiles/swd_net.dir/src/net/SessionStore.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_noev_build/CMakeFiles/swd_core.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
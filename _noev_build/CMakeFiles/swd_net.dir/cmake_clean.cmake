@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/swd_net.dir/src/net/GameServer.cpp.o"
+  "CMakeFiles/swd_net.dir/src/net/GameServer.cpp.o.d"
+  "CMakeFiles/swd_net.dir/src/net/Protocol.cpp.o"
+  "CMakeFiles/swd_net.dir/src/net/Protocol.cpp.o.d"
+  "CMakeFiles/swd_net.dir/src/net/SessionStore.cpp.o"
+  "CMakeFiles/swd_net.dir/src/net/SessionStore.cpp.o.d"
+  "libswd_net.a"
+  "libswd_net.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/swd_net.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
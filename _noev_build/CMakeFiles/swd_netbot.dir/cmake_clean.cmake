@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/swd_netbot.dir/src/tools/netbot.cpp.o"
+  "CMakeFiles/swd_netbot.dir/src/tools/netbot.cpp.o.d"
+  "swd_netbot"
+  "swd_netbot.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/swd_netbot.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
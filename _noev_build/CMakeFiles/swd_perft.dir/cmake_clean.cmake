@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/swd_perft.dir/src/tools/perft.cpp.o"
+  "CMakeFiles/swd_perft.dir/src/tools/perft.cpp.o.d"
+  "swd_perft"
+  "swd_perft.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/swd_perft.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/swd_server.dir/src/tools/server.cpp.o"
+  "CMakeFiles/swd_server.dir/src/tools/server.cpp.o.d"
+  "swd_server"
+  "swd_server.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/swd_server.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
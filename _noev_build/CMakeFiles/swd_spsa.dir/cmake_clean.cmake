@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/swd_spsa.dir/src/tools/spsa.cpp.o"
+  "CMakeFiles/swd_spsa.dir/src/tools/spsa.cpp.o.d"
+  "swd_spsa"
+  "swd_spsa.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/swd_spsa.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/tournament.dir/src/tools/tournament.cpp.o"
+  "CMakeFiles/tournament.dir/src/tools/tournament.cpp.o.d"
+  "tournament"
+  "tournament.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/tournament.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
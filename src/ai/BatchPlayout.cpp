@@ -0,0 +1,858 @@
+#include "BatchPlayout.h"
+#include "ReferenceTables.h"
+#include "core/Game.h"
+#include "core/Snapshot.h"
+#include "cards/Card.h"
+#include "cards/CardStructure.h"
+#include "instrument/Tracer.h"
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr int kMaxCards = 96;
+constexpr int kMaxWonderIds = 16;
+constexpr int kTradable = 5;          // WOOD, CLAY, STONE, GLASS, PAPYRUS
+constexpr int kWondersPerPlayer = 4;
+constexpr int kBrown = static_cast<int>(Color::BROWN);
+constexpr int kGrey = static_cast<int>(Color::GREY);
+constexpr int kYellow = static_cast<int>(Color::YELLOW);
+
+/**
+ * 平坦规则表：卡牌按字段分列（向量循环按卡牌编号 gather），奇迹与金字塔布局各一张小表
+ * 卡牌与奇迹参数取自检入的固定参数表（ai/ReferenceTables.h），不读卡牌/奇迹目录：
+ * 目录数据写错时 Game 与参考模型因此各走各的，swd_fuzz 能看到分歧
+ */
+struct Tables {
+    // 卡牌：[字段][卡牌编号]
+    int32_t coin_cost[kMaxCards] = {};
+    int32_t need[kTradable][kMaxCards] = {};
+    uint32_t chain_bit[kMaxCards] = {};       // 连锁前置符号位，0 = 无
+    // 以下只在标量结算时使用
+    int8_t color[kMaxCards] = {};
+    int8_t victory_points[kMaxCards] = {};
+    int8_t shields[kMaxCards] = {};
+    uint32_t science_bit[kMaxCards] = {};
+    uint32_t link_bit[kMaxCards] = {};
+    int8_t produce[kTradable][kMaxCards] = {};
+    int8_t coin_gain[kMaxCards] = {};
+    uint8_t fixed_mask[kMaxCards] = {};
+    int8_t wild_raw[kMaxCards] = {};
+    int8_t wild_manufactured[kMaxCards] = {};
+    bool reward_active[kMaxCards] = {};
+    int8_t reward_color[kMaxCards] = {};
+    int8_t reward_coins[kMaxCards] = {};
+    bool reward_wonders[kMaxCards] = {};
+    bool reward_both[kMaxCards] = {};
+    int card_count = 0;
+    std::vector<uint8_t> age_ids[rules::kAges];   // 各时代的卡牌编号（目录顺序）
+
+    // 奇迹
+    int32_t wonder_coin_cost[kMaxWonderIds] = {};
+    int32_t wonder_need[kTradable][kMaxWonderIds] = {};
+    int8_t wonder_vp[kMaxWonderIds] = {};
+    int8_t wonder_shields[kMaxWonderIds] = {};
+    int8_t wonder_self_coins[kMaxWonderIds] = {};
+    int8_t wonder_opp_coins[kMaxWonderIds] = {};
+    int8_t wonder_wild_raw[kMaxWonderIds] = {};
+    int8_t wonder_wild_manufactured[kMaxWonderIds] = {};
+    uint8_t wonder_flags[kMaxWonderIds] = {};
+    int8_t destroy_color[kMaxWonderIds] = {};
+    int8_t token_offer[kMaxWonderIds] = {};
+    int wonder_count = 0;
+
+    // 金字塔：压住各槽位的槽位位集 [时代][槽位]
+    uint32_t blockers[rules::kAges][rules::kPyramidSlots] = {};
+};
+
+bool is_raw_choice(uint16_t bits) {
+    return bits == ((1u << (int)Resource::WOOD) | (1u << (int)Resource::CLAY) | (1u << (int)Resource::STONE));
+}
+bool is_manufactured_choice(uint16_t bits) {
+    return bits == ((1u << (int)Resource::GLASS) | (1u << (int)Resource::PAPYRUS));
+}
+
+void load_cards(Tables& t) {
+    if (reference::kCardCount > kMaxCards) throw std::logic_error("BatchPlayout: card table too large");
+    t.card_count = reference::kCardCount;
+    for (int id = 0; id < reference::kCardCount; ++id) {
+        const reference::CardRow& c = reference::kCards[id];
+        t.color[id] = c.color;
+        t.victory_points[id] = c.victory_points;
+        t.shields[id] = c.shields;
+        if (c.science >= 0) t.science_bit[id] = 1u << c.science;
+        if (c.link >= 0) t.link_bit[id] = 1u << c.link;
+        if (c.chain >= 0) t.chain_bit[id] = 1u << c.chain;
+        t.coin_cost[id] = c.coin_cost;
+        for (int r = 0; r < kTradable; ++r) {
+            t.need[r][id] = c.need[r];
+            t.produce[r][id] = c.produce[r];
+        }
+        t.reward_active[id] = c.reward_active != 0;
+        t.reward_color[id] = c.reward_color;
+        t.reward_coins[id] = c.reward_coins;
+        t.reward_wonders[id] = c.reward_wonders != 0;
+        t.reward_both[id] = c.reward_both != 0;
+        if (c.age >= 1 && c.age <= rules::kAges) t.age_ids[c.age - 1].push_back(static_cast<uint8_t>(id));
+        t.coin_gain[id] = c.coin_gain;
+        t.fixed_mask[id] = c.fixed_mask;
+        t.wild_raw[id] = c.wild_raw;
+        t.wild_manufactured[id] = c.wild_manufactured;
+    }
+}
+
+void load_wonders(Tables& t) {
+    if (reference::kWonderCount > kMaxWonderIds) throw std::logic_error("BatchPlayout: wonder table too large");
+    t.wonder_count = reference::kWonderCount;
+    for (int id = 0; id < reference::kWonderCount; ++id) {
+        const reference::WonderRow& w = reference::kWonders[id];
+        t.wonder_coin_cost[id] = w.coin_cost;
+        for (int r = 0; r < kTradable; ++r) t.wonder_need[r][id] = w.need[r];
+        t.wonder_vp[id] = w.victory_points;
+        t.wonder_shields[id] = w.shields;
+        t.wonder_self_coins[id] = w.self_coins;
+        t.wonder_opp_coins[id] = w.opp_coins;
+        t.wonder_wild_raw[id] = w.wild_raw;
+        t.wonder_wild_manufactured[id] = w.wild_manufactured;
+        t.wonder_flags[id] = w.flags;
+        t.destroy_color[id] = w.destroy_color;
+        t.token_offer[id] = w.token_offer;
+    }
+}
+
+void extract_layouts(Tables& t) {
+    for (int a = 1; a <= rules::kAges; ++a) {
+        CardStructure layout(a, std::vector<std::unique_ptr<Card>>(rules::kPyramidSlots));
+        for (int p = 0; p < rules::kPyramidSlots; ++p) t.blockers[a - 1][p] = layout.blockers_mask(p);
+    }
+}
+
+const Tables& tables() {
+    static const Tables t = [] {
+        Tables built;
+        load_cards(built);
+        load_wonders(built);
+        extract_layouts(built);
+        return built;
+    }();
+    return t;
+}
+
+int nth_set_bit(uint32_t mask, uint32_t n) {
+    for (uint32_t i = 0; i < n; ++i) mask &= mask - 1;
+    return __builtin_ctz(mask);
+}
+
+// 与 Game 发牌相同：同一种子、同一随机流、同样的 std::shuffle
+void deal(uint64_t seed, uint8_t decks[rules::kAges][rules::kPyramidSlots], uint8_t wonder_ids[2][kWondersPerPlayer],
+          uint8_t pool[5]) {
+    const Tables& t = tables();
+    for (int a = 1; a <= rules::kAges; ++a) {
+        std::vector<uint8_t> ids = t.age_ids[a - 1];
+        std::mt19937 g = Game::seeded_rng(seed, a);
+        std::shuffle(ids.begin(), ids.end(), g);
+        std::copy(ids.begin(), ids.begin() + rules::kPyramidSlots, decks[a - 1]);
+    }
+
+    std::vector<uint8_t> w(t.wonder_count);
+    std::iota(w.begin(), w.end(), 0);
+    std::mt19937 gw = Game::seeded_rng(seed, 0);
+    std::shuffle(w.begin(), w.end(), gw);
+    for (int i = 0; i < kWondersPerPlayer; ++i) {
+        wonder_ids[0][i] = w[i];
+        wonder_ids[1][i] = w[kWondersPerPlayer + i];
+    }
+
+    uint8_t tokens[10];
+    std::iota(tokens, tokens + 10, 0);
+    std::mt19937 gt = Game::seeded_rng(seed, 4);
+    std::shuffle(tokens, tokens + 10, gt);
+    std::copy(tokens + 5, tokens + 10, pool);
+}
+
+// matches() 的差异描述
+bool report(std::string* diff, const std::string& what, long reference, long game) {
+    if (diff) *diff = what + ": reference " + std::to_string(reference) + ", Game " + std::to_string(game);
+    return false;
+}
+
+} // namespace
+
+BatchPlayout::BatchPlayout(uint64_t rng_seed) {
+    tables();
+    for (int l = 0; l < kLanes; ++l) {
+        active[l] = 0;
+        over[l] = 1;
+        // 空闲通道也参与向量计算：给出合法的卡牌下标，避免读到未初始化的值
+        age[l] = 1;
+        current[l] = 0;
+        present[l] = 0;
+        for (int p = 0; p < rules::kPyramidSlots; ++p) slot_card[p][l] = 0;
+        // splitmix64 派生各通道的 xorshift32 状态（不能为 0）
+        uint64_t z = rng_seed + 0x9E3779B97F4A7C15ull * (l + 1);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        rng[l] = static_cast<uint32_t>(z ^ (z >> 31)) | 1u;
+    }
+}
+
+void BatchPlayout::reset_lane(int l, uint64_t game_seed) {
+    LaneLists& lists_l = lists[l];
+    uint8_t wonder_ids[2][kWondersPerPlayer];
+    deal(game_seed, lists_l.decks, wonder_ids, lists_l.pool);
+    lists_l.pool_count = 5;
+    lists_l.discard_count = 0;
+    lists_l.built_count[0] = lists_l.built_count[1] = 0;
+    std::fill(&lists_l.foundation[0][0], &lists_l.foundation[0][0] + 2 * kWondersPerPlayer, GameSnapshot::kEmpty);
+
+    active[l] = 1;
+    over[l] = 0;
+    current[l] = 0;
+    extra_turn[l] = 0;
+    pending[l] = PICK_ACTION;
+    pawn[l] = rules::kPawnStart;
+    looting[l] = 0xF;
+    moves_played[l] = 0;
+    for (int p = 0; p < 2; ++p) {
+        coins[p][l] = 14;   // 与 Game 一致：Player 构造 7 + 开局 7
+        vp[p][l] = 0;
+        for (int r = 0; r < kTradable; ++r) production[p][r][l] = 0;
+        wild_raw[p][l] = wild_manufactured[p][l] = 0;
+        fixed_trade[p][l] = 0;
+        for (int c = 0; c < 7; ++c) color_count[p][c][l] = 0;
+        links[p][l] = science[p][l] = tokens[p][l] = 0;
+        wonder_stages[p][l] = 0;
+        wonder_built[p][l] = 0;
+        for (int i = 0; i < kWondersPerPlayer; ++i) wonders[p][i][l] = wonder_ids[p][i];
+    }
+    setup_age(l, 1);
+}
+
+bool BatchPlayout::load_lane(int l, const GameSnapshot& snap) {
+    if (!snap.is_valid()) return false;
+    for (int p = 0; p < 2; ++p) {
+        if (snap.players[p].wonder_count != kWondersPerPlayer) return false;
+    }
+    LaneLists& lists_l = lists[l];
+    uint8_t wonder_ids[2][kWondersPerPlayer];
+    uint8_t pool_unused[5];
+    deal(snap.seed, lists_l.decks, wonder_ids, pool_unused);
+
+    active[l] = 1;
+    over[l] = snap.game_over;
+    age[l] = snap.current_age;
+    current[l] = snap.current_player;
+    extra_turn[l] = snap.extra_turn;
+    pending[l] = snap.decision_type;
+    pending_pos[l] = snap.decision_pos;
+    pending_color[l] = static_cast<int8_t>(snap.decision_color);
+    offered_count[l] = snap.offered_token_count;
+    pawn[l] = snap.pawn_position;
+    looting[l] = 0;
+    for (int i = 0; i < 4; ++i) looting[l] |= (snap.looting_tokens[i] ? 1 : 0) << i;
+    moves_played[l] = 0;
+
+    lists_l.pool_count = static_cast<uint8_t>(std::min<int>(snap.pool_token_count, 10));
+    std::copy(snap.pool_tokens, snap.pool_tokens + lists_l.pool_count, lists_l.pool);
+    lists_l.discard_count = static_cast<uint8_t>(std::min<int>(snap.discard_count, kMaxDiscard));
+    std::copy(snap.discard, snap.discard + lists_l.discard_count, lists_l.discard);
+
+    present[l] = 0;
+    for (int p = 0; p < rules::kPyramidSlots; ++p) {
+        slot_card[p][l] = snap.slots[p] == GameSnapshot::kEmpty ? 0 : snap.slots[p];
+        if (snap.slots[p] != GameSnapshot::kEmpty) present[l] |= 1u << p;
+    }
+
+    for (int p = 0; p < 2; ++p) {
+        const GameSnapshot::PlayerState& ps = snap.players[p];
+        coins[p][l] = ps.coins;
+        vp[p][l] = ps.victory_points;
+        for (int r = 0; r < kTradable; ++r) production[p][r][l] = ps.resources[r];
+        fixed_trade[p][l] = 0;
+        for (int r = 0; r < kTradable; ++r) {
+            if (ps.fixed_trade_costs[r] == 1) fixed_trade[p][l] |= 1 << r;
+        }
+        wild_raw[p][l] = wild_manufactured[p][l] = 0;
+        for (int i = 0; i < ps.wildcard_count && i < GameSnapshot::kMaxWildcards; ++i) {
+            if (is_raw_choice(ps.wildcards[i])) wild_raw[p][l]++;
+            else if (is_manufactured_choice(ps.wildcards[i])) wild_manufactured[p][l]++;
+            else return false;
+        }
+        for (int c = 0; c < 7; ++c) color_count[p][c][l] = ps.cards_by_color[c];
+        links[p][l] = ps.link_symbols;
+        science[p][l] = ps.science_symbols;
+        tokens[p][l] = ps.progress_tokens;
+        wonder_stages[p][l] = ps.built_wonders_count;
+        wonder_built[p][l] = 0;
+        for (int i = 0; i < kWondersPerPlayer; ++i) {
+            wonders[p][i][l] = ps.wonders[i];
+            if (ps.wonder_built[i]) wonder_built[p][l] |= 1u << i;
+            lists_l.foundation[p][i] = ps.wonder_foundation[i];
+        }
+        lists_l.built_count[p] = static_cast<uint8_t>(std::min<int>(ps.built_card_count, kMaxBuilt));
+        std::copy(ps.built_cards, ps.built_cards + lists_l.built_count[p], lists_l.built[p]);
+    }
+    return true;
+}
+
+void BatchPlayout::setup_age(int l, int next_age) {
+    age[l] = next_age;
+    present[l] = (1u << rules::kPyramidSlots) - 1;
+    for (int p = 0; p < rules::kPyramidSlots; ++p) slot_card[p][l] = lists[l].decks[next_age - 1][p];
+}
+
+// ===== 向量部分 =====
+
+void BatchPlayout::compute_action_masks() {
+    const Tables& t = tables();
+
+    // 当前玩家视角的各项数值（按通道选择座位，无分支）
+    alignas(64) int32_t my_coins[kLanes];
+    alignas(64) int32_t my_prod[kTradable][kLanes];
+    alignas(64) int32_t price[kTradable][kLanes];
+    alignas(64) int32_t my_wild_raw[kLanes];
+    alignas(64) int32_t my_wild_manufactured[kLanes];
+    alignas(64) uint32_t my_links[kLanes];
+
+    for (int l = 0; l < kLanes; ++l) {
+        const int c = current[l];
+        my_coins[l] = c ? coins[1][l] : coins[0][l];
+        my_wild_raw[l] = c ? wild_raw[1][l] : wild_raw[0][l];
+        my_wild_manufactured[l] = c ? wild_manufactured[1][l] : wild_manufactured[0][l];
+        my_links[l] = c ? links[1][l] : links[0][l];
+        const int32_t fixed = c ? fixed_trade[1][l] : fixed_trade[0][l];
+        const int32_t opp_brown = c ? color_count[0][kBrown][l] : color_count[1][kBrown][l];
+        const int32_t opp_grey = c ? color_count[0][kGrey][l] : color_count[1][kGrey][l];
+        for (int r = 0; r < kTradable; ++r) {
+            my_prod[r][l] = c ? production[1][r][l] : production[0][r][l];
+            const int32_t market = 2 + (r < 3 ? opp_brown : opp_grey);
+            price[r][l] = ((fixed >> r) & 1) ? 1 : market;
+        }
+    }
+
+    // 可拿取：槽位仍在，且压住它的槽位都已取走
+    for (int l = 0; l < kLanes; ++l) accessible[l] = 0;
+    for (int p = 0; p < rules::kPyramidSlots; ++p) {
+        const uint32_t b1 = t.blockers[0][p], b2 = t.blockers[1][p], b3 = t.blockers[2][p];
+        for (int l = 0; l < kLanes; ++l) {
+            const uint32_t blockers = age[l] == 1 ? b1 : (age[l] == 2 ? b2 : b3);
+            const uint32_t open = ((present[l] >> p) & 1u) & static_cast<uint32_t>((present[l] & blockers) == 0);
+            accessible[l] |= open << p;
+        }
+    }
+
+    // 建造费用与可负担判定（与 CostCalculator 相同：产出 → 多选一 → 按交易价补足）
+    for (int l = 0; l < kLanes; ++l) buildable[l] = 0;
+    for (int p = 0; p < rules::kPyramidSlots; ++p) {
+        for (int l = 0; l < kLanes; ++l) {
+            const int id = slot_card[p][l];
+            int32_t shortage[kTradable];
+            for (int r = 0; r < kTradable; ++r) shortage[r] = std::max(0, t.need[r][id] - my_prod[r][l]);
+
+            // 多选一按资源顺序依次抵扣（木/泥/石 与 玻璃/纸草 两组互不相交）
+            int32_t w = my_wild_raw[l];
+            for (int r = 0; r < 3; ++r) {
+                const int32_t d = std::min(w, shortage[r]);
+                shortage[r] -= d;
+                w -= d;
+            }
+            w = my_wild_manufactured[l];
+            for (int r = 3; r < kTradable; ++r) {
+                const int32_t d = std::min(w, shortage[r]);
+                shortage[r] -= d;
+                w -= d;
+            }
+
+            int32_t cost = t.coin_cost[id];
+            for (int r = 0; r < kTradable; ++r) cost += shortage[r] * price[r][l];
+            const bool chain = (t.chain_bit[id] & my_links[l]) != 0;
+            cost = chain ? 0 : cost;
+            build_cost[p][l] = cost;
+            const uint32_t ok = ((accessible[l] >> p) & 1u) & static_cast<uint32_t>(chain | (cost <= my_coins[l]));
+            buildable[l] |= ok << p;
+        }
+    }
+
+    // 奇迹费用与可建判定：同样的缺口/多选一/交易流程，没有连锁；双方合计已建 7 座后不能再建
+    for (int l = 0; l < kLanes; ++l) wonder_ok[l] = 0;
+    for (int i = 0; i < kWondersPerPlayer; ++i) {
+        for (int l = 0; l < kLanes; ++l) {
+            const int id = current[l] ? wonders[1][i][l] : wonders[0][i][l];
+            int32_t shortage[kTradable];
+            for (int r = 0; r < kTradable; ++r) shortage[r] = std::max(0, t.wonder_need[r][id] - my_prod[r][l]);
+            int32_t w = my_wild_raw[l];
+            for (int r = 0; r < 3; ++r) {
+                const int32_t d = std::min(w, shortage[r]);
+                shortage[r] -= d;
+                w -= d;
+            }
+            w = my_wild_manufactured[l];
+            for (int r = 3; r < kTradable; ++r) {
+                const int32_t d = std::min(w, shortage[r]);
+                shortage[r] -= d;
+                w -= d;
+            }
+            int32_t cost = t.wonder_coin_cost[id];
+            for (int r = 0; r < kTradable; ++r) cost += shortage[r] * price[r][l];
+            wonder_cost[i][l] = cost;
+            const uint32_t built = current[l] ? wonder_built[1][l] : wonder_built[0][l];
+            const uint32_t open_slots = static_cast<uint32_t>(wonder_stages[0][l] + wonder_stages[1][l] < rules::kMaxWondersBuilt);
+            const uint32_t ok = ((~built >> i) & 1u) & open_slots & static_cast<uint32_t>(cost <= my_coins[l]);
+            wonder_ok[l] |= ok << i;
+        }
+    }
+
+    // 动作总数：建造 + 每张可拿取的牌（弃牌 + 每个可建奇迹）
+    for (int l = 0; l < kLanes; ++l) {
+        action_count[l] = __builtin_popcount(buildable[l]) + __builtin_popcount(accessible[l]) * (1 + __builtin_popcount(wonder_ok[l]));
+    }
+}
+
+uint32_t BatchPlayout::next_random(int l) {
+    uint32_t x = rng[l];
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    rng[l] = x;
+    return x;
+}
+
+int BatchPlayout::step() {
+    SWD_TRACE_SCOPE("batch_step");
+    compute_action_masks();
+
+    // 各通道同时前进一次 xorshift32，并按动作总数做乘法取模
+    alignas(64) uint32_t draw[kLanes];
+    for (int l = 0; l < kLanes; ++l) {
+        uint32_t x = rng[l];
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        rng[l] = x;
+        draw[l] = static_cast<uint32_t>((static_cast<uint64_t>(x) * action_count[l]) >> 32);
+    }
+
+    int advanced = 0;
+    for (int l = 0; l < kLanes; ++l) {
+        if (!active[l] || over[l]) continue;
+        advanced++;
+        moves_played[l]++;
+        choices[l] = decision_count(l);
+        if (pending[l] != PICK_ACTION) {
+            apply_sub_decision(l, next_random(l));
+        } else if (action_count[l] == 0) {
+            // 没有合法动作（不应出现）：按对局结束处理，与逐局驱动一致
+            over[l] = 1;
+            pending[l] = GAME_OVER;
+        } else {
+            apply_action(l, draw[l]);
+        }
+    }
+    return advanced;
+}
+
+uint32_t BatchPlayout::decision_count(int l) const {
+    if (over[l]) return 0;
+    const int me = current[l];
+    switch (pending[l]) {
+        case PICK_ACTION: return action_count[l];
+        case CHOOSE_WONDER: return __builtin_popcount(wonder_ok[l]);
+        case CHOOSE_PROGRESS_TOKEN: return offered_count[l];
+        case CHOOSE_DISCARDED_CARD: return lists[l].discard_count;
+        case CHOOSE_CARD_TO_DESTROY: {
+            const Tables& t = tables();
+            const LaneLists& lists_l = lists[l];
+            uint32_t candidates = 0;
+            for (int i = 0; i < lists_l.built_count[1 - me]; ++i) candidates += t.color[lists_l.built[1 - me][i]] == pending_color[l];
+            return candidates;
+        }
+        default: return 0;
+    }
+}
+
+// ===== 单通道驱动（复现与校验） =====
+
+void BatchPlayout::legal_moves(int l, std::vector<Move>& out) {
+    out.clear();
+    if (!active[l] || over[l]) return;
+    compute_action_masks();
+    const Tables& t = tables();
+    const LaneLists& lists_l = lists[l];
+    const int me = current[l];
+    const uint32_t wonder_mask = wonder_ok[l];
+
+    // 与 apply_action / apply_sub_decision 对编号 r 的解码顺序一一对应
+    switch (pending[l]) {
+        case PICK_ACTION:
+            for (uint32_t m = buildable[l]; m; m &= m - 1) out.emplace_back(Move::Type::BUILD, __builtin_ctz(m));
+            for (uint32_t m = accessible[l]; m; m &= m - 1) {
+                const int pos = __builtin_ctz(m);
+                out.emplace_back(Move::Type::DISCARD, pos);
+                for (uint32_t w = wonder_mask; w; w &= w - 1) out.emplace_back(Move::Type::WONDER, pos, __builtin_ctz(w));
+            }
+            break;
+        case CHOOSE_WONDER:
+            for (uint32_t w = wonder_mask; w; w &= w - 1) out.emplace_back(Move::Type::CHOOSE_WONDER, pending_pos[l], __builtin_ctz(w));
+            break;
+        case CHOOSE_PROGRESS_TOKEN:
+            for (int i = 0; i < offered_count[l]; ++i) out.emplace_back(Move::Type::PICK_TOKEN, lists_l.pool[i]);
+            break;
+        case CHOOSE_DISCARDED_CARD:
+            for (int i = 0; i < lists_l.discard_count; ++i) out.emplace_back(Move::Type::BUILD_DISCARDED, i);
+            break;
+        case CHOOSE_CARD_TO_DESTROY:
+            for (int i = 0; i < lists_l.built_count[1 - me]; ++i) {
+                if (t.color[lists_l.built[1 - me][i]] == pending_color[l]) out.emplace_back(Move::Type::DESTROY_CARD, i);
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+bool BatchPlayout::apply_move(int l, const Move& move) {
+    std::vector<Move> legal;
+    legal_moves(l, legal);   // 同时刷新了 apply_action 所需的掩码与费用
+    const auto it = std::find(legal.begin(), legal.end(), move);
+    if (it == legal.end()) return false;
+    const uint32_t r = static_cast<uint32_t>(it - legal.begin());
+    moves_played[l]++;
+    choices[l] = static_cast<uint32_t>(legal.size());
+    if (pending[l] != PICK_ACTION) apply_sub_decision(l, r);
+    else apply_action(l, r);
+    return true;
+}
+
+bool BatchPlayout::matches(int l, const GameSnapshot& snap, std::string* diff) const {
+    if (over[l] != snap.game_over) return report(diff, "game over", over[l], snap.game_over);
+    if (pawn[l] != snap.pawn_position) return report(diff, "pawn", pawn[l], snap.pawn_position);
+    // 对局结束后 Game 的时代与轮次停在何处不属于规则，只在进行中比较
+    if (!over[l]) {
+        if (age[l] != snap.current_age) return report(diff, "age", age[l], snap.current_age);
+        if (current[l] != snap.current_player) return report(diff, "current player", current[l], snap.current_player);
+        if (extra_turn[l] != snap.extra_turn) return report(diff, "extra turn", extra_turn[l], snap.extra_turn);
+        if (pending[l] != snap.decision_type) return report(diff, "decision", pending[l], snap.decision_type);
+        if (pending[l] == CHOOSE_WONDER && pending_pos[l] != snap.decision_pos) {
+            return report(diff, "decision pos", pending_pos[l], snap.decision_pos);
+        }
+        if (pending[l] == CHOOSE_CARD_TO_DESTROY && pending_color[l] != snap.decision_color) {
+            return report(diff, "decision color", pending_color[l], snap.decision_color);
+        }
+        if (pending[l] == CHOOSE_PROGRESS_TOKEN) {
+            if (offered_count[l] != snap.offered_token_count) {
+                return report(diff, "offered tokens", offered_count[l], snap.offered_token_count);
+            }
+            for (int i = 0; i < offered_count[l]; ++i) {
+                if (lists[l].pool[i] != snap.offered_tokens[i]) {
+                    return report(diff, "offered token " + std::to_string(i), lists[l].pool[i], snap.offered_tokens[i]);
+                }
+            }
+        }
+    }
+    for (int i = 0; i < 4; ++i) {
+        const int mine = (looting[l] >> i) & 1;
+        if (mine != (snap.looting_tokens[i] != 0)) return report(diff, "looting token " + std::to_string(i), mine, snap.looting_tokens[i]);
+    }
+
+    const LaneLists& lists_l = lists[l];
+    if (lists_l.pool_count != snap.pool_token_count) return report(diff, "token pool size", lists_l.pool_count, snap.pool_token_count);
+    for (int i = 0; i < lists_l.pool_count; ++i) {
+        if (lists_l.pool[i] != snap.pool_tokens[i]) return report(diff, "token pool " + std::to_string(i), lists_l.pool[i], snap.pool_tokens[i]);
+    }
+    if (lists_l.discard_count != snap.discard_count) return report(diff, "discard size", lists_l.discard_count, snap.discard_count);
+    for (int i = 0; i < lists_l.discard_count; ++i) {
+        if (lists_l.discard[i] != snap.discard[i]) return report(diff, "discard " + std::to_string(i), lists_l.discard[i], snap.discard[i]);
+    }
+    for (int p = 0; p < rules::kPyramidSlots; ++p) {
+        const int mine = (present[l] >> p) & 1 ? slot_card[p][l] : GameSnapshot::kEmpty;
+        if (mine != snap.slots[p]) return report(diff, "pyramid slot " + std::to_string(p), mine, snap.slots[p]);
+    }
+
+    for (int p = 0; p < 2; ++p) {
+        const GameSnapshot::PlayerState& ps = snap.players[p];
+        const std::string who = "player " + std::to_string(p) + " ";
+        if (coins[p][l] != ps.coins) return report(diff, who + "coins", coins[p][l], ps.coins);
+        if (vp[p][l] != ps.victory_points) return report(diff, who + "victory points", vp[p][l], ps.victory_points);
+        for (int r = 0; r < kTradable; ++r) {
+            if (production[p][r][l] != ps.resources[r]) return report(diff, who + "resource " + std::to_string(r), production[p][r][l], ps.resources[r]);
+        }
+        int fixed = 0, raw = 0, manufactured = 0;
+        for (int r = 0; r < kTradable; ++r) fixed |= (ps.fixed_trade_costs[r] == 1) << r;
+        for (int i = 0; i < ps.wildcard_count && i < GameSnapshot::kMaxWildcards; ++i) {
+            raw += is_raw_choice(ps.wildcards[i]);
+            manufactured += is_manufactured_choice(ps.wildcards[i]);
+        }
+        if (fixed_trade[p][l] != fixed) return report(diff, who + "fixed trade", fixed_trade[p][l], fixed);
+        if (wild_raw[p][l] != raw) return report(diff, who + "raw wildcards", wild_raw[p][l], raw);
+        if (wild_manufactured[p][l] != manufactured) return report(diff, who + "manufactured wildcards", wild_manufactured[p][l], manufactured);
+        if (raw + manufactured != ps.wildcard_count) return report(diff, who + "wildcards", raw + manufactured, ps.wildcard_count);
+        for (int c = 0; c < 7; ++c) {
+            if (color_count[p][c][l] != ps.cards_by_color[c]) return report(diff, who + "color " + std::to_string(c), color_count[p][c][l], ps.cards_by_color[c]);
+        }
+        if (links[p][l] != ps.link_symbols) return report(diff, who + "links", links[p][l], ps.link_symbols);
+        if (science[p][l] != ps.science_symbols) return report(diff, who + "science", science[p][l], ps.science_symbols);
+        if (tokens[p][l] != ps.progress_tokens) return report(diff, who + "progress tokens", tokens[p][l], ps.progress_tokens);
+        if (wonder_stages[p][l] != ps.built_wonders_count) return report(diff, who + "wonders built", wonder_stages[p][l], ps.built_wonders_count);
+        for (int i = 0; i < kWondersPerPlayer; ++i) {
+            if (wonders[p][i][l] != ps.wonders[i]) return report(diff, who + "wonder " + std::to_string(i), wonders[p][i][l], ps.wonders[i]);
+            const int built = (wonder_built[p][l] >> i) & 1;
+            if (built != (ps.wonder_built[i] != 0)) return report(diff, who + "wonder built " + std::to_string(i), built, ps.wonder_built[i]);
+            if (lists_l.foundation[p][i] != ps.wonder_foundation[i]) return report(diff, who + "wonder foundation " + std::to_string(i), lists_l.foundation[p][i], ps.wonder_foundation[i]);
+        }
+        if (lists_l.built_count[p] != ps.built_card_count) return report(diff, who + "card count", lists_l.built_count[p], ps.built_card_count);
+        for (int i = 0; i < lists_l.built_count[p]; ++i) {
+            if (lists_l.built[p][i] != ps.built_cards[i]) return report(diff, who + "card " + std::to_string(i), lists_l.built[p][i], ps.built_cards[i]);
+        }
+    }
+    return true;
+}
+
+// ===== 标量部分 =====
+
+void BatchPlayout::apply_action(int l, uint32_t r) {
+    const int me = current[l];
+    pending[l] = PICK_ACTION;
+    const uint32_t builds = __builtin_popcount(buildable[l]);
+
+    if (r < builds) {
+        const int pos = nth_set_bit(buildable[l], r);
+        const int card = slot_card[pos][l];
+        coins[me][l] -= build_cost[pos][l];
+        take_from_pyramid(l, pos);
+        build_card(l, me, card);
+        last[l] = Move(Move::Type::BUILD, pos);
+    } else {
+        r -= builds;
+        const uint32_t per_card = 1 + __builtin_popcount(wonder_ok[l]);
+        const int pos = nth_set_bit(accessible[l], r / per_card);
+        const uint32_t choice = r % per_card;
+        if (choice == 0) {
+            const int card = slot_card[pos][l];
+            take_from_pyramid(l, pos);
+            add_coins(l, me, 2 + color_count[me][kYellow][l]);
+            LaneLists& lists_l = lists[l];
+            lists_l.discard[lists_l.discard_count++] = static_cast<uint8_t>(card);
+            last[l] = Move(Move::Type::DISCARD, pos);
+        } else {
+            const int w = nth_set_bit(wonder_ok[l], choice - 1);
+            build_wonder(l, me, w, pos);
+            last[l] = Move(Move::Type::WONDER, pos, w);
+        }
+    }
+    if (over[l] || pending[l] == PICK_ACTION) finish_turn(l);
+}
+
+void BatchPlayout::apply_sub_decision(int l, uint32_t r) {
+    const int me = current[l];
+    LaneLists& lists_l = lists[l];
+    const uint8_t asked = pending[l];
+    pending[l] = PICK_ACTION;
+
+    switch (asked) {
+        case CHOOSE_WONDER: {
+            const int w = nth_set_bit(wonder_ok[l], r % __builtin_popcount(wonder_ok[l]));
+            build_wonder(l, me, w, pending_pos[l]);
+            last[l] = Move(Move::Type::CHOOSE_WONDER, pending_pos[l], w);
+            break;
+        }
+        case CHOOSE_PROGRESS_TOKEN: {
+            const int i = r % offered_count[l];
+            const int token = lists_l.pool[i];
+            std::copy(lists_l.pool + i + 1, lists_l.pool + lists_l.pool_count, lists_l.pool + i);
+            lists_l.pool_count--;
+            tokens[me][l] |= 1u << token;
+            switch (static_cast<ProgressToken>(token)) {
+                case ProgressToken::AGRICULTURE: add_coins(l, me, 6); vp[me][l] += 4; break;
+                case ProgressToken::URBANISM:    add_coins(l, me, 6); break;
+                case ProgressToken::PHILOSOPHY:  vp[me][l] += 7; break;
+                case ProgressToken::LAW:         science[me][l] |= 1u << (int)Resource::LAW; break;
+                default: break;
+            }
+            last[l] = Move(Move::Type::PICK_TOKEN, token);
+            break;
+        }
+        case CHOOSE_DISCARDED_CARD: {
+            const int i = r % lists_l.discard_count;
+            const int card = lists_l.discard[i];
+            std::copy(lists_l.discard + i + 1, lists_l.discard + lists_l.discard_count, lists_l.discard + i);
+            lists_l.discard_count--;
+            build_card(l, me, card);
+            last[l] = Move(Move::Type::BUILD_DISCARDED, i);
+            break;
+        }
+        case CHOOSE_CARD_TO_DESTROY: {
+            const Tables& t = tables();
+            const int opp = 1 - me;
+            int candidates = 0;
+            for (int i = 0; i < lists_l.built_count[opp]; ++i) candidates += t.color[lists_l.built[opp][i]] == pending_color[l];
+            int pick = r % candidates;
+            int idx = 0;
+            for (; idx < lists_l.built_count[opp]; ++idx) {
+                if (t.color[lists_l.built[opp][idx]] == pending_color[l] && pick-- == 0) break;
+            }
+            destroy_card(l, opp, idx);
+            last[l] = Move(Move::Type::DESTROY_CARD, idx);
+            break;
+        }
+        default:
+            over[l] = 1;
+            break;
+    }
+    if (over[l] || pending[l] == PICK_ACTION) finish_turn(l);
+}
+
+void BatchPlayout::take_from_pyramid(int l, int pos) {
+    present[l] &= ~(1u << pos);
+}
+
+void BatchPlayout::add_coins(int l, int player, int amount) {
+    coins[player][l] = std::max(0, coins[player][l] + amount);
+}
+
+void BatchPlayout::build_card(int l, int p, int card) {
+    const Tables& t = tables();
+    const int opp = 1 - p;
+    vp[p][l] += t.victory_points[card];
+    if (t.shields[card] > 0) move_pawn(l, p, t.shields[card]);
+    science[p][l] |= t.science_bit[card];
+    links[p][l] |= t.link_bit[card];
+    if (t.reward_active[card]) {
+        int count;
+        if (t.reward_wonders[card]) {
+            count = wonder_stages[p][l];
+            if (t.reward_both[card]) count = std::max(count, wonder_stages[opp][l]);
+        } else {
+            const int own = color_count[p][t.reward_color[card]][l];
+            const int theirs = color_count[opp][t.reward_color[card]][l];
+            count = t.reward_both[card] ? std::max(own, theirs) : own;
+        }
+        add_coins(l, p, count * t.reward_coins[card]);
+    }
+    for (int r = 0; r < kTradable; ++r) production[p][r][l] += t.produce[r][card];
+    add_coins(l, p, t.coin_gain[card]);
+    fixed_trade[p][l] |= t.fixed_mask[card];
+    wild_raw[p][l] += t.wild_raw[card];
+    wild_manufactured[p][l] += t.wild_manufactured[card];
+
+    color_count[p][t.color[card]][l]++;
+    LaneLists& lists_l = lists[l];
+    if (lists_l.built_count[p] < kMaxBuilt) lists_l.built[p][lists_l.built_count[p]++] = static_cast<uint8_t>(card);
+}
+
+void BatchPlayout::build_wonder(int l, int p, int w, int pos) {
+    const Tables& t = tables();
+    const int opp = 1 - p;
+    const int id = wonders[p][w][l];
+    LaneLists& lists_l = lists[l];
+
+    // 先付费用（由 compute_action_masks 按当前玩家算出），地基牌面朝下压在奇迹下，不进入弃牌堆
+    coins[p][l] -= wonder_cost[w][l];
+    lists_l.foundation[p][w] = slot_card[pos][l];
+    take_from_pyramid(l, pos);
+
+    vp[p][l] += t.wonder_vp[id];
+    if (t.wonder_shields[id] > 0) move_pawn(l, p, t.wonder_shields[id]);
+
+    add_coins(l, p, t.wonder_self_coins[id]);
+    add_coins(l, opp, t.wonder_opp_coins[id]);
+    wild_raw[p][l] += t.wonder_wild_raw[id];
+    wild_manufactured[p][l] += t.wonder_wild_manufactured[id];
+    const uint8_t flags = t.wonder_flags[id];
+    if (flags & reference::EXTRA_TURN) extra_turn[l] = 1;
+    if ((flags & reference::DESTROY_CARD) && color_count[opp][t.destroy_color[id]][l] > 0) {
+        open_decision(l, CHOOSE_CARD_TO_DESTROY);
+        pending_color[l] = t.destroy_color[id];
+    }
+    if ((flags & reference::BUILD_FROM_DISCARD) && lists_l.discard_count > 0) open_decision(l, CHOOSE_DISCARDED_CARD);
+    if (flags & reference::PICK_TOKEN) {
+        const int n = std::min<int>(t.token_offer[id], lists_l.pool_count);
+        if (n > 0) {
+            open_decision(l, CHOOSE_PROGRESS_TOKEN);
+            offered_count[l] = static_cast<uint8_t>(n);
+        }
+    }
+
+    wonder_built[p][l] |= 1u << w;
+    wonder_stages[p][l]++;
+}
+
+void BatchPlayout::move_pawn(int l, int p, int shields) {
+    const int amount = p == 0 ? shields : -shields;
+    pawn[l] = std::min(rules::kPawnMax, std::max(rules::kPawnMin, pawn[l] + amount));
+    for (int i = 0; i < 4; ++i) {
+        const rules::LootingToken& token = rules::kLootingTokens[i];
+        if (!((looting[l] >> i) & 1)) continue;
+        const bool reached = token.victim == 0 ? (amount < 0 && pawn[l] <= token.threshold)
+                                               : (amount > 0 && pawn[l] >= token.threshold);
+        if (!reached) continue;
+        add_coins(l, token.victim, -token.coins);
+        looting[l] &= ~(1 << i);
+    }
+    if (pawn[l] == rules::kPawnMin || pawn[l] == rules::kPawnMax) over[l] = 1;
+}
+
+void BatchPlayout::destroy_card(int l, int owner, int idx) {
+    const Tables& t = tables();
+    LaneLists& lists_l = lists[l];
+    const int card = lists_l.built[owner][idx];
+    for (int r = 0; r < kTradable; ++r) production[owner][r][l] = std::max(0, production[owner][r][l] - t.produce[r][card]);
+    if (color_count[owner][t.color[card]][l] > 0) color_count[owner][t.color[card]][l]--;
+    std::copy(lists_l.built[owner] + idx + 1, lists_l.built[owner] + lists_l.built_count[owner], lists_l.built[owner] + idx);
+    lists_l.built_count[owner]--;
+    lists_l.discard[lists_l.discard_count++] = static_cast<uint8_t>(card);
+}
+
+void BatchPlayout::open_decision(int l, uint8_t type) {
+    pending[l] = type;
+}
+
+void BatchPlayout::finish_turn(int l) {
+    const int me = current[l];
+    if (!over[l] && (pawn[l] <= rules::kPawnMin || pawn[l] >= rules::kPawnMax ||
+                     __builtin_popcount(science[me][l]) >= rules::kScienceSupremacy)) {
+        over[l] = 1;
+    }
+    if (!over[l]) {
+        if (extra_turn[l]) extra_turn[l] = 0;
+        else current[l] = 1 - me;
+        if (present[l] == 0) {
+            if (age[l] < rules::kAges) setup_age(l, age[l] + 1);
+            else over[l] = 1;
+        }
+    }
+    pending[l] = over[l] ? GAME_OVER : PICK_ACTION;
+}
+
+int BatchPlayout::get_winner(int l) const {
+    if (pawn[l] >= rules::kPawnMax) return 0;
+    if (pawn[l] <= rules::kPawnMin) return 1;
+    for (int p = 0; p < 2; ++p) {
+        if (__builtin_popcount(science[p][l]) >= rules::kScienceSupremacy) return p;
+    }
+    const int score0 = vp[0][l] + coins[0][l] / 3;
+    const int score1 = vp[1][l] + coins[1][l] / 3;
+    return score0 > score1 ? 0 : 1;
+}
+
+BatchPlayout::Stats BatchPlayout::play_games(uint64_t base_seed, int first, int stride, int end) {
+    Stats stats;
+    int next = first;
+    for (int l = 0; l < kLanes; ++l) {
+        if (next < end) { reset_lane(l, base_seed + next); next += stride; }
+        else clear_lane(l);
+    }
+    while (step() > 0) {
+        for (int l = 0; l < kLanes; ++l) {
+            if (!active[l] || !over[l]) continue;
+            stats.games++;
+            stats.moves += moves_played[l];
+            stats.wins[get_winner(l)]++;
+            if (next < end) { reset_lane(l, base_seed + next); next += stride; }
+            else clear_lane(l);
+        }
+    }
+    return stats;
+}
@@ -0,0 +1,153 @@
+#ifndef BATCH_PLAYOUT_H
+#define BATCH_PLAYOUT_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "core/Move.h"
+#include "core/Rules.h"
+
+struct GameSnapshot;
+
+/**
+ * BatchPlayout 类：以结构数组（SoA）存放 kLanes 局独立对局，按决策点同步推进的随机模拟器
+ *
+ * - 每个字段按 [字段][通道] 连续存放：金字塔位集、金币、产出、棋子位置等各占一组通道，
+ *   可拿取判定、建造费用/可负担判定与随机选择都是对全部通道的定长循环，
+ *   不含跨通道依赖，由编译器向量化（-DSWD_NATIVE_ARCH=ON 时使用本机最宽的向量指令）
+ * - 动作结算与少见的效果（奇迹、额外回合、进步标记、拆牌、弃牌堆建造）在各通道上标量执行
+ * - 规则与 Game 完全一致：卡牌/奇迹参数取自检入的固定表（ai/ReferenceTables.h，与目录的一致性由
+ *   swd_fuzz 启动时核对），首次使用时展开成平坦表；
+ *   同一种子发出的牌与 Game::init 相同，每一步合法动作集合与 Game::legal_moves 相同
+ *   （last_move() 记录的动作可以原样喂给 Game::apply_move 复现整局）
+ *
+ * 用于大批量随机走子：统计、基于模拟的机器人，以及与 Game 互相校验（tools/fuzz.cpp）。
+ */
+class BatchPlayout {
+public:
+    static constexpr int kLanes = 16;
+
+    explicit BatchPlayout(uint64_t rng_seed = 1);
+
+    // 在通道 lane 上按 game_seed 开新局（发牌与 Game::init(game_seed) 相同）
+    void reset_lane(int lane, uint64_t game_seed);
+    // 从快照继续（快照停在任意决策点均可）；快照无效时返回 false
+    bool load_lane(int lane, const GameSnapshot& snap);
+    void clear_lane(int lane) { active[lane] = 0; }
+
+    // 全部活动通道各推进一个决策点，返回本步推进的通道数
+    int step();
+
+    // 通道 lane 当前决策点的合法动作，顺序即随机走子时的动作编号（集合与 Game::legal_moves 相同）
+    void legal_moves(int lane, std::vector<Move>& out);
+    // 在通道 lane 上走出指定动作（复现与缩减反例用，逐步计算，不求快）；不合法时返回 false
+    bool apply_move(int lane, const Move& move);
+    // 与 Game 的快照逐项比较本模型表示的全部状态；不一致时在 diff 中写出第一处差异
+    bool matches(int lane, const GameSnapshot& snap, std::string* diff = nullptr) const;
+
+    bool is_active(int lane) const { return active[lane] != 0; }
+    bool is_over(int lane) const { return over[lane] != 0; }
+    int get_winner(int lane) const;
+    int get_moves(int lane) const { return moves_played[lane]; }
+    const Move& last_move(int lane) const { return last[lane]; }
+    // 上一次 step() 时通道 lane 可选的动作数（last_move 即从中随机选出）
+    int get_choices(int lane) const { return static_cast<int>(choices[lane]); }
+    int get_coins(int lane, int player) const { return coins[player][lane]; }
+    int get_victory_points(int lane, int player) const { return vp[player][lane]; }
+    int get_pawn(int lane) const { return pawn[lane]; }
+    int get_age(int lane) const { return age[lane]; }
+
+    struct Stats {
+        long long games = 0;
+        long long moves = 0;
+        int wins[2] = {0, 0};
+    };
+    // 连续对局：第 first, first + stride, ... (< end) 局，种子为 base_seed + 局号；
+    // 某通道局终后立即换上下一局，直到全部完成
+    Stats play_games(uint64_t base_seed, int first, int stride, int end);
+
+private:
+    static constexpr int kMaxDiscard = 80;
+    static constexpr int kMaxBuilt = 64;
+
+    // 待决策类型（与 Decision::Type 取值一致）
+    enum : uint8_t { PICK_ACTION, CHOOSE_WONDER, CHOOSE_PROGRESS_TOKEN, CHOOSE_DISCARDED_CARD,
+                     CHOOSE_CARD_TO_DESTROY, GAME_OVER };
+
+    // --- 向量部分：可拿取 / 可建造位集与动作总数 ---
+    void compute_action_masks();
+    uint32_t next_random(int lane);
+    // 当前决策点的动作数（PICK_ACTION 时取 compute_action_masks 的结果）
+    uint32_t decision_count(int lane) const;
+
+    // --- 标量部分：逐通道结算 ---
+    void apply_action(int lane, uint32_t r);
+    void apply_sub_decision(int lane, uint32_t r);
+    void build_card(int lane, int player, int card);
+    void build_wonder(int lane, int player, int wonder_idx, int pos);
+    void take_from_pyramid(int lane, int pos);
+    void move_pawn(int lane, int player, int shields);
+    void add_coins(int lane, int player, int amount);
+    void destroy_card(int lane, int player, int idx);
+    void finish_turn(int lane);
+    void setup_age(int lane, int next_age);
+    void open_decision(int lane, uint8_t type);
+
+    // ===== 结构数组：[字段][通道] =====
+    alignas(64) uint8_t active[kLanes];
+    alignas(64) uint8_t over[kLanes];
+    alignas(64) int32_t age[kLanes];
+    alignas(64) int32_t current[kLanes];         // 轮到的座位号
+    alignas(64) uint8_t extra_turn[kLanes];
+    alignas(64) uint8_t pending[kLanes];         // 待决策类型
+    alignas(64) int8_t pending_pos[kLanes];      // CHOOSE_WONDER 的地基位置
+    alignas(64) int8_t pending_color[kLanes];    // CHOOSE_CARD_TO_DESTROY 的颜色
+    alignas(64) uint8_t offered_count[kLanes];   // CHOOSE_PROGRESS_TOKEN 可选数量（取盒中前几个）
+    alignas(64) int32_t pawn[kLanes];
+    alignas(64) int32_t looting[kLanes];         // 尚未触发的掠夺标记位集
+
+    alignas(64) uint32_t present[kLanes];        // 金字塔中仍在的槽位
+    alignas(64) uint8_t slot_card[rules::kPyramidSlots][kLanes];
+
+    alignas(64) int32_t coins[2][kLanes];
+    alignas(64) int32_t vp[2][kLanes];
+    alignas(64) int32_t production[2][5][kLanes];   // WOOD..PAPYRUS
+    alignas(64) int32_t wild_raw[2][kLanes];        // 木/泥/石 多选一个数
+    alignas(64) int32_t wild_manufactured[2][kLanes]; // 玻璃/纸草 多选一个数
+    alignas(64) int32_t fixed_trade[2][kLanes];     // 交易价固定为 1 的资源位集
+    alignas(64) int32_t color_count[2][7][kLanes];
+    alignas(64) uint32_t links[2][kLanes];          // 按 LinkSymbol 取位
+    alignas(64) uint32_t science[2][kLanes];        // 按 Resource 取位
+    alignas(64) uint32_t tokens[2][kLanes];         // 按 ProgressToken 取位
+    alignas(64) int32_t wonder_stages[2][kLanes];
+    alignas(64) uint32_t wonder_built[2][kLanes];   // 第 i 位 = 第 i 个奇迹已建
+    alignas(64) uint8_t wonders[2][4][kLanes];      // 奇迹目录下标
+
+    alignas(64) uint32_t rng[kLanes];               // 每通道 xorshift32 状态
+    alignas(64) int32_t moves_played[kLanes];
+
+    // 每步的向量计算结果
+    alignas(64) uint32_t accessible[kLanes];
+    alignas(64) uint32_t buildable[kLanes];
+    alignas(64) int32_t build_cost[rules::kPyramidSlots][kLanes];
+    alignas(64) uint32_t wonder_ok[kLanes];         // 当前玩家可建的奇迹位集（未建、未满 7 座、付得起）
+    alignas(64) int32_t wonder_cost[4][kLanes];
+    alignas(64) uint32_t action_count[kLanes];
+    alignas(64) uint32_t choices[kLanes];
+
+    // ===== 少见数据：按通道存放 =====
+    struct LaneLists {
+        uint8_t decks[rules::kAges][rules::kPyramidSlots];  // 各时代牌序（由种子决定）
+        uint8_t discard[kMaxDiscard];
+        uint8_t discard_count;
+        uint8_t built[2][kMaxBuilt];
+        uint8_t built_count[2];
+        uint8_t foundation[2][4];                           // 各奇迹的地基牌（未建为 kEmpty）
+        uint8_t pool[10];                                   // 盒中进步标记（有序）
+        uint8_t pool_count;
+    };
+    LaneLists lists[kLanes];
+    Move last[kLanes];
+};
+
+#endif
@@ -0,0 +1,41 @@
+#include "Determinize.h"
+#include "cards/Card.h"
+#include <algorithm>
+
+namespace {
+
+constexpr int kMaxAgeCards = 64;   // 单个时代的牌数上限（候选缓冲）
+
+} // namespace
+
+void determinize(GameSnapshot& snap, std::mt19937_64& rng) {
+    bool seen[256] = {};   // 按卡牌目录下标
+    auto mark = [&](uint8_t id) { seen[id] = true; };
+    for (int p = 0; p < GameSnapshot::kSlots; ++p) {
+        if ((snap.face_up_mask >> p) & 1u) mark(snap.slots[p]);
+    }
+    for (int i = 0; i < snap.discard_count; ++i) mark(snap.discard[i]);
+    for (const auto& player : snap.players) {
+        for (int i = 0; i < player.built_card_count; ++i) mark(player.built_cards[i]);
+        // 地基取走时正面朝上，双方都见过
+        for (int i = 0; i < player.wonder_count && i < GameSnapshot::kMaxWonders; ++i) {
+            if (player.wonder_foundation[i] != GameSnapshot::kEmpty) mark(player.wonder_foundation[i]);
+        }
+    }
+
+    uint8_t unseen[kMaxAgeCards];
+    int unseen_count = 0;
+    for (const auto& card : card_catalog()) {
+        if (card->age == snap.structure_age && !seen[card->id] && unseen_count < kMaxAgeCards) {
+            unseen[unseen_count++] = static_cast<uint8_t>(card->id);
+        }
+    }
+    std::shuffle(unseen, unseen + unseen_count, rng);
+    int next = 0;
+    for (int p = 0; p < GameSnapshot::kSlots && next < unseen_count; ++p) {
+        if (snap.slots[p] != GameSnapshot::kEmpty && !((snap.face_up_mask >> p) & 1u)) snap.slots[p] = unseen[next++];
+    }
+
+    snap.seed = rng();
+    std::shuffle(snap.pool_tokens, snap.pool_tokens + snap.pool_token_count, rng);
+}
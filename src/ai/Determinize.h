@@ -0,0 +1,18 @@
+#ifndef DETERMINIZE_H
+#define DETERMINIZE_H
+
+#include <random>
+#include "core/Snapshot.h"
+
+/**
+ * 确定化：把快照中行动方看不到的信息换成一次随机采样（搜索每次迭代/模拟各取一份）
+ *
+ * - 背面朝上的牌：从本时代尚未露面的牌（不在正面槽位、已建卡牌、奇迹地基与弃牌堆中）里重新抽取
+ * - 之后各时代的牌序由发牌种子决定：换成随机种子
+ * - 盒中的进步标记：打乱顺序
+ *
+ * 合法动作只取决于可见信息，因此根节点的动作集合在各次采样间不变。
+ */
+void determinize(GameSnapshot& snap, std::mt19937_64& rng);
+
+#endif
@@ -0,0 +1,37 @@
+#include "GreedyBot.h"
+#include "core/Game.h"
+
+namespace {
+
+constexpr float kDecisive = 1e6f;   // 直接决出胜负的动作
+
+} // namespace
+
+GreedyBot::GreedyBot(const EvalWeights& weights)
+    : sim(std::make_unique<Game>()), eval(std::make_unique<HeuristicEval>(*sim, weights)) {}
+
+GreedyBot::~GreedyBot() = default;
+GreedyBot::GreedyBot(GreedyBot&&) noexcept = default;
+
+Move GreedyBot::choose(const Game& game, const std::vector<Move>& legal) {
+    const int mover = game.get_decision().player;
+    game.save_snapshot(root);
+
+    Move best = legal.front();
+    float best_score = 0.0f;
+    bool first = true;
+    for (const Move& move : legal) {
+        sim->load_snapshot(root);
+        eval->refresh();
+        sim->apply_move(move);
+        float score;
+        if (sim->is_over()) score = sim->get_winner() == mover ? kDecisive : -kDecisive;
+        else score = eval->evaluate(mover);
+        if (first || score > best_score) {
+            best = move;
+            best_score = score;
+            first = false;
+        }
+    }
+    return best;
+}
@@ -0,0 +1,37 @@
+#ifndef GREEDY_BOT_H
+#define GREEDY_BOT_H
+
+#include <memory>
+#include <vector>
+#include "ai/HeuristicEval.h"
+#include "core/Move.h"
+#include "core/Snapshot.h"
+
+class Game;
+
+/**
+ * GreedyBot 类：一步贪心机器人
+ *
+ * 对每个合法动作在模拟对局上走一步，用 HeuristicEval 从行动方视角打分，取最高者；
+ * 直接结束对局的动作按胜负给极值。全部行为由 EvalWeights 决定（各色卡牌价值、金币、
+ * 军事与科技的紧迫度等），是 swd_spsa 自动调参的对象。
+ *
+ * 满足 Playout 的策略约定（choose(game, legal)），可移动，可直接用于批量对局。
+ */
+class GreedyBot {
+public:
+    explicit GreedyBot(const EvalWeights& weights);
+    ~GreedyBot();
+    GreedyBot(GreedyBot&&) noexcept;
+
+    Move choose(const Game& game, const std::vector<Move>& legal);
+
+    void set_weights(const EvalWeights& weights) { eval->set_weights(weights); }
+
+private:
+    GameSnapshot root;
+    std::unique_ptr<Game> sim;
+    std::unique_ptr<HeuristicEval> eval;   // 订阅 sim 的事件
+};
+
+#endif
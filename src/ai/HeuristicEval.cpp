@@ -0,0 +1,208 @@
+#include "HeuristicEval.h"
+#include "core/Board.h"
+#include "core/Game.h"
+#include "core/Rules.h"
+#include "player/Player.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+
+namespace {
+
+struct WeightField {
+    const char* name;
+    float EvalWeights::*member;
+};
+
+const WeightField kFields[] = {
+    {"victory_points", &EvalWeights::victory_points},
+    {"coins", &EvalWeights::coins},
+    {"military_step", &EvalWeights::military_step},
+    {"military_danger", &EvalWeights::military_danger},
+    {"science_symbol", &EvalWeights::science_symbol},
+    {"science_near", &EvalWeights::science_near},
+    {"wonder_potential", &EvalWeights::wonder_potential},
+    {"trade_advantage", &EvalWeights::trade_advantage},
+    {"production", &EvalWeights::production},
+    {"logistic_scale", &EvalWeights::logistic_scale},
+    {"card_brown", &EvalWeights::card_brown},
+    {"card_grey", &EvalWeights::card_grey},
+    {"card_blue", &EvalWeights::card_blue},
+    {"card_yellow", &EvalWeights::card_yellow},
+    {"card_red", &EvalWeights::card_red},
+    {"card_green", &EvalWeights::card_green},
+    {"card_purple", &EvalWeights::card_purple},
+    {"pyramid_control", &EvalWeights::pyramid_control},
+};
+
+std::string trim(const std::string& s) {
+    const auto begin = s.find_first_not_of(" \t\r");
+    if (begin == std::string::npos) return "";
+    const auto end = s.find_last_not_of(" \t\r");
+    return s.substr(begin, end - begin + 1);
+}
+
+} // namespace
+
+// ===== EvalWeights =====
+
+bool EvalWeights::load(const std::string& path, std::string* error) {
+    std::ifstream in(path);
+    if (!in) {
+        if (error) *error = "cannot open " + path;
+        return false;
+    }
+    EvalWeights loaded = *this;
+    std::string line;
+    int line_no = 0;
+    while (std::getline(in, line)) {
+        ++line_no;
+        line = trim(line.substr(0, line.find('#')));
+        if (line.empty()) continue;
+        const auto eq = line.find('=');
+        const std::string key = trim(line.substr(0, eq));
+        const std::string value = eq == std::string::npos ? "" : trim(line.substr(eq + 1));
+        char* end = nullptr;
+        const float v = std::strtof(value.c_str(), &end);
+        const int index = find_field(key);
+        if (eq == std::string::npos || value.empty() || *end != '\0' || index < 0) {
+            if (error) *error = path + ":" + std::to_string(line_no) + ": bad weight line '" + line + "'";
+            return false;
+        }
+        loaded.field(index) = v;
+    }
+    *this = loaded;
+    return true;
+}
+
+int EvalWeights::field_count() {
+    return static_cast<int>(std::size(kFields));
+}
+
+const char* EvalWeights::field_name(int i) {
+    return kFields[i].name;
+}
+
+int EvalWeights::find_field(const std::string& name) {
+    for (int i = 0; i < field_count(); ++i) {
+        if (name == kFields[i].name) return i;
+    }
+    return -1;
+}
+
+float& EvalWeights::field(int i) {
+    return this->*(kFields[i].member);
+}
+
+float EvalWeights::field(int i) const {
+    return this->*(kFields[i].member);
+}
+
+bool EvalWeights::save(const std::string& path) const {
+    std::ofstream out(path);
+    if (!out) return false;
+    char buf[64];
+    for (const WeightField& f : kFields) {
+        std::snprintf(buf, sizeof(buf), "%.9g", this->*(f.member));
+        out << f.name << " = " << buf << "\n";
+    }
+    return static_cast<bool>(out);
+}
+
+// ===== HeuristicEval =====
+
+HeuristicEval::HeuristicEval(Game& g, const EvalWeights& w) : game(g), weights(w) {
+    observer.eval = this;
+    game.events().subscribe(observer);
+}
+
+HeuristicEval::~HeuristicEval() {
+    game.events().unsubscribe(&observer);
+}
+
+void HeuristicEval::refresh() {
+    for (int p = 0; p < 2; ++p) {
+        const Player& player = game.get_player(p);
+        Side& side = sides[p];
+        side.coins = player.get_coins();
+        side.victory_points = player.get_victory_points();
+        side.science = player.get_unique_science_count();
+        for (int c = 0; c < 7; ++c) side.colors[c] = player.get_card_count_by_color(static_cast<Color>(c));
+        side.unbuilt_wonders = 0;
+        for (int w = 0; w < player.get_wonder_count(); ++w) {
+            if (!player.get_wonder(w).is_built) side.unbuilt_wonders++;
+        }
+        side.economy_dirty = true;
+    }
+    pawn = game.get_board()->get_pawn_position();
+}
+
+void HeuristicEval::refresh_economy(int p) {
+    const Player& player = game.get_player(p);
+    Side& side = sides[p];
+    side.production = static_cast<int>(player.get_wildcard_resources().size());
+    side.fixed_price_mask = 0;
+    for (int r = 0; r < 5; ++r) {
+        side.production += player.get_resource(static_cast<Resource>(r));
+        if (player.get_trade_cost(static_cast<Resource>(r)) == 1) side.fixed_price_mask |= 1 << r;
+    }
+    side.economy_dirty = false;
+}
+
+// 与 CostCalculator::calculate_trade_cost 相同：固定价 1，否则 2 + 对方同类（棕/灰）卡牌数
+int HeuristicEval::purchase_price_sum(int buyer) const {
+    const Side& me = sides[buyer];
+    const Side& seller = sides[1 - buyer];
+    int sum = 0;
+    for (int r = 0; r < 5; ++r) {
+        const int market = 2 + seller.colors[r < 3 ? (int)Color::BROWN : (int)Color::GREY];
+        sum += ((me.fixed_price_mask >> r) & 1) ? 1 : market;
+    }
+    return sum;
+}
+
+float HeuristicEval::evaluate(int player) {
+#ifdef SWD_DISABLE_EVENTS
+    refresh();
+#endif
+    for (int p = 0; p < 2; ++p) {
+        if (sides[p].economy_dirty) refresh_economy(p);
+    }
+    const Side& me = sides[player];
+    const Side& opp = sides[1 - player];
+    const EvalWeights& w = weights;
+
+    // 棋子：P1 向 18 推进为正
+    const int offset = (player == 0 ? 1 : -1) * (pawn - rules::kPawnStart);
+    const int danger = std::max(0, std::abs(offset) - EvalWeights::kDangerZone) * (offset > 0 ? 1 : -1);
+
+    const int near_me = me.science >= rules::kScienceSupremacy - 1 ? 1 : 0;
+    const int near_opp = opp.science >= rules::kScienceSupremacy - 1 ? 1 : 0;
+
+    float score = 0.0f;
+    score += w.victory_points * (me.victory_points - opp.victory_points);
+    score += w.coins * (me.coins - opp.coins);
+    score += w.military_step * offset + w.military_danger * danger;
+    score += w.science_symbol * (me.science - opp.science) + w.science_near * (near_me - near_opp);
+    score += w.wonder_potential * (me.unbuilt_wonders - opp.unbuilt_wonders);
+    score += w.trade_advantage * (purchase_price_sum(1 - player) - purchase_price_sum(player));
+    score += w.production * (me.production - opp.production);
+    const float card_weights[7] = {w.card_brown, w.card_grey, w.card_blue, w.card_yellow,
+                                   w.card_red, w.card_green, w.card_purple};
+    for (int c = 0; c < 7; ++c) score += card_weights[c] * (me.colors[c] - opp.colors[c]);
+    if (w.pyramid_control != 0.0f && !game.is_over()) {
+        const int age = game.get_current_age();
+        if (!tempo[age - 1]) tempo[age - 1] = std::make_unique<PyramidTempo>(age);
+        const PyramidTempo::Report r = tempo[age - 1]->analyze(game);
+        const int control = __builtin_popcount(r.mover_forces) - __builtin_popcount(r.other_forces);
+        score += w.pyramid_control * (r.mover == player ? control : -control);
+    }
+    return score;
+}
+
+float HeuristicEval::win_probability(int player) {
+    return 1.0f / (1.0f + std::exp(-evaluate(player) / weights.logistic_scale));
+}
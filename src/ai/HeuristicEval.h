@@ -0,0 +1,120 @@
+#ifndef HEURISTIC_EVAL_H
+#define HEURISTIC_EVAL_H
+
+#include <memory>
+#include <string>
+#include "cards/PyramidTempo.h"
+#include "core/GameEvents.h"
+
+class Game;
+
+/**
+ * EvalWeights：静态评估各项的权重（单位：胜利分）
+ *
+ * 配置文件为逐行 `名称 = 数值`，# 起为注释；未出现的项保持默认值，未知名称视为错误。
+ * 调参工具可以直接改写文件，无需重新编译。
+ */
+struct EvalWeights {
+    float victory_points = 1.0f;       // 每点胜利分差
+    float coins = 0.33f;               // 每枚金币差（终局 3 金币折 1 分）
+    float military_step = 0.6f;        // 棋子每向对方首都推进一格
+    float military_danger = 2.0f;      // 棋子越过 kDangerZone 后每多一格（接近军事压制）
+    float science_symbol = 1.5f;       // 每个不同科技符号
+    float science_near = 6.0f;         // 差一个符号即科技压制
+    float wonder_potential = 1.0f;     // 每个尚未建造的奇迹
+    float trade_advantage = 0.3f;      // 五种资源上对方买价之和减我方买价之和，每枚金币
+    float production = 0.5f;           // 每单位产出（含多选一资源）
+    float logistic_scale = 4.0f;       // 搜索把分差 d 折算为胜率 1 / (1 + e^(-d / scale))
+    // 每张已建卡牌按颜色的额外价值（默认 0：上面各项已计入卡牌的直接收益）
+    float card_brown = 0.0f;
+    float card_grey = 0.0f;
+    float card_blue = 0.0f;
+    float card_yellow = 0.0f;
+    float card_red = 0.0f;
+    float card_green = 0.0f;
+    float card_purple = 0.0f;
+    // 金字塔中我方能保证拿到的剩余槽位数减对方的（见 cards/PyramidTempo.h；默认 0 不计算）
+    float pyramid_control = 0.0f;
+
+    static constexpr int kDangerZone = 5;
+
+    bool load(const std::string& path, std::string* error = nullptr);
+    bool save(const std::string& path) const;
+
+    // 按名称表逐项访问（与配置文件中的顺序一致），供调参工具把权重当作向量处理
+    static int field_count();
+    static const char* field_name(int i);
+    static int find_field(const std::string& name);   // 未知名称返回 -1
+    float& field(int i);
+    float field(int i) const;
+};
+
+/**
+ * HeuristicEval 类：按事件增量维护的局面静态评估
+ *
+ * 订阅对局的事件总线，按事件携带的数值更新各项：金币（CoinsChanged）、胜利分（VictoryPointsChanged）、
+ * 科技符号（ScienceSymbolGained）、各色卡牌数（CardBuilt / CardDestroyed）、棋子（PawnMoved）、
+ * 已建奇迹（WonderBuilt）；产出与交易价只在 EconomyChanged 时重读该玩家。
+ * 构造时只订阅事件，对局 init / load_snapshot 之后需调用一次 refresh()（搜索中每次载入快照后都要），
+ * 之后沿路径的每步只做增量更新，
+ * evaluate() 只是对缓存的数值做一次加权求和。
+ *
+ * 以 SWD_NO_EVENTS=ON 编译时事件不再发布，evaluate() 退化为每次先 refresh()。
+ */
+class HeuristicEval {
+public:
+    HeuristicEval(Game& game, const EvalWeights& weights);
+    ~HeuristicEval();
+    HeuristicEval(const HeuristicEval&) = delete;
+    HeuristicEval& operator=(const HeuristicEval&) = delete;
+
+    // 从对局全量重建缓存（对局 init / load_snapshot 之后调用）
+    void refresh();
+    // player 视角的评估值（单位：胜利分），正值对 player 有利
+    float evaluate(int player);
+    // 按 logistic_scale 折算的 player 胜率（0~1）
+    float win_probability(int player);
+
+    const EvalWeights& get_weights() const { return weights; }
+    void set_weights(const EvalWeights& w) { weights = w; }
+
+    struct Observer {
+        static constexpr bool kEnabled = true;
+        static constexpr bool kPollsWithoutEvents = true;   // 事件关闭时 evaluate() 先 refresh()
+        HeuristicEval* eval = nullptr;
+
+        template <class E> void on(const E&) {}
+        void on(const CoinsChanged& e) { eval->sides[e.player].coins = e.total; }
+        void on(const VictoryPointsChanged& e) { eval->sides[e.player].victory_points = e.total; }
+        void on(const ScienceSymbolGained& e) { eval->sides[e.player].science = e.unique_count; }
+        void on(const PawnMoved& e) { eval->pawn = e.to; }
+        void on(const CardBuilt& e) { eval->sides[e.player].colors[(int)e.color]++; }
+        void on(const CardDestroyed& e) { eval->sides[e.player].colors[(int)e.color]--; eval->sides[e.player].economy_dirty = true; }
+        void on(const WonderBuilt& e) { eval->sides[e.player].unbuilt_wonders--; }
+        void on(const EconomyChanged& e) { eval->sides[e.player].economy_dirty = true; }
+    };
+
+private:
+    struct Side {
+        int coins = 0;
+        int victory_points = 0;
+        int science = 0;
+        int colors[7] = {};
+        int unbuilt_wonders = 0;
+        int production = 0;         // 五种资源产出 + 多选一资源个数
+        int fixed_price_mask = 0;   // 交易价固定为 1 的资源
+        bool economy_dirty = true;
+    };
+
+    void refresh_economy(int player);
+    int purchase_price_sum(int buyer) const;
+
+    Game& game;
+    EvalWeights weights;
+    Observer observer;
+    Side sides[2];
+    int pawn = 9;
+    std::unique_ptr<PyramidTempo> tempo[rules::kAges];   // pyramid_control 非 0 时按时代建立
+};
+
+#endif
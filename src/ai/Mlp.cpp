@@ -0,0 +1,223 @@
+#include "Mlp.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <random>
+
+namespace {
+
+constexpr int kRowBlock = 4;   // 每次同时累加的输入行数
+constexpr uint32_t kMaxLayers = 16;   // 载入时的层数上限：层数与各层宽度都来自文件，分配前先核对
+
+// 文件总字节数；失败时返回 -1。读位置保持在文件开头
+long file_size(std::FILE* f) {
+    if (std::fseek(f, 0, SEEK_END) != 0) return -1;
+    const long size = std::ftell(f);
+    if (std::fseek(f, 0, SEEK_SET) != 0) return -1;
+    return size;
+}
+
+struct FileCloser {
+    void operator()(std::FILE* f) const { if (f) std::fclose(f); }
+};
+using FilePtr = std::unique_ptr<std::FILE, FileCloser>;
+
+template <typename T>
+bool read_array(std::FILE* f, std::vector<T>& out, std::size_t n) {
+    out.resize(n);
+    return std::fread(out.data(), sizeof(T), n, f) == n;
+}
+
+// 对 Rows 行输入累加 acc[r][o] += x[r][i] * w[i][o]；W 为 float 或 int8
+template <int Rows, typename W>
+void accumulate_rows(const W* __restrict w, int in, int out, const float* __restrict x, float* __restrict acc) {
+    for (int i = 0; i < in; ++i) {
+        float xs[Rows];
+        bool any = false;
+        for (int r = 0; r < Rows; ++r) {
+            xs[r] = x[r * in + i];
+            any |= xs[r] != 0.0f;
+        }
+        if (!any) continue;
+        const W* __restrict wi = w + static_cast<std::size_t>(i) * out;
+        for (int o = 0; o < out; ++o) {
+            const float wv = static_cast<float>(wi[o]);
+            for (int r = 0; r < Rows; ++r) acc[r * out + o] += xs[r] * wv;
+        }
+    }
+}
+
+template <typename W>
+void accumulate(const W* w, int in, int out, const float* x, int rows, float* acc) {
+    switch (rows) {
+        case 1: accumulate_rows<1>(w, in, out, x, acc); break;
+        case 2: accumulate_rows<2>(w, in, out, x, acc); break;
+        case 3: accumulate_rows<3>(w, in, out, x, acc); break;
+        default: accumulate_rows<kRowBlock>(w, in, out, x, acc); break;
+    }
+}
+
+} // namespace
+
+bool MlpNetwork::load(const std::string& path, std::string* error) {
+    auto fail = [&](const std::string& why) {
+        if (error) *error = path + ": " + why;
+        return false;
+    };
+    FilePtr f(std::fopen(path.c_str(), "rb"));
+    if (!f) return fail("cannot open");
+    const long size = file_size(f.get());
+    if (size < 0) return fail("cannot determine file size");
+
+    char magic[4];
+    uint32_t header[2];
+    if (std::fread(magic, 1, 4, f.get()) != 4 || std::memcmp(magic, "SWDN", 4) != 0) return fail("bad magic");
+    if (std::fread(header, sizeof(uint32_t), 2, f.get()) != 2) return fail("truncated header");
+    if (header[0] != kVersion) return fail("unsupported version");
+    if (header[1] > kMaxLayers) return fail("too many layers");
+
+    std::vector<Layer> loaded(header[1]);
+    for (uint32_t l = 0; l < header[1]; ++l) {
+        uint32_t shape[3];
+        if (std::fread(shape, sizeof(uint32_t), 3, f.get()) != 3) return fail("truncated layer header");
+        Layer& layer = loaded[l];
+        layer.in = static_cast<int>(shape[0]);
+        layer.out = static_cast<int>(shape[1]);
+        layer.quantized = shape[2] == 1;
+        if (shape[2] > 1 || layer.in <= 0 || layer.out <= 0 || layer.in > (1 << 16) || layer.out > (1 << 16)) {
+            return fail("bad layer shape");
+        }
+        if (l > 0 && loaded[l - 1].out != layer.in) return fail("layer widths do not chain");
+
+        const std::size_t n = static_cast<std::size_t>(layer.in) * layer.out;
+        // 本层权重、缩放与偏置必须都在文件剩余部分之内，否则不分配
+        const std::size_t payload = (layer.quantized ? n + 2 * sizeof(float) * layer.out : (n + layer.out) * sizeof(float));
+        const long pos = std::ftell(f.get());
+        if (pos < 0 || payload > static_cast<std::size_t>(size - pos)) return fail("truncated weights");
+        if (layer.quantized) {
+            std::vector<int8_t> w;
+            if (!read_array(f.get(), layer.scale, layer.out) || !read_array(f.get(), w, n)) return fail("truncated weights");
+            layer.weight_q.resize(n);
+            for (int o = 0; o < layer.out; ++o)
+                for (int i = 0; i < layer.in; ++i) layer.weight_q[static_cast<std::size_t>(i) * layer.out + o] = w[static_cast<std::size_t>(o) * layer.in + i];
+        } else {
+            std::vector<float> w;
+            if (!read_array(f.get(), w, n)) return fail("truncated weights");
+            layer.scale.assign(layer.out, 1.0f);
+            layer.weight_t.resize(n);
+            for (int o = 0; o < layer.out; ++o)
+                for (int i = 0; i < layer.in; ++i) layer.weight_t[static_cast<std::size_t>(i) * layer.out + o] = w[static_cast<std::size_t>(o) * layer.in + i];
+        }
+        if (!read_array(f.get(), layer.bias, layer.out)) return fail("truncated bias");
+    }
+    if (loaded.empty()) return fail("no layers");
+    layers = std::move(loaded);
+    return true;
+}
+
+bool MlpNetwork::save(const std::string& path) const {
+    FilePtr f(std::fopen(path.c_str(), "wb"));
+    if (!f) return false;
+    const uint32_t header[2] = {kVersion, static_cast<uint32_t>(layers.size())};
+    bool ok = std::fwrite("SWDN", 1, 4, f.get()) == 4 && std::fwrite(header, sizeof(uint32_t), 2, f.get()) == 2;
+    for (const Layer& layer : layers) {
+        const uint32_t shape[3] = {static_cast<uint32_t>(layer.in), static_cast<uint32_t>(layer.out), layer.quantized ? 1u : 0u};
+        ok = ok && std::fwrite(shape, sizeof(uint32_t), 3, f.get()) == 3;
+        const std::size_t n = static_cast<std::size_t>(layer.in) * layer.out;
+        if (layer.quantized) {
+            std::vector<int8_t> w(n);
+            for (int o = 0; o < layer.out; ++o)
+                for (int i = 0; i < layer.in; ++i) w[static_cast<std::size_t>(o) * layer.in + i] = layer.weight_q[static_cast<std::size_t>(i) * layer.out + o];
+            ok = ok && std::fwrite(layer.scale.data(), sizeof(float), layer.out, f.get()) == (std::size_t)layer.out;
+            ok = ok && std::fwrite(w.data(), 1, n, f.get()) == n;
+        } else {
+            std::vector<float> w(n);
+            for (int o = 0; o < layer.out; ++o)
+                for (int i = 0; i < layer.in; ++i) w[static_cast<std::size_t>(o) * layer.in + i] = layer.weight_t[static_cast<std::size_t>(i) * layer.out + o];
+            ok = ok && std::fwrite(w.data(), sizeof(float), n, f.get()) == n;
+        }
+        ok = ok && std::fwrite(layer.bias.data(), sizeof(float), layer.out, f.get()) == (std::size_t)layer.out;
+    }
+    return ok;
+}
+
+MlpNetwork MlpNetwork::random(const std::vector<int>& widths, uint64_t seed, bool quantized) {
+    MlpNetwork net;
+    std::mt19937_64 rng(seed);
+    for (std::size_t l = 0; l + 1 < widths.size(); ++l) {
+        Layer layer;
+        layer.in = widths[l];
+        layer.out = widths[l + 1];
+        layer.quantized = quantized;
+        const std::size_t n = static_cast<std::size_t>(layer.in) * layer.out;
+        const float bound = std::sqrt(6.0f / static_cast<float>(layer.in));   // He 均匀初始化
+        std::uniform_real_distribution<float> dist(-bound, bound);
+        layer.bias.assign(layer.out, 0.0f);
+        if (quantized) {
+            layer.scale.assign(layer.out, bound / 127.0f);
+            layer.weight_q.resize(n);
+            for (auto& w : layer.weight_q) w = static_cast<int8_t>(std::lround(dist(rng) / layer.scale[0]));
+        } else {
+            layer.scale.assign(layer.out, 1.0f);
+            layer.weight_t.resize(n);
+            for (auto& w : layer.weight_t) w = dist(rng);
+        }
+        net.layers.push_back(std::move(layer));
+    }
+    return net;
+}
+
+int MlpNetwork::max_width() const {
+    int w = 0;
+    for (const Layer& layer : layers) w = std::max({w, layer.in, layer.out});
+    return w;
+}
+
+void MlpNetwork::dense(const Layer& layer, const float* x, int batch, float* y, bool relu, bool sparse_input) {
+    alignas(64) float acc_storage[kRowBlock * 1024];
+    std::vector<float> acc_heap;
+    float* acc = acc_storage;
+    if (layer.out > 1024) {
+        acc_heap.resize(static_cast<std::size_t>(kRowBlock) * layer.out);
+        acc = acc_heap.data();
+    }
+
+    // 稀疏输入逐行处理：多行合并时要走各行非零分量的并集，反而多做乘加
+    const int block = sparse_input ? 1 : kRowBlock;
+    for (int b0 = 0; b0 < batch; b0 += block) {
+        const int rows = std::min(block, batch - b0);
+        std::fill(acc, acc + static_cast<std::size_t>(rows) * layer.out, 0.0f);
+        const float* xb = x + static_cast<std::size_t>(b0) * layer.in;
+        if (layer.quantized) accumulate(layer.weight_q.data(), layer.in, layer.out, xb, rows, acc);
+        else accumulate(layer.weight_t.data(), layer.in, layer.out, xb, rows, acc);
+
+        for (int r = 0; r < rows; ++r) {
+            const float* a = acc + static_cast<std::size_t>(r) * layer.out;
+            float* yr = y + static_cast<std::size_t>(b0 + r) * layer.out;
+            for (int o = 0; o < layer.out; ++o) {
+                const float v = a[o] * layer.scale[o] + layer.bias[o];
+                yr[o] = relu ? std::max(v, 0.0f) : v;
+            }
+        }
+    }
+}
+
+void MlpNetwork::forward(const float* input, int batch, float* output, std::vector<float>& scratch) const {
+    if (layers.size() == 1) {
+        dense(layers[0], input, batch, output, false, true);
+        return;
+    }
+    const std::size_t stride = static_cast<std::size_t>(max_width()) * batch;
+    if (scratch.size() < 2 * stride) scratch.resize(2 * stride);
+    float* buffers[2] = {scratch.data(), scratch.data() + stride};
+
+    const float* x = input;
+    for (std::size_t l = 0; l < layers.size(); ++l) {
+        const bool last = l + 1 == layers.size();
+        float* y = last ? output : buffers[l & 1];
+        dense(layers[l], x, batch, y, !last, l == 0);
+        x = y;
+    }
+}
@@ -0,0 +1,57 @@
+#ifndef MLP_H
+#define MLP_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * MlpNetwork 类：CPU 上的小型全连接网络（前向推理），权重为 float 或按输出通道量化的 int8
+ *
+ * 文件格式（小端）：
+ *   char magic[4] = "SWDN"; uint32 version = 1; uint32 layer_count;
+ *   每层：uint32 in, uint32 out, uint32 dtype（0 = float32，1 = int8）；
+ *         dtype 0：float weight[out][in]
+ *         dtype 1：float scale[out]，int8 weight[out][in]（实际权重 = weight * scale）
+ *         float bias[out]
+ * 隐藏层接 ReLU，最后一层为线性输出。
+ *
+ * 载入时权重转置为 [in][out]：矩阵核对一批（至多 4 行）输入逐个输入分量广播、沿输出维连续累加，
+ * 内层循环没有归约，编译器直接向量化（-DSWD_NATIVE_ARCH=ON 时使用本机最宽的向量指令）；
+ * int8 权重在内层循环中转成 float 累加，末尾乘通道缩放。全为 0 的输入分量整行跳过：
+ * 局面特征以独热为主，第一层逐行只触及少量权重行；之后的稠密层按 4 行一组复用权重。
+ */
+class MlpNetwork {
+public:
+    static constexpr uint32_t kVersion = 1;
+
+    bool load(const std::string& path, std::string* error = nullptr);
+    bool save(const std::string& path) const;
+    // 按层宽随机初始化（用于基准与连通性检查）
+    static MlpNetwork random(const std::vector<int>& widths, uint64_t seed, bool quantized);
+
+    bool empty() const { return layers.empty(); }
+    int input_size() const { return layers.empty() ? 0 : layers.front().in; }
+    int output_size() const { return layers.empty() ? 0 : layers.back().out; }
+    int max_width() const;
+
+    // input [batch][input_size] → output [batch][output_size]；scratch 由调用方持有，可跨调用复用
+    void forward(const float* input, int batch, float* output, std::vector<float>& scratch) const;
+
+private:
+    struct Layer {
+        int in = 0;
+        int out = 0;
+        bool quantized = false;
+        std::vector<float> weight_t;        // [in][out]（float 层）
+        std::vector<int8_t> weight_q;       // [in][out]（int8 层）
+        std::vector<float> scale;           // [out]（float 层为 1）
+        std::vector<float> bias;            // [out]
+    };
+
+    static void dense(const Layer& layer, const float* x, int batch, float* y, bool relu, bool sparse_input);
+
+    std::vector<Layer> layers;
+};
+
+#endif
@@ -0,0 +1,120 @@
+#include "NetBot.h"
+#include "NetEvaluator.h"
+#include "Determinize.h"
+#include "core/Game.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+NetBot::NetBot(NetEvaluator& eval, const Options& opts)
+    : evaluator(&eval), options(opts), logits(action_space::kCount), rng(opts.seed), sim(std::make_unique<Game>()) {
+    options.simulations = std::max(1, options.simulations);
+}
+
+NetBot::~NetBot() = default;
+NetBot::NetBot(NetBot&&) noexcept = default;
+
+Move NetBot::choose(const Game& game) {
+    if (game.is_over()) throw std::logic_error("NetBot: game is over");
+    game.save_snapshot(root);
+    nodes.clear();
+    nodes.emplace_back();
+    nodes[0].mover = static_cast<int8_t>(1 - game.get_decision().player);
+
+    for (int s = 0; s < options.simulations; ++s) {
+        sample = root;
+        determinize(sample, rng);
+        sim->load_snapshot(sample);
+        path.clear();
+        path.push_back(0);
+        int node = 0;
+        bool stopped = false;   // 树中的动作在本次采样下不合法：就地评估，不再展开
+        while (nodes[node].expanded && nodes[node].child_count > 0 && !sim->is_over()) {
+            const int next = select_child(node);
+            if (!sim->apply_move(nodes[next].move)) {
+                stopped = true;
+                break;
+            }
+            node = next;
+            path.push_back(node);
+        }
+
+        // 叶节点价值，折算成 to_move 一方的视角后沿路径回传
+        int to_move;
+        float value;
+        if (sim->is_over()) {
+            to_move = sim->get_decision().player;
+            value = sim->get_winner() == to_move ? 1.0f : -1.0f;
+        } else if (stopped) {
+            to_move = sim->get_decision().player;
+            evaluator->evaluate(*sim, logits.data(), value);
+        } else {
+            to_move = sim->get_decision().player;
+            value = expand(node, *sim);
+        }
+        for (int n : path) {
+            nodes[n].visits++;
+            nodes[n].value_sum += nodes[n].mover == to_move ? value : -value;
+        }
+    }
+
+    const Node& r = nodes[0];
+    if (r.child_count == 0) throw std::logic_error("NetBot: no legal moves");
+    int best = r.first_child;
+    for (int c = r.first_child; c < r.first_child + r.child_count; ++c) {
+        if (nodes[c].visits > nodes[best].visits ||
+            (nodes[c].visits == nodes[best].visits && nodes[c].prior > nodes[best].prior)) {
+            best = c;
+        }
+    }
+    return nodes[best].move;
+}
+
+float NetBot::expand(int node, const Game& game) {
+    float value = 0.0f;
+    evaluator->evaluate(game, logits.data(), value);
+    game.legal_moves(legal);
+
+    // 合法动作上的 softmax 作为先验
+    float max_logit = -1e30f;
+    for (const Move& m : legal) {
+        const int a = move_to_action(m);
+        if (a >= 0) max_logit = std::max(max_logit, logits[a]);
+    }
+    const int first = static_cast<int>(nodes.size());
+    const int8_t mover = static_cast<int8_t>(game.get_decision().player);
+    float total = 0.0f;
+    for (const Move& m : legal) {
+        const int a = move_to_action(m);
+        Node child;
+        child.move = m;
+        child.mover = mover;
+        child.prior = a >= 0 ? std::exp(logits[a] - max_logit) : 0.0f;
+        total += child.prior;
+        nodes.push_back(child);
+    }
+    for (int c = first; c < (int)nodes.size(); ++c) {
+        nodes[c].prior = total > 0.0f ? nodes[c].prior / total : 1.0f / legal.size();
+    }
+    nodes[node].first_child = first;
+    nodes[node].child_count = static_cast<int>(legal.size());
+    nodes[node].expanded = true;
+    return value;
+}
+
+int NetBot::select_child(int node) const {
+    const Node& parent = nodes[node];
+    const float scale = options.c_puct * std::sqrt(static_cast<float>(std::max(1, parent.visits)));
+    int best = parent.first_child;
+    float best_score = -1e30f;
+    for (int c = parent.first_child; c < parent.first_child + parent.child_count; ++c) {
+        const Node& child = nodes[c];
+        const float q = child.visits > 0 ? child.value_sum / child.visits : 0.0f;
+        const float score = q + scale * child.prior / (1.0f + child.visits);
+        if (score > best_score) {
+            best_score = score;
+            best = c;
+        }
+    }
+    return best;
+}
@@ -0,0 +1,67 @@
+#ifndef NET_BOT_H
+#define NET_BOT_H
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+#include "core/Move.h"
+#include "core/Snapshot.h"
+
+class Game;
+class NetEvaluator;
+
+/**
+ * NetBot 类：由策略/价值网络引导的蒙特卡洛树搜索（PUCT）
+ *
+ * - 叶节点不做随机走子：由 NetEvaluator 给出各合法动作的先验与当前行动方的价值
+ * - 每次模拟从根快照的一份确定化副本（隐藏信息重新采样，见 ai/Determinize.h）恢复一局对局
+ *   沿树下行，走到未展开的节点或终局为止；树中的动作在本次采样下不合法时就地停下评估
+ * - 多个线程各自持有 NetBot、共用一个 NetEvaluator 时，各线程的叶节点评估被合成一批前向
+ *
+ * 也满足 Playout 的策略约定（choose(game, legal)），可直接用于批量对局。
+ */
+class NetBot {
+public:
+    struct Options {
+        int simulations = 64;
+        float c_puct = 1.5f;
+        uint64_t seed = 1;        // 确定化采样的随机种子
+    };
+
+    NetBot(NetEvaluator& evaluator, const Options& options);
+    ~NetBot();
+    NetBot(NetBot&&) noexcept;
+
+    // 为 game 当前的决策点选出动作（访问次数最多的子节点）；对局已结束时抛出 std::logic_error
+    Move choose(const Game& game);
+    Move choose(const Game& game, const std::vector<Move>&) { return choose(game); }
+
+private:
+    struct Node {
+        Move move;
+        float prior = 0.0f;
+        float value_sum = 0.0f;   // 以走出 move 的一方（mover）为视角
+        int visits = 0;
+        int first_child = -1;
+        int child_count = 0;
+        int8_t mover = 0;
+        bool expanded = false;
+    };
+
+    float expand(int node, const Game& game);   // 返回 game 当前行动方视角的价值
+    int select_child(int node) const;
+
+    NetEvaluator* evaluator;
+    Options options;
+    std::vector<Node> nodes;
+    std::vector<int> path;
+    std::vector<Move> legal;
+    std::vector<float> logits;
+    GameSnapshot root;
+    GameSnapshot sample;      // 本次模拟的确定化局面
+    std::mt19937_64 rng;
+    std::unique_ptr<Game> sim;
+};
+
+#endif
@@ -0,0 +1,93 @@
+#include "NetEvaluator.h"
+#include "env/ObservationEncoder.h"
+#include "core/Game.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+NetEvaluator::NetEvaluator(MlpNetwork net, const Options& opts)
+    : network(std::move(net)), options(opts), feature_count(ObservationEncoder::kSize) {
+    if (network.input_size() != feature_count || network.output_size() != kOutputs) {
+        throw std::invalid_argument("NetEvaluator: network must map " + std::to_string(feature_count) + " features to " +
+                                    std::to_string(kOutputs) + " outputs");
+    }
+    options.max_batch = std::max(1, options.max_batch);
+    for (Batch& b : batches) {
+        b.input.resize(static_cast<std::size_t>(options.max_batch) * feature_count);
+        b.logits.resize(options.max_batch);
+        b.values.resize(options.max_batch);
+    }
+    filling->id = 1;
+    worker = std::thread(&NetEvaluator::inference_loop, this);
+}
+
+NetEvaluator::~NetEvaluator() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    work.notify_all();
+    worker.join();
+}
+
+NetEvaluator::Stats NetEvaluator::get_stats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
+
+void NetEvaluator::evaluate(const Game& game, float* logits, float& value) {
+    thread_local ObservationEncoder encoder;
+    thread_local std::vector<float> features(ObservationEncoder::kSize);
+    encoder.encode(game, features.data());
+
+    std::unique_lock<std::mutex> lock(mutex);
+    space.wait(lock, [&] { return filling->count < options.max_batch; });
+    Batch& batch = *filling;
+    const int slot = batch.count++;
+    std::memcpy(batch.input.data() + static_cast<std::size_t>(slot) * feature_count, features.data(),
+                sizeof(float) * feature_count);
+    batch.logits[slot] = logits;
+    batch.values[slot] = &value;
+    const uint64_t id = batch.id;
+    stats.requests++;
+    if (slot == 0) first_arrival = std::chrono::steady_clock::now();
+    if (slot == 0 || batch.count == options.max_batch) work.notify_one();
+
+    done.wait(lock, [&] { return completed_id >= id; });
+}
+
+void NetEvaluator::inference_loop() {
+    std::vector<float> output;
+    std::vector<float> scratch;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            work.wait(lock, [&] { return stopping || filling->count > 0; });
+            if (filling->count == 0) return;   // stopping 且没有在途请求
+            const auto deadline = first_arrival + std::chrono::microseconds(options.max_wait_us);
+            work.wait_until(lock, deadline, [&] { return stopping || filling->count >= options.max_batch; });
+
+            std::swap(filling, computing);
+            filling->count = 0;
+            filling->id = computing->id + 1;
+            stats.batches++;
+        }
+        space.notify_all();
+
+        const int n = computing->count;
+        output.resize(static_cast<std::size_t>(n) * kOutputs);
+        network.forward(computing->input.data(), n, output.data(), scratch);
+        for (int i = 0; i < n; ++i) {
+            const float* row = output.data() + static_cast<std::size_t>(i) * kOutputs;
+            std::copy(row, row + action_space::kCount, computing->logits[i]);
+            *computing->values[i] = std::tanh(row[action_space::kCount]);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            completed_id = computing->id;
+        }
+        done.notify_all();
+    }
+}
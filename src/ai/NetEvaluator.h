@@ -0,0 +1,79 @@
+#ifndef NET_EVALUATOR_H
+#define NET_EVALUATOR_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "Mlp.h"
+#include "core/Move.h"
+
+class Game;
+
+/**
+ * NetEvaluator 类：把多个对局线程的评估请求合成一批，由推理线程一次前向完成
+ *
+ * - 网络输入为 ObservationEncoder 特征（float），输出为 action_space::kCount 个动作 logit
+ *   加 1 个价值分量（经 tanh 后为当前行动方的期望结果，-1 ~ 1）
+ * - evaluate() 在调用线程上编码局面，放入正在收集的批次后阻塞等待结果；
+ *   批次凑满 max_batch 或第一条请求等待超过 max_wait_us 时送入前向，
+ *   推理期间新的请求进入另一个批次继续收集
+ * - max_batch 宜取同时发起评估的线程数：每个线程同一时刻只有一条请求在途
+ */
+class NetEvaluator {
+public:
+    static constexpr int kOutputs = action_space::kCount + 1;
+
+    struct Options {
+        int max_batch = 16;
+        int max_wait_us = 200;
+    };
+
+    struct Stats {
+        uint64_t requests = 0;
+        uint64_t batches = 0;
+    };
+
+    // 网络的输入/输出宽度与特征、动作空间不符时抛出 std::invalid_argument
+    NetEvaluator(MlpNetwork network, const Options& options);
+    ~NetEvaluator();
+    NetEvaluator(const NetEvaluator&) = delete;
+    NetEvaluator& operator=(const NetEvaluator&) = delete;
+
+    // logits 至少 action_space::kCount 个元素；value 为 game 当前行动方视角
+    void evaluate(const Game& game, float* logits, float& value);
+    Stats get_stats() const;
+
+private:
+    struct Batch {
+        std::vector<float> input;          // [max_batch][特征数]
+        std::vector<float*> logits;        // 各请求的结果写回位置
+        std::vector<float*> values;
+        int count = 0;
+        uint64_t id = 0;
+    };
+
+    void inference_loop();
+
+    MlpNetwork network;
+    Options options;
+    int feature_count;
+
+    mutable std::mutex mutex;
+    std::condition_variable work;       // 推理线程：有请求 / 批次已满
+    std::condition_variable space;      // 请求线程：收集中的批次已满，等待换批
+    std::condition_variable done;       // 请求线程：某批次已完成
+    Batch batches[2];
+    Batch* filling = &batches[0];
+    Batch* computing = &batches[1];
+    std::chrono::steady_clock::time_point first_arrival;
+    uint64_t completed_id = 0;
+    bool stopping = false;
+    Stats stats;
+
+    std::thread worker;
+};
+
+#endif
@@ -0,0 +1,188 @@
+#include "OpeningBook.h"
+#include "core/Game.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
+#ifdef _WIN32
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+inline uint64_t home_slot(uint64_t position, uint32_t bucket_bits) {
+    return bucket_bits == 0 ? 0 : position >> (64 - bucket_bits);
+}
+
+bool fail(std::string* error, const std::string& message) {
+    if (error) *error = message;
+    return false;
+}
+
+} // namespace
+
+// ===== OpeningBook =====
+
+OpeningBook::~OpeningBook() {
+    close();
+}
+
+bool OpeningBook::open(const std::string& path, std::string* error) {
+    close();
+    const void* data = nullptr;
+    std::size_t size = 0;
+#ifdef _WIN32
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return fail(error, "cannot open " + path);
+    fallback.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    data = fallback.data();
+    size = fallback.size();
+#else
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return fail(error, "cannot open " + path);
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(BookHeader)) {
+        ::close(fd);
+        return fail(error, path + ": not an opening book");
+    }
+    size = static_cast<std::size_t>(st.st_size);
+    void* mapped = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);   // 映射建立后不再需要描述符
+    if (mapped == MAP_FAILED) return fail(error, "cannot map " + path);
+    mapping = mapped;
+    mapping_size = size;
+    data = mapped;
+#endif
+    const auto* h = static_cast<const BookHeader*>(data);
+    if (size < sizeof(BookHeader) || h->magic != BookHeader::kMagic || h->version != BookHeader::kVersion ||
+        h->bucket_bits > 40 || (uint64_t(1) << h->bucket_bits) > h->slot_count ||
+        size != sizeof(BookHeader) + h->slot_count * sizeof(BookEntry)) {
+        close();
+        return fail(error, path + ": not an opening book");
+    }
+    header = h;
+    entries = reinterpret_cast<const BookEntry*>(h + 1);
+    return true;
+}
+
+void OpeningBook::close() {
+#ifndef _WIN32
+    if (mapping) munmap(mapping, mapping_size);
+#endif
+    mapping = nullptr;
+    mapping_size = 0;
+    fallback.clear();
+    header = nullptr;
+    entries = nullptr;
+}
+
+bool OpeningBook::probe(const Game& game, std::vector<BookMove>& out) const {
+    out.clear();
+    if (!entries || game.is_over()) return false;
+    const uint64_t position = game.visible_hash();
+    const Decision& decision = game.get_decision();
+    for (uint64_t slot = home_slot(position, header->bucket_bits); slot < header->slot_count; ++slot) {
+        const BookEntry& e = entries[slot];
+        if (e.visits == 0 || e.position > position) break;
+        if (e.position < position) continue;
+        BookMove m;
+        if (!action_to_move(e.action, decision, m.move)) continue;
+        m.visits = e.visits;
+        m.wins = e.wins;
+        out.push_back(m);
+    }
+    return !out.empty();
+}
+
+bool OpeningBook::best_move(const Game& game, Move& out, uint32_t min_visits) const {
+    thread_local std::vector<BookMove> moves;
+    if (!probe(game, moves)) return false;
+    const BookMove* best = nullptr;
+    double best_rate = -1.0;
+    for (const BookMove& m : moves) {
+        if (m.visits < min_visits) continue;
+        const double rate = (m.wins + 1.0) / (m.visits + 2.0);
+        if (rate > best_rate) {
+            best_rate = rate;
+            best = &m;
+        }
+    }
+    if (!best) return false;
+    out = best->move;
+    return true;
+}
+
+// ===== OpeningBookBuilder =====
+
+void OpeningBookBuilder::record(const Game& game, const Move& move) {
+    const int action = move_to_action(move);
+    if (action < 0) return;
+    pending.push_back(Pending{Key{game.visible_hash(), static_cast<uint16_t>(action)},
+                              game.get_decision().player});
+}
+
+void OpeningBookBuilder::finish(int winner) {
+    for (const Pending& p : pending) {
+        Stats& s = stats[p.key];
+        s.visits++;
+        if (p.mover == winner) s.wins++;
+    }
+    pending.clear();
+}
+
+void OpeningBookBuilder::merge(const OpeningBookBuilder& other) {
+    for (const auto& [key, s] : other.stats) {
+        Stats& mine = stats[key];
+        mine.visits += s.visits;
+        mine.wins += s.wins;
+    }
+}
+
+bool OpeningBookBuilder::write(const std::string& path, std::string* error) const {
+    std::vector<BookEntry> sorted;
+    sorted.reserve(stats.size());
+    for (const auto& [key, s] : stats) {
+        BookEntry e;
+        e.position = key.position;
+        e.action = key.action;
+        e.visits = s.visits;
+        e.wins = s.wins;
+        sorted.push_back(e);
+    }
+    std::sort(sorted.begin(), sorted.end(), [](const BookEntry& a, const BookEntry& b) {
+        return a.position != b.position ? a.position < b.position : a.action < b.action;
+    });
+
+    // 起始槽数取不小于条目数两倍的 2 的幂（装载因子 ≤ 0.5）
+    BookHeader header;
+    while ((uint64_t(1) << header.bucket_bits) < sorted.size() * 2) header.bucket_bits++;
+    const uint64_t buckets = uint64_t(1) << header.bucket_bits;
+
+    std::vector<BookEntry> table(buckets);
+    uint64_t next = 0;
+    for (const BookEntry& e : sorted) {
+        const uint64_t slot = std::max(home_slot(e.position, header.bucket_bits), next);
+        if (slot >= table.size()) table.resize(slot + 1);
+        table[slot] = e;
+        next = slot + 1;
+    }
+    header.slot_count = table.size();
+    header.entry_count = sorted.size();
+
+    const std::string tmp = path + ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::binary);
+        if (!out) return fail(error, "cannot create " + tmp);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(table.data()), table.size() * sizeof(BookEntry));
+        if (!out) return fail(error, "cannot write " + tmp);
+    }
+    // 先写临时文件再改名：已映射旧文件的进程不受影响
+    if (std::rename(tmp.c_str(), path.c_str()) != 0) return fail(error, "cannot rename " + tmp);
+    return true;
+}
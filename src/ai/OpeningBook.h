@@ -0,0 +1,125 @@
+#ifndef OPENING_BOOK_H
+#define OPENING_BOOK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "core/Move.h"
+
+class Game;
+
+/**
+ * 开局库文件格式（小端，定长，可直接 mmap 使用）：
+ *   BookHeader
+ *   BookEntry[slot_count]
+ *
+ * 条目是 (局面哈希, 动作) 的统计。表按局面哈希的高 bucket_bits 位定位起始槽，开放寻址：
+ * 建库时把全部条目按 (position, action) 排序后依次放入 max(起始槽, 上一条的下一槽)，
+ * 因此整张表按 position 有序，同一局面的各动作相邻。尾部留出溢出槽，不回绕。
+ * 查询从起始槽向后扫描，遇到空槽或更大的 position 即停止。
+ */
+struct BookHeader {
+    static constexpr uint32_t kMagic = 0x42445753;   // "SWDB"
+    static constexpr uint32_t kVersion = 2;          // v2：以可见局面键为键（v1 为含发牌的局面哈希）
+
+    uint32_t magic = kMagic;
+    uint32_t version = kVersion;
+    uint32_t bucket_bits = 0;
+    uint32_t reserved = 0;
+    uint64_t slot_count = 0;      // 起始槽 2^bucket_bits 个 + 溢出槽
+    uint64_t entry_count = 0;
+};
+
+struct BookEntry {
+    uint64_t position = 0;        // Game::visible_hash()
+    uint32_t visits = 0;          // 0 表示空槽
+    uint32_t wins = 0;            // 走出该动作的一方最终获胜的局数
+    uint16_t action = 0;          // action_space 编号（见 core/Move.h）
+    uint16_t reserved[3] = {};
+};
+
+static_assert(sizeof(BookHeader) == 32, "BookHeader layout is part of the file format");
+static_assert(sizeof(BookEntry) == 24, "BookEntry layout is part of the file format");
+
+/**
+ * 开局库中某一动作的统计
+ */
+struct BookMove {
+    Move move;
+    uint32_t visits = 0;
+    uint32_t wins = 0;
+};
+
+/**
+ * OpeningBook 类：只读开局库
+ *
+ * open() 以只读共享方式 mmap 整个文件，不做解析也不拷贝：打开代价与文件大小无关，
+ * 多个进程打开同一文件时共用页缓存中的同一份页面。Windows 下退化为整体读入内存。
+ * 以 Game::visible_hash() 为键：只含行动方看得到的信息（背面牌身份、以后时代的牌序、
+ * 盒中进步标记都不计入），不同发牌种子下出现的同一可见局面共用同一组统计。
+ */
+class OpeningBook {
+public:
+    OpeningBook() = default;
+    ~OpeningBook();
+    OpeningBook(const OpeningBook&) = delete;
+    OpeningBook& operator=(const OpeningBook&) = delete;
+
+    bool open(const std::string& path, std::string* error = nullptr);
+    void close();
+    bool is_open() const { return entries != nullptr; }
+    uint64_t entry_count() const { return header ? header->entry_count : 0; }
+
+    // 当前决策点在库中的全部动作统计（按动作编号升序）；未命中时返回 false
+    bool probe(const Game& game, std::vector<BookMove>& out) const;
+    // 访问次数不少于 min_visits 的动作中平均胜率（加一平滑）最高者；没有时返回 false
+    bool best_move(const Game& game, Move& out, uint32_t min_visits = 8) const;
+
+private:
+    const BookHeader* header = nullptr;
+    const BookEntry* entries = nullptr;
+    void* mapping = nullptr;
+    std::size_t mapping_size = 0;
+    std::vector<char> fallback;   // 不支持 mmap 的平台
+};
+
+/**
+ * OpeningBookBuilder 类：汇总自对弈的 (局面, 动作, 胜负) 并写出开局库
+ *
+ * 每个线程各持有一个 builder，结束时 merge() 合并后一次 write()。
+ */
+class OpeningBookBuilder {
+public:
+    // mover 在 game 当前决策点走出 move 之前调用；对局结束后以 finish(winner) 结算本局全部记录
+    void record(const Game& game, const Move& move);
+    void finish(int winner);
+
+    void merge(const OpeningBookBuilder& other);
+    std::size_t size() const { return stats.size(); }
+    bool write(const std::string& path, std::string* error = nullptr) const;
+
+private:
+    struct Key {
+        uint64_t position;
+        uint16_t action;
+        bool operator==(const Key& o) const { return position == o.position && action == o.action; }
+    };
+    struct KeyHash {
+        std::size_t operator()(const Key& k) const { return static_cast<std::size_t>(k.position ^ (uint64_t(k.action) * 0x9E3779B97F4A7C15ull)); }
+    };
+    struct Stats {
+        uint32_t visits = 0;
+        uint32_t wins = 0;
+    };
+    struct Pending {
+        Key key;
+        int8_t mover;
+    };
+
+    std::unordered_map<Key, Stats, KeyHash> stats;
+    std::vector<Pending> pending;   // 本局尚未结算的记录
+};
+
+#endif
@@ -0,0 +1,75 @@
+#ifndef PLAYOUT_H
+#define PLAYOUT_H
+
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+#include "core/Game.h"
+
+/**
+ * Playout<Policy, Sink>：编译期特化的对局驱动循环
+ *
+ * 大批量模拟（搜索的随机走子、tournament）每个决策点都要选一次动作，
+ * 若经由虚函数或 std::function 选择策略，调用无法内联。这里把策略与观察者作为模板参数：
+ * - Policy 需提供 `Move choose(const Game&, const std::vector<Move>& legal)`
+ * - Sink 与 EventBus 订阅者的约定相同（kEnabled + on(const E&)），每步由驱动直接
+ *   以 MoveApplied 调用（静态分派，可内联）；kEnabled 为 false 时（如 NullSink）整体去掉
+ * 控制台程序仍走 Controller 的动态路径。
+ */
+template <class Policy, class Sink>
+class Playout {
+public:
+    explicit Playout(Policy policy = Policy(), Sink sink = Sink()) : policy(std::move(policy)), sink(std::move(sink)) {
+        moves.reserve(256);
+    }
+
+    // 回答当前决策点；没有合法动作（或对局已结束）时返回 false
+    bool step(Game& game) {
+        game.legal_moves(moves);
+        if (moves.empty()) return false;
+        const int8_t player = game.get_decision().player;
+        const Move move = policy.choose(game, moves);
+        game.apply_move(move);
+        if constexpr (Sink::kEnabled) sink.on(MoveApplied{player, move});
+        return true;
+    }
+
+    // 走到终局（或 max_moves 步）并返回胜者座位号
+    int run(Game& game, int max_moves = kMaxMoves) {
+        int n = 0;
+        while (n < max_moves && !game.is_over() && step(game)) ++n;
+        moves_played = n;
+        return game.get_winner();
+    }
+
+    int last_move_count() const { return moves_played; }
+    Policy& get_policy() { return policy; }
+    Sink& get_sink() { return sink; }
+
+    static constexpr int kMaxMoves = 400;   // 防御性上限，正常对局远小于此
+
+private:
+    Policy policy;
+    Sink sink;
+    std::vector<Move> moves;
+    int moves_played = 0;
+};
+
+// 均匀随机选择合法动作
+struct RandomPolicy {
+    std::mt19937_64 rng;
+
+    explicit RandomPolicy(uint64_t seed = 1) : rng(seed) {}
+    Move choose(const Game&, const std::vector<Move>& legal) {
+        std::uniform_int_distribution<std::size_t> pick(0, legal.size() - 1);
+        return legal[pick(rng)];
+    }
+};
+
+// 总是选第一个合法动作（确定性基线，便于复现与测量）
+struct FirstMovePolicy {
+    Move choose(const Game&, const std::vector<Move>& legal) { return legal.front(); }
+};
+
+#endif
@@ -0,0 +1,55 @@
+#include "PonderBot.h"
+#include "core/Game.h"
+
+PonderBot::PonderBot(Game& game, int threads, int64_t think_ms)
+    : game(game), searcher(threads), think_ms(think_ms) {
+    observer.bot = this;
+    game.events().subscribe(observer);
+    searcher.set_position(game);
+    ponder();
+}
+
+PonderBot::~PonderBot() {
+    game.events().unsubscribe(&observer);
+    searcher.stop();
+    searcher.wait();
+}
+
+void PonderBot::ponder() {
+    if (!game.is_over()) searcher.start(SearchLimits{});
+}
+
+void PonderBot::resync() {
+    if (searcher.root_hash() != game.position_hash()) searcher.set_position(game);
+}
+
+void PonderBot::on_move_applied(const Move& move) {
+    searcher.stop();
+    searcher.wait();
+    // 移根失败（不应发生）时以实际局面重新建树
+    if (!searcher.advance(move) || searcher.root_hash() != game.position_hash()) searcher.set_position(game);
+    ponder();
+}
+
+SearchResult PonderBot::think(uint64_t* reused) {
+    searcher.stop();
+    searcher.wait();
+    resync();
+    if (reused) *reused = searcher.root_visits();
+
+    SearchLimits limits;
+    limits.movetime_ms = think_ms;
+    searcher.start(limits);
+    searcher.wait();
+    return searcher.result();
+}
+
+SearchResult PonderBot::advice() {
+    searcher.stop();
+    searcher.wait();
+    resync();
+    SearchResult r = searcher.result();
+    r.nodes = searcher.root_visits();
+    ponder();
+    return r;
+}
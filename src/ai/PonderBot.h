@@ -0,0 +1,53 @@
+#ifndef PONDER_BOT_H
+#define PONDER_BOT_H
+
+#include <cstdint>
+#include "Search.h"
+#include "core/GameEvents.h"
+
+class Game;
+
+/**
+ * PonderBot 类：控制台对局中的后台思考机器人 / 提示顾问
+ *
+ * - 对手（人类）读盘思考期间，搜索在后台线程持续进行（pondering）
+ * - 每走出一步（无论谁走），搜索树移根到实际走出的子节点，已有统计继续沿用
+ * - think() 为机器人自己的决策点在已有树上再搜索 think_ms 毫秒
+ * - advice() 暂停片刻读取当前树根统计，立即给出提示，随后继续思考
+ *
+ * 通过 Observer 订阅对局的 MoveApplied 事件得知每一步；若事件被编译关闭，
+ * think()/advice() 会按局面哈希发现树根过期并重新建树。
+ */
+class PonderBot {
+public:
+    PonderBot(Game& game, int threads, int64_t think_ms);
+    ~PonderBot();
+    PonderBot(const PonderBot&) = delete;
+    PonderBot& operator=(const PonderBot&) = delete;
+
+    struct Observer {
+        static constexpr bool kEnabled = true;
+        static constexpr bool kPollsWithoutEvents = true;   // 事件关闭时按局面哈希 resync()
+        PonderBot* bot = nullptr;
+
+        template <class E> void on(const E&) {}
+        void on(const MoveApplied& e) { bot->on_move_applied(e.move); }
+    };
+
+    // 为当前决策点选出动作（阻塞 think_ms 毫秒）；reused 为沿用的模拟次数
+    SearchResult think(uint64_t* reused = nullptr);
+    // 立即返回当前树根的最佳动作，不打断后台思考；nodes 为树根累积的模拟次数
+    SearchResult advice();
+
+private:
+    void on_move_applied(const Move& move);
+    void resync();      // 树根与实际局面不一致时重新建树
+    void ponder();      // 对局未结束时开始无限搜索
+
+    Game& game;
+    Searcher searcher;
+    Observer observer;
+    int64_t think_ms;
+};
+
+#endif
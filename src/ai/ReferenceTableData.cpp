@@ -0,0 +1,104 @@
+// ReferenceTableData.cpp —— 参考模型的固定卡牌/奇迹参数表（由 swd_fuzz --dump-tables 生成；目录有意改动后重新生成）
+//
+// 字段顺序见 ai/ReferenceTables.h 中的 CardRow 与 WonderRow。
+#include "ReferenceTables.h"
+
+namespace reference {
+
+// name, age, color, coin_cost, need[5], chain, link, victory_points, shields, science, produce[5],
+// coin_gain, fixed_mask, wild_raw, wild_manufactured, reward_active, reward_color, reward_coins, reward_wonders, reward_both
+const CardRow kCards[] = {
+    {"Lumber Yard", 1, 0, 0, {0, 0, 0, 0, 0}, -1, -1, 0, 0, -1, {1, 0, 0, 0, 0}, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {"Logging Camp", 1, 0, 1, {0, 0, 0, 0, 0}, -1, -1, 0, 0, -1, {1, 0, 0, 0, 0}, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {"Clay Pool", 1, 0, 0, {0, 0, 0, 0, 0}, -1, -1, 0, 0, -1, {0, 1, 0, 0, 0}, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {"Clay Pit", 1, 0, 1, {0, 0, 0, 0, 0}, -1, -1, 0, 0, -1, {0, 1, 0, 0, 0}, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {"Quarry", 1, 0, 0, {0, 0, 0, 0, 0}, -1, -1, 0, 0, -1, {0, 0, 1, 0, 0}, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {"Stone Pit", 1, 0, 1, {0, 0, 0, 0, 0}, -1, -1, 0, 0, -1, {0, 0, 1, 0, 0}, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {"Glassworks", 1, 1, 1, {0, 0, 0, 0, 0}, -1, -1, 0, 0, -1, {0, 0, 0, 1, 0}, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {"Press", 1, 1, 1, {0, 0, 0, 0, 0}, -1, -1, 0, 0, -1, {0, 0, 0, 0, 1}, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {"Altar", 1, 2, 0, {0, 0, 0, 0, 0}, -1, 11, 3, 0, -1, {0, 0, 0, 0, 0}, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {"Theater", 1, 2, 0, {0, 0, 0, 0, 0}, -1, 10, 3, 0, -1, {0, 0, 0, 0, 0}, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {"Baths", 1, 2, 0, {0, 0, 1, 0, 0}, -1, 13, 3, 0, -1, {0, 0, 0, 0, 0}, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {"Workshop", 1, 5, 0, {0, 0, 0, 0, 1}, -1, 4, 0, 0, 8, {0, 0, 0, 0, 0}, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {"Apothecary", 1, 5, 0, {0, 0, 0, 1, 0}, -1, 8, 0, 0, 7, {0, 0, 0, 0, 0}, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {"Scriptorium", 1, 5, 2, {0, 0, 0, 0, 0}, -1, 6, 0, 0, 9, {0, 0, 0, 0, 0}, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {"Pharmacist", 1, 5, 2, {0, 0, 0, 0, 0}, -1, 7, 0, 0, 10, {0, 0, 0, 0, 0}, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {"Tavern", 1, 3, 0, {0, 0, 0, 0, 0}, -1, 17, 0, 0, -1, {0, 0, 0, 0, 0}, 4, 0, 0, 0, 0, 0, 0, 0, 0},
+    {"Stone Reserve", 1, 3, 3, {0, 0, 0, 0, 0}, -1, -1, 0, 0, -1, {0, 0, 0, 0, 0}, 0, 4, 0, 0, 0, 0, 0, 0, 0},
+    {"Clay Reserve", 1, 3, 3, {0, 0, 0, 0, 0}, -1, -1, 0, 0, -1, {0, 0, 0, 0, 0}, 0, 2, 0, 0, 0, 0, 0, 0, 0},
+    {"Wood Reserve", 1, 3, 3, {0, 0, 0, 0, 0}, -1, -1, 0, 0, -1, {0, 0, 0, 0, 0}, 0, 1, 0, 0, 0, 0, 0, 0, 0},
+    {"Garrison/Palisade/Guard", 1, 4, 0, {0, 0, 0, 0, 0}, -1, 1, 0, 1, -1, {0, 0, 0, 0, 0}, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {"Garrison/Palisade/Guard", 1, 4, 0, {0, 0, 0, 0, 0}, -1, 2, 0, 1, -1, {0, 0, 0, 0, 0}, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {"Garrison/Palisade/Guard", 1, 4, 0, {0, 0, 0, 0, 0}, -1, 2, 0, 1, -1, {0, 0, 0, 0, 0}, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {"Sawmill", 2, 0, 2, {0, 0, 0, 0, 0}, -1, -1, 0, 0, -1, {2, 0, 0, 0, 0}, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {"Brickyard", 2, 0, 2, {0, 0, 0, 0, 0}, -1, -1, 0, 0, -1, {0, 2, 0, 0, 0}, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {"Shelf Quarry", 2, 0, 2, {0, 0, 0, 0, 0}, -1, -1, 0, 0, -1, {0, 0, 2, 0, 0}, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {"Statue", 2, 2, 0, {0, 2, 0, 0, 0}, 10, 16, 4, 0, -1, {0, 0, 0, 0, 0}, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {"Temple", 2, 2, 0, {1, 0, 0, 0, 1}, 11, 12, 4, 0, -1, {0, 0, 0, 0, 0}, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {"Aqueduct", 2, 2, 0, {0, 0, 3, 0, 0}, 13, -1, 5, 0, -1, {0, 0, 0, 0, 0}, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {"Library", 2, 5, 0, {1, 0, 1, 1, 0}, 6, 6, 2, 0, 11, {0, 0, 0, 0, 0}, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {"Dispensary", 2, 5, 0, {0, 2, 0, 1, 0}, 9, 7, 2, 0, 10, {0, 0, 0, 0, 0}, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {"Forum", 2, 3, 3, {0, 1, 0, 0, 0}, -1, 18, 0, 0, -1, {0, 0, 0, 0, 0}, 0, 0, 0, 1, 0, 0, 0, 0, 0},
+    {"Brewery", 2, 3, 0, {0, 0, 0, 0, 0}, 17, -1, 0, 0, -1, {0, 0, 0, 0, 0}, 6, 0, 0, 0, 0, 0, 0, 0, 0},
+    {"Walls", 2, 4, 0, {0, 0, 2, 0, 0}, -1, -1, 0, 2, -1, {0, 0, 0, 0, 0}, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {"Age2_Fill_Card", 2, 4, 0, {0, 0, 0, 0, 0}, -1, -1, 0, 0, -1, {0, 0, 0, 0, 0}, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {"Age2_Fill_Card", 2, 4, 0, {0, 0, 0, 0, 0}, -1, -1, 0, 0, -1, {0, 0, 0, 0, 0}, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {"Age2_Fill_Card", 2, 4, 0, {0, 0, 0, 0, 0}, -1, -1, 0, 0, -1, {0, 0, 0, 0, 0}, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {"Age2_Fill_Card", 2, 4, 0, {0, 0, 0, 0, 0}, -1, -1, 0, 0, -1, {0, 0, 0, 0, 0}, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {"Age2_Fill_Card", 2, 4, 0, {0, 0, 0, 0, 0}, -1, -1, 0, 0, -1, {0, 0, 0, 0, 0}, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {"Age2_Fill_Card", 2, 4, 0, {0, 0, 0, 0, 0}, -1, -1, 0, 0, -1, {0, 0, 0, 0, 0}, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {"Age2_Fill_Card", 2, 4, 0, {0, 0, 0, 0, 0}, -1, -1, 0, 0, -1, {0, 0, 0, 0, 0}, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {"Age2_Fill_Card", 2, 4, 0, {0, 0, 0, 0, 0}, -1, -1, 0, 0, -1, {0, 0, 0, 0, 0}, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {"Age2_Fill_Card", 2, 4, 0, {0, 0, 0, 0, 0}, -1, -1, 0, 0, -1, {0, 0, 0, 0, 0}, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {"Age2_Fill_Card", 2, 4, 0, {0, 0, 0, 0, 0}, -1, -1, 0, 0, -1, {0, 0, 0, 0, 0}, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {"Age2_Fill_Card", 2, 4, 0, {0, 0, 0, 0, 0}, -1, -1, 0, 0, -1, {0, 0, 0, 0, 0}, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {"Age2_Fill_Card", 2, 4, 0, {0, 0, 0, 0, 0}, -1, -1, 0, 0, -1, {0, 0, 0, 0, 0}, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {"Palace", 3, 2, 0, {2, 2, 2, 1, 1}, 12, -1, 8, 0, -1, {0, 0, 0, 0, 0}, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {"Gardens", 3, 2, 0, {2, 2, 0, 0, 0}, 16, -1, 6, 0, -1, {0, 0, 0, 0, 0}, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {"Arsenal", 3, 4, 0, {2, 3, 0, 0, 0}, -1, -1, 0, 3, -1, {0, 0, 0, 0, 0}, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {"Arena", 3, 3, 0, {1, 1, 1, 0, 0}, -1, -1, 3, 0, -1, {0, 0, 0, 0, 0}, 0, 0, 0, 0, 1, 3, 2, 1, 0},
+    {"Age3_Fill_Card", 3, 2, 0, {0, 0, 0, 0, 0}, -1, -1, 0, 0, -1, {0, 0, 0, 0, 0}, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {"Age3_Fill_Card", 3, 2, 0, {0, 0, 0, 0, 0}, -1, -1, 0, 0, -1, {0, 0, 0, 0, 0}, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {"Age3_Fill_Card", 3, 2, 0, {0, 0, 0, 0, 0}, -1, -1, 0, 0, -1, {0, 0, 0, 0, 0}, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {"Age3_Fill_Card", 3, 2, 0, {0, 0, 0, 0, 0}, -1, -1, 0, 0, -1, {0, 0, 0, 0, 0}, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {"Age3_Fill_Card", 3, 2, 0, {0, 0, 0, 0, 0}, -1, -1, 0, 0, -1, {0, 0, 0, 0, 0}, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {"Age3_Fill_Card", 3, 2, 0, {0, 0, 0, 0, 0}, -1, -1, 0, 0, -1, {0, 0, 0, 0, 0}, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {"Age3_Fill_Card", 3, 2, 0, {0, 0, 0, 0, 0}, -1, -1, 0, 0, -1, {0, 0, 0, 0, 0}, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {"Age3_Fill_Card", 3, 2, 0, {0, 0, 0, 0, 0}, -1, -1, 0, 0, -1, {0, 0, 0, 0, 0}, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {"Age3_Fill_Card", 3, 2, 0, {0, 0, 0, 0, 0}, -1, -1, 0, 0, -1, {0, 0, 0, 0, 0}, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {"Age3_Fill_Card", 3, 2, 0, {0, 0, 0, 0, 0}, -1, -1, 0, 0, -1, {0, 0, 0, 0, 0}, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {"Age3_Fill_Card", 3, 2, 0, {0, 0, 0, 0, 0}, -1, -1, 0, 0, -1, {0, 0, 0, 0, 0}, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {"Age3_Fill_Card", 3, 2, 0, {0, 0, 0, 0, 0}, -1, -1, 0, 0, -1, {0, 0, 0, 0, 0}, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {"Age3_Fill_Card", 3, 2, 0, {0, 0, 0, 0, 0}, -1, -1, 0, 0, -1, {0, 0, 0, 0, 0}, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {"Age3_Fill_Card", 3, 2, 0, {0, 0, 0, 0, 0}, -1, -1, 0, 0, -1, {0, 0, 0, 0, 0}, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {"Age3_Fill_Card", 3, 2, 0, {0, 0, 0, 0, 0}, -1, -1, 0, 0, -1, {0, 0, 0, 0, 0}, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {"Age3_Fill_Card", 3, 2, 0, {0, 0, 0, 0, 0}, -1, -1, 0, 0, -1, {0, 0, 0, 0, 0}, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {"Builders Guild", 3, 6, 0, {0, 0, 0, 0, 0}, -1, -1, 0, 0, -1, {0, 0, 0, 0, 0}, 0, 0, 0, 0, 1, 6, 0, 1, 1},
+    {"Scientists Guild", 3, 6, 0, {0, 0, 0, 0, 0}, -1, -1, 0, 0, -1, {0, 0, 0, 0, 0}, 0, 0, 0, 0, 1, 5, 1, 0, 1},
+    {"Tacticians Guild", 3, 6, 0, {0, 0, 0, 0, 0}, -1, -1, 0, 0, -1, {0, 0, 0, 0, 0}, 0, 0, 0, 0, 1, 4, 1, 0, 1},
+    {"Merchants Guild", 3, 6, 0, {0, 0, 0, 0, 0}, -1, -1, 0, 0, -1, {0, 0, 0, 0, 0}, 0, 0, 0, 0, 1, 3, 1, 0, 1},
+    {"Other Guild", 3, 6, 0, {0, 0, 0, 0, 0}, -1, -1, 0, 0, -1, {0, 0, 0, 0, 0}, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {"Other Guild", 3, 6, 0, {0, 0, 0, 0, 0}, -1, -1, 0, 0, -1, {0, 0, 0, 0, 0}, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {"Other Guild", 3, 6, 0, {0, 0, 0, 0, 0}, -1, -1, 0, 0, -1, {0, 0, 0, 0, 0}, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+};
+const int kCardCount = static_cast<int>(sizeof(kCards) / sizeof(kCards[0]));
+
+// name, coin_cost, need[5], victory_points, shields, self_coins, opp_coins, wild_raw, wild_manufactured,
+// flags, destroy_color, token_offer
+const WonderRow kWonders[] = {
+    {"The Appian Way", 0, {1, 1, 2, 0, 0}, 3, 0, 3, -3, 0, 0, 1, 0, 0},
+    {"Circus Maximus", 0, {0, 0, 2, 1, 0}, 3, 1, 0, 0, 0, 0, 2, 1, 0},
+    {"The Colossus", 0, {0, 3, 0, 1, 0}, 3, 2, 0, 0, 0, 0, 0, 0, 0},
+    {"The Great Library", 0, {3, 0, 0, 1, 1}, 4, 0, 0, 0, 0, 0, 8, 0, 3},
+    {"The Great Lighthouse", 0, {1, 0, 2, 0, 1}, 4, 0, 0, 0, 1, 0, 0, 0, 0},
+    {"The Hanging Gardens", 0, {2, 0, 0, 1, 1}, 3, 0, 6, 0, 0, 0, 1, 0, 0},
+    {"The Mausoleum", 0, {0, 2, 0, 1, 1}, 2, 0, 0, 0, 0, 0, 4, 0, 0},
+    {"Piraeus", 0, {2, 1, 1, 0, 0}, 2, 0, 0, 0, 0, 1, 1, 0, 0},
+    {"The Pyramids", 0, {0, 0, 3, 0, 1}, 9, 0, 0, 0, 0, 0, 0, 0, 0},
+    {"The Sphinx", 0, {0, 1, 1, 2, 0}, 6, 0, 0, 0, 0, 0, 1, 0, 0},
+    {"The Statue of Zeus", 0, {0, 1, 1, 0, 2}, 3, 1, 0, 0, 0, 0, 2, 0, 0},
+    {"The Temple of Artemis", 0, {1, 0, 1, 1, 1}, 0, 0, 12, 0, 0, 0, 1, 0, 0},
+};
+const int kWonderCount = static_cast<int>(sizeof(kWonders) / sizeof(kWonders[0]));
+
+} // namespace reference
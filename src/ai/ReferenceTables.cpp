@@ -0,0 +1,284 @@
+#include "ReferenceTables.h"
+#include "core/Game.h"
+#include "core/Snapshot.h"
+#include "cards/Card.h"
+#include "cards/CardSignature.h"
+#include "cards/Wonder.h"
+#include "player/Player.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace reference {
+
+namespace {
+
+bool is_raw_choice(uint16_t bits) {
+    return bits == ((1u << (int)Resource::WOOD) | (1u << (int)Resource::CLAY) | (1u << (int)Resource::STONE));
+}
+bool is_manufactured_choice(uint16_t bits) {
+    return bits == ((1u << (int)Resource::GLASS) | (1u << (int)Resource::PAPYRUS));
+}
+
+// 逐字段比较时的报告器：差异写成 "<kind> <id> (<name>): <field>: reference a, catalog b"
+class Differ {
+public:
+    Differ(std::string* out, const char* kind) : out(out), kind(kind) {}
+
+    void begin(int id, const char* name) {
+        row = id;
+        row_name = name;
+    }
+    void field(const char* what, int ref, int cur) {
+        if (ref != cur) report(what, std::to_string(ref), std::to_string(cur));
+    }
+    void text(const char* what, const std::string& ref, const std::string& cur) {
+        if (ref != cur) report(what, ref, cur);
+    }
+    void row_count(int ref, int cur) {
+        if (ref != cur) report_line(std::string(kind) + " count: reference " + std::to_string(ref) + ", catalog " + std::to_string(cur));
+    }
+    bool clean() const { return count == 0; }
+
+private:
+    void report(const char* what, const std::string& ref, const std::string& cur) {
+        report_line(std::string(kind) + " " + std::to_string(row) + " (" + row_name + "): " + what +
+                    ": reference " + ref + ", catalog " + cur);
+    }
+    void report_line(const std::string& line) {
+        count++;
+        if (out) *out += line + "\n";
+    }
+
+    std::string* out;
+    const char* kind;
+    int row = -1;
+    std::string row_name;
+    int count = 0;
+};
+
+void diff_cards(Differ& d) {
+    const std::vector<CardRow> cur = extract_card_rows();
+    d.row_count(kCardCount, static_cast<int>(cur.size()));
+    for (int id = 0; id < std::min<int>(kCardCount, cur.size()); ++id) {
+        const CardRow& a = kCards[id];
+        const CardRow& b = cur[id];
+        d.begin(id, a.name);
+        d.text("name", a.name, b.name);
+        d.field("age", a.age, b.age);
+        d.field("color", a.color, b.color);
+        d.field("coin_cost", a.coin_cost, b.coin_cost);
+        for (int r = 0; r < kTradable; ++r) d.field("need", a.need[r], b.need[r]);
+        d.field("chain", a.chain, b.chain);
+        d.field("link", a.link, b.link);
+        d.field("victory_points", a.victory_points, b.victory_points);
+        d.field("shields", a.shields, b.shields);
+        d.field("science", a.science, b.science);
+        for (int r = 0; r < kTradable; ++r) d.field("produce", a.produce[r], b.produce[r]);
+        d.field("coin_gain", a.coin_gain, b.coin_gain);
+        d.field("fixed_mask", a.fixed_mask, b.fixed_mask);
+        d.field("wild_raw", a.wild_raw, b.wild_raw);
+        d.field("wild_manufactured", a.wild_manufactured, b.wild_manufactured);
+        d.field("reward_active", a.reward_active, b.reward_active);
+        d.field("reward_color", a.reward_color, b.reward_color);
+        d.field("reward_coins", a.reward_coins, b.reward_coins);
+        d.field("reward_wonders", a.reward_wonders, b.reward_wonders);
+        d.field("reward_both", a.reward_both, b.reward_both);
+    }
+}
+
+void diff_wonders(Differ& d) {
+    const std::vector<WonderRow> cur = extract_wonder_rows();
+    d.row_count(kWonderCount, static_cast<int>(cur.size()));
+    for (int id = 0; id < std::min<int>(kWonderCount, cur.size()); ++id) {
+        const WonderRow& a = kWonders[id];
+        const WonderRow& b = cur[id];
+        d.begin(id, a.name);
+        d.text("name", a.name, b.name);
+        d.field("coin_cost", a.coin_cost, b.coin_cost);
+        for (int r = 0; r < kTradable; ++r) d.field("need", a.need[r], b.need[r]);
+        d.field("victory_points", a.victory_points, b.victory_points);
+        d.field("shields", a.shields, b.shields);
+        d.field("self_coins", a.self_coins, b.self_coins);
+        d.field("opp_coins", a.opp_coins, b.opp_coins);
+        d.field("wild_raw", a.wild_raw, b.wild_raw);
+        d.field("wild_manufactured", a.wild_manufactured, b.wild_manufactured);
+        d.field("flags", a.flags, b.flags);
+        d.field("destroy_color", a.destroy_color, b.destroy_color);
+        d.field("token_offer", a.token_offer, b.token_offer);
+    }
+}
+
+std::string quoted(const char* s) {
+    std::string out = "\"";
+    for (; *s; ++s) {
+        if (*s == '"' || *s == '\\') out += '\\';
+        out += *s;
+    }
+    return out + "\"";
+}
+
+std::string list(const int8_t* v, int n) {
+    std::string out = "{";
+    for (int i = 0; i < n; ++i) out += (i ? ", " : "") + std::to_string(v[i]);
+    return out + "}";
+}
+
+} // namespace
+
+std::vector<CardRow> extract_card_rows() {
+    const auto& catalog = card_catalog();
+    const auto& signatures = card_signatures();
+    std::vector<CardRow> rows(catalog.size());
+    for (const auto& card : catalog) {
+        const CardSignature& s = signatures[card->id];
+        CardRow& row = rows[card->id];
+        row = CardRow{};
+        row.name = card->name.c_str();
+        row.age = static_cast<int8_t>(card->age);
+        row.color = s.color;
+        row.coin_cost = s.coin_cost;
+        row.chain = s.chain;
+        row.link = s.link;
+        row.victory_points = s.victory_points;
+        row.shields = s.shields;
+        row.science = s.science;
+        for (int r = 0; r < kTradable; ++r) {
+            row.need[r] = s.need[r];
+            row.produce[r] = s.produce[r];
+        }
+        row.coin_gain = s.coin_gain;
+        row.fixed_mask = s.fixed_mask;
+        for (int i = 0; i < s.choice_count; ++i) {
+            if (is_raw_choice(s.choices[i])) row.wild_raw++;
+            else if (is_manufactured_choice(s.choices[i])) row.wild_manufactured++;
+            else throw std::logic_error("reference tables: unsupported resource choice on " + card->name);
+        }
+        row.reward_active = s.reward_active;
+        row.reward_color = s.reward_color;
+        row.reward_coins = s.reward_coins;
+        row.reward_wonders = s.reward_wonders;
+        row.reward_both = s.reward_both;
+    }
+    return rows;
+}
+
+// 在一局真实对局上逐个执行奇迹效果，比较前后快照得到效果参数；出现模型无法表示的改动时报错
+std::vector<WonderRow> extract_wonder_rows() {
+    const auto& catalog = wonder_catalog();
+    std::vector<WonderRow> rows(catalog.size());
+    for (const Wonder& w : catalog) {
+        WonderRow& row = rows[w.id];
+        row = WonderRow{};
+        row.name = w.name.c_str();
+        row.victory_points = static_cast<int8_t>(w.victory_points);
+        row.shields = static_cast<int8_t>(w.shields);
+        for (const auto& [res, amount] : w.cost) {
+            const int r = static_cast<int>(res);
+            if (res == Resource::COIN) row.coin_cost = static_cast<int8_t>(amount);
+            else if (r < kTradable) row.need[r] = static_cast<int8_t>(amount);
+            else throw std::logic_error("reference tables: unsupported wonder cost on " + w.name);
+        }
+        if (!w.effect) continue;
+
+        Game game;
+        game.init(1);
+        std::vector<Move> moves;
+        game.legal_moves(moves);
+        game.apply_move(Move(Move::Type::DISCARD, moves.front().pos));  // 让弃牌堆非空
+        Player& self = *game.get_current_player();
+        Player& opp = *game.get_opponent();
+        for (int c = 0; c <= (int)Color::PURPLE; ++c) opp.add_built_card("probe", static_cast<Color>(c));
+
+        GameSnapshot before, after;
+        game.save_snapshot(before);
+        w.effect(self, opp, game);
+        game.save_snapshot(after);
+
+        const auto& sb = before.players[self.get_seat()];
+        const auto& sa = after.players[self.get_seat()];
+        const auto& ob = before.players[opp.get_seat()];
+        const auto& oa = after.players[opp.get_seat()];
+        row.self_coins = static_cast<int8_t>(sa.coins - sb.coins);
+        row.opp_coins = static_cast<int8_t>(oa.coins - ob.coins);
+        for (int i = sb.wildcard_count; i < sa.wildcard_count; ++i) {
+            if (is_raw_choice(sa.wildcards[i])) row.wild_raw++;
+            else if (is_manufactured_choice(sa.wildcards[i])) row.wild_manufactured++;
+            else throw std::logic_error("reference tables: unsupported resource choice on " + w.name);
+        }
+        if (after.extra_turn) row.flags |= EXTRA_TURN;
+
+        const Decision& d = game.get_decision();
+        switch (d.type) {
+            case Decision::Type::PICK_ACTION: break;
+            case Decision::Type::CHOOSE_CARD_TO_DESTROY:
+                row.flags |= DESTROY_CARD;
+                row.destroy_color = static_cast<int8_t>(d.color);
+                break;
+            case Decision::Type::CHOOSE_DISCARDED_CARD:
+                row.flags |= BUILD_FROM_DISCARD;
+                break;
+            case Decision::Type::CHOOSE_PROGRESS_TOKEN:
+                row.flags |= PICK_TOKEN;
+                row.token_offer = d.offered_count;
+                break;
+            default:
+                throw std::logic_error("reference tables: unsupported wonder decision on " + w.name);
+        }
+
+        // 其余字段必须不变
+        auto unchanged = [](const GameSnapshot::PlayerState& a, const GameSnapshot::PlayerState& b) {
+            return a.victory_points == b.victory_points && a.science_symbols == b.science_symbols &&
+                   a.link_symbols == b.link_symbols && a.progress_tokens == b.progress_tokens &&
+                   std::equal(a.resources, a.resources + GameSnapshot::kResourceCount, b.resources) &&
+                   std::equal(a.fixed_trade_costs, a.fixed_trade_costs + GameSnapshot::kResourceCount, b.fixed_trade_costs);
+        };
+        if (!unchanged(sb, sa) || !unchanged(ob, oa) || before.pawn_position != after.pawn_position ||
+            oa.wildcard_count != ob.wildcard_count) {
+            throw std::logic_error("reference tables: unsupported wonder effect on " + w.name);
+        }
+    }
+    return rows;
+}
+
+bool diff_against_catalog(std::string* diff) {
+    Differ cards(diff, "card");
+    diff_cards(cards);
+    Differ wonders(diff, "wonder");
+    diff_wonders(wonders);
+    return cards.clean() && wonders.clean();
+}
+
+std::string dump_catalog_source() {
+    std::string out;
+    out += "// ReferenceTableData.cpp —— 参考模型的固定卡牌/奇迹参数表（由 swd_fuzz --dump-tables 生成；目录有意改动后重新生成）\n";
+    out += "//\n";
+    out += "// 字段顺序见 ai/ReferenceTables.h 中的 CardRow 与 WonderRow。\n";
+    out += "#include \"ReferenceTables.h\"\n\nnamespace reference {\n\n";
+    out += "// name, age, color, coin_cost, need[5], chain, link, victory_points, shields, science, produce[5],\n";
+    out += "// coin_gain, fixed_mask, wild_raw, wild_manufactured, reward_active, reward_color, reward_coins, reward_wonders, reward_both\n";
+    out += "const CardRow kCards[] = {\n";
+    for (const CardRow& c : extract_card_rows()) {
+        out += "    {" + quoted(c.name) + ", " + std::to_string(c.age) + ", " + std::to_string(c.color) + ", " +
+               std::to_string(c.coin_cost) + ", " + list(c.need, kTradable) + ", " + std::to_string(c.chain) + ", " +
+               std::to_string(c.link) + ", " + std::to_string(c.victory_points) + ", " + std::to_string(c.shields) + ", " +
+               std::to_string(c.science) + ", " + list(c.produce, kTradable) + ", " + std::to_string(c.coin_gain) + ", " +
+               std::to_string(c.fixed_mask) + ", " + std::to_string(c.wild_raw) + ", " + std::to_string(c.wild_manufactured) + ", " +
+               std::to_string(c.reward_active) + ", " + std::to_string(c.reward_color) + ", " + std::to_string(c.reward_coins) + ", " +
+               std::to_string(c.reward_wonders) + ", " + std::to_string(c.reward_both) + "},\n";
+    }
+    out += "};\nconst int kCardCount = static_cast<int>(sizeof(kCards) / sizeof(kCards[0]));\n\n";
+    out += "// name, coin_cost, need[5], victory_points, shields, self_coins, opp_coins, wild_raw, wild_manufactured,\n";
+    out += "// flags, destroy_color, token_offer\n";
+    out += "const WonderRow kWonders[] = {\n";
+    for (const WonderRow& w : extract_wonder_rows()) {
+        out += "    {" + quoted(w.name) + ", " + std::to_string(w.coin_cost) + ", " + list(w.need, kTradable) + ", " +
+               std::to_string(w.victory_points) + ", " + std::to_string(w.shields) + ", " + std::to_string(w.self_coins) + ", " +
+               std::to_string(w.opp_coins) + ", " + std::to_string(w.wild_raw) + ", " + std::to_string(w.wild_manufactured) + ", " +
+               std::to_string(w.flags) + ", " + std::to_string(w.destroy_color) + ", " + std::to_string(w.token_offer) + "},\n";
+    }
+    out += "};\nconst int kWonderCount = static_cast<int>(sizeof(kWonders) / sizeof(kWonders[0]));\n\n";
+    out += "} // namespace reference\n";
+    return out;
+}
+
+} // namespace reference
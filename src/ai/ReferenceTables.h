@@ -0,0 +1,86 @@
+#ifndef REFERENCE_TABLES_H
+#define REFERENCE_TABLES_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * 参考模型（ai/BatchPlayout.h）的固定卡牌/奇迹参数表
+ *
+ * 表中数值由 swd_fuzz --dump-tables 从当时的卡牌目录与奇迹效果中提取一次，检入为
+ * ReferenceTableData.cpp；参考模型只读这张表，不再读目录。这样目录数据本身的改动（费用、产出、
+ * 奇迹效果写错）不会同时改变 Game 与参考模型：swd_fuzz 启动时先用 diff_against_catalog()
+ * 逐字段比对，有差异即报告并退出。确认目录的改动是有意的之后，重新生成并检入数据文件。
+ */
+namespace reference {
+
+constexpr int kTradable = 5;   // WOOD..PAPYRUS
+
+// 奇迹效果中需要交互或改变回合流程的部分
+enum WonderFlags : uint8_t {
+    EXTRA_TURN = 1,
+    DESTROY_CARD = 2,        // 拆对手一张 destroy_color 颜色的牌
+    BUILD_FROM_DISCARD = 4,
+    PICK_TOKEN = 8,          // 从盒中前 token_offer 个进步标记中选一个
+};
+
+// 一张卡牌（下标即卡牌目录下标）
+struct CardRow {
+    const char* name;
+    int8_t age;
+    int8_t color;
+    int8_t coin_cost;
+    int8_t need[kTradable];
+    int8_t chain;            // 连锁前置 LinkSymbol，无为 -1
+    int8_t link;             // 提供的 LinkSymbol，无为 -1
+    int8_t victory_points;
+    int8_t shields;
+    int8_t science;          // 科技符号 Resource，无为 -1
+    int8_t produce[kTradable];
+    int8_t coin_gain;
+    uint8_t fixed_mask;      // 交易价固定为 1 的资源位集
+    int8_t wild_raw;         // 木/泥/石 多选一个数
+    int8_t wild_manufactured; // 玻璃/纸草 多选一个数
+    int8_t reward_active;
+    int8_t reward_color;
+    int8_t reward_coins;
+    int8_t reward_wonders;
+    int8_t reward_both;
+};
+
+// 一座奇迹（下标即奇迹目录下标）
+struct WonderRow {
+    const char* name;
+    int8_t coin_cost;
+    int8_t need[kTradable];
+    int8_t victory_points;
+    int8_t shields;
+    int8_t self_coins;       // 建成时自己得到的金币
+    int8_t opp_coins;        // 建成时对手的金币变化（负数为失去）
+    int8_t wild_raw;
+    int8_t wild_manufactured;
+    uint8_t flags;           // WonderFlags
+    int8_t destroy_color;
+    int8_t token_offer;
+};
+
+// 检入的固定表（ReferenceTableData.cpp）
+extern const CardRow kCards[];
+extern const int kCardCount;
+extern const WonderRow kWonders[];
+extern const int kWonderCount;
+
+// 从当前卡牌目录与奇迹效果中提取同样的行；出现参考模型无法表示的效果时抛出 std::logic_error
+std::vector<CardRow> extract_card_rows();
+std::vector<WonderRow> extract_wonder_rows();
+
+// 固定表与当前目录逐行逐字段比较；不一致时在 diff 中每处差异写一行，返回 false
+bool diff_against_catalog(std::string* diff = nullptr);
+
+// 以 ReferenceTableData.cpp 的格式写出当前目录的参数（重新生成固定表用）
+std::string dump_catalog_source();
+
+} // namespace reference
+
+#endif
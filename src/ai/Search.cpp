@@ -0,0 +1,352 @@
+#include "Search.h"
+#include "Playout.h"
+#include "core/Game.h"
+#include "Determinize.h"
+#include "instrument/Profiler.h"
+#include "instrument/Tracer.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace {
+
+constexpr double kExploration = 1.4;      // UCT 探索系数
+constexpr std::size_t kMaxNodes = 1 << 21; // 单棵树节点上限（约 48 MB），满后只模拟不扩展
+
+int64_t elapsed_ms_since(std::chrono::steady_clock::time_point t) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - t).count();
+}
+
+} // namespace
+
+/**
+ * SearchTree：单个搜索线程的树与模拟用对局
+ * 节点平铺在一个 vector 中，子节点连续存放（first_child 起共 child_count 个）
+ */
+class SearchTree {
+public:
+    struct Node {
+        Move move;
+        int8_t mover = 0;          // 走出 move 的座位号；wins 从该方视角统计
+        bool expanded = false;
+        uint16_t child_count = 0;
+        int32_t first_child = -1;
+        uint32_t visits = 0;
+        double wins = 0;
+    };
+
+    explicit SearchTree(uint64_t rng_seed) : sim(std::make_unique<Game>()), rollout(RandomPolicy(rng_seed)) {
+        moves.reserve(256);
+        reset();
+    }
+
+    void set_evaluation(const EvalWeights& weights, int moves_before_eval) {
+        rollout_moves = moves_before_eval;
+        if (rollout_moves <= 0) eval.reset();
+        else if (eval) eval->set_weights(weights);
+        else eval = std::make_unique<HeuristicEval>(*sim, weights);
+    }
+
+    void reset() {
+        nodes.clear();
+        nodes.emplace_back();
+    }
+
+    // 一次迭代：采样隐藏信息 → 选择 → 扩展 → 随机模拟 → 回传
+    void iterate(const GameSnapshot& root) {
+        SWD_TRACE_SCOPE("search_iteration");
+        sample = root;
+        determinize(sample, rollout.get_policy().rng);
+        sim->load_snapshot(sample);
+        if (eval) eval->refresh();
+        path.clear();
+        int32_t current = 0;
+        path.push_back(current);
+
+        {
+            SWD_PROFILE_SCOPE(ProfilePoint::SEARCH_SELECT);
+            while (nodes[current].expanded && nodes[current].child_count > 0) {
+                const int32_t next = select_child(current);
+                // 树在别的采样下展开：本次采样中该动作不合法时就从当前节点开始模拟
+                if (!sim->apply_move(nodes[next].move)) break;
+                current = next;
+                path.push_back(current);
+            }
+        }
+
+        if (!sim->is_over() && !nodes[current].expanded && nodes.size() < kMaxNodes &&
+            (current == 0 || nodes[current].visits > 0)) {
+            SWD_PROFILE_SCOPE(ProfilePoint::SEARCH_EXPAND);
+            expand(current);
+            if (nodes[current].child_count > 0) {
+                std::uniform_int_distribution<int> pick(0, nodes[current].child_count - 1);
+                current = nodes[current].first_child + pick(rollout.get_policy().rng);
+                sim->apply_move(nodes[current].move);
+                path.push_back(current);
+            }
+        }
+
+        // 截断模拟：未到终局时以静态评估折算的 0 号座位胜率作为结果
+        double p0_wins;
+        {
+            SWD_PROFILE_SCOPE(ProfilePoint::SEARCH_ROLLOUT);
+            if (eval) {
+                const int winner = rollout.run(*sim, rollout_moves);
+                p0_wins = sim->is_over() ? (winner == 0 ? 1.0 : 0.0) : eval->win_probability(0);
+            } else {
+                const int winner = rollout.run(*sim);
+                p0_wins = winner == 0 ? 1.0 : 0.0;
+            }
+        }
+        SWD_PROFILE_SCOPE(ProfilePoint::SEARCH_BACKPROP);
+        for (int32_t idx : path) {
+            Node& n = nodes[idx];
+            n.visits++;
+            n.wins += n.mover == 0 ? p0_wins : 1.0 - p0_wins;
+        }
+    }
+
+    // 把树根移到 move 对应的子节点，保留其子树；没有对应子节点时清空
+    void reroot(const Move& move) {
+        const Node& root = nodes[0];
+        int32_t child = -1;
+        for (int i = 0; i < root.child_count; ++i) {
+            if (nodes[root.first_child + i].move == move) child = root.first_child + i;
+        }
+        if (child < 0) { reset(); return; }
+
+        // 广度优先拷贝子树，子节点保持连续
+        std::vector<Node> kept;
+        kept.reserve(nodes.size());
+        kept.push_back(nodes[child]);
+        std::vector<int32_t> source{child};
+        for (std::size_t i = 0; i < kept.size(); ++i) {
+            const Node& old = nodes[source[i]];
+            if (old.child_count == 0) continue;
+            kept[i].first_child = static_cast<int32_t>(kept.size());
+            for (int c = 0; c < old.child_count; ++c) {
+                kept.push_back(nodes[old.first_child + c]);
+                source.push_back(old.first_child + c);
+            }
+        }
+        nodes.swap(kept);
+    }
+
+    const std::vector<Node>& get_nodes() const { return nodes; }
+
+private:
+    int32_t select_child(int32_t parent) {
+        const Node& p = nodes[parent];
+        const double log_parent = std::log(static_cast<double>(p.visits) + 1.0);
+        int32_t best = p.first_child;
+        double best_score = -1.0;
+        for (int i = 0; i < p.child_count; ++i) {
+            const Node& c = nodes[p.first_child + i];
+            if (c.visits == 0) return p.first_child + i;
+            double score = c.wins / c.visits + kExploration * std::sqrt(log_parent / c.visits);
+            if (score > best_score) { best_score = score; best = p.first_child + i; }
+        }
+        return best;
+    }
+
+    void expand(int32_t idx) {
+        sim->canonical_moves(moves);   // 规范等价的动作只展开一个
+        const int8_t mover = sim->get_decision().player;
+        const int32_t first = static_cast<int32_t>(nodes.size());
+        for (const Move& m : moves) {
+            Node child;
+            child.move = m;
+            child.mover = mover;
+            nodes.push_back(child);
+        }
+        nodes[idx].first_child = first;
+        nodes[idx].child_count = static_cast<uint16_t>(moves.size());
+        nodes[idx].expanded = true;
+    }
+
+    std::vector<Node> nodes;
+    std::vector<int32_t> path;
+    std::vector<Move> moves;
+    GameSnapshot sample;                       // 本次迭代的确定化局面
+    std::unique_ptr<Game> sim;
+    Playout<RandomPolicy, NullSink> rollout;   // 随机走子模拟：策略与观察者在编译期确定
+    std::unique_ptr<HeuristicEval> eval;       // 订阅 sim 的事件；为空时模拟走到终局
+    int rollout_moves = 0;
+};
+
+// --- Searcher ---
+
+Searcher::Searcher(int threads) {
+    set_threads(threads);
+}
+
+Searcher::~Searcher() {
+    stop();
+    wait();
+}
+
+void Searcher::set_threads(int count) {
+    count = std::max(1, count);
+    if (count == (int)trees.size()) return;
+    trees.clear();
+    for (int i = 0; i < count; ++i) {
+        trees.push_back(std::make_unique<SearchTree>(0x9E3779B97F4A7C15ull * (i + 1)));
+        trees.back()->set_evaluation(eval_weights, eval_rollout_moves);
+    }
+}
+
+void Searcher::set_evaluation(const EvalWeights& weights, int rollout_moves) {
+    eval_weights = weights;
+    eval_rollout_moves = std::max(0, rollout_moves);
+    for (auto& tree : trees) {
+        tree->set_evaluation(eval_weights, eval_rollout_moves);
+        tree->reset();   // 旧统计按不同的模拟方式得出，不再沿用
+    }
+}
+
+void Searcher::set_position(const Game& game) {
+    game.save_snapshot(root_snap);
+    root_position_hash = game.position_hash();
+    for (auto& tree : trees) tree->reset();
+}
+
+bool Searcher::advance(const Move& move) {
+    Game game;
+    if (!game.load_snapshot(root_snap) || !game.apply_move(move)) return false;
+    game.save_snapshot(root_snap);
+    root_position_hash = game.position_hash();
+    for (auto& tree : trees) tree->reroot(move);
+    return true;
+}
+
+void Searcher::start(const SearchLimits& search_limits, FinishedCallback finished, ProgressCallback progress) {
+    wait();
+    limits = search_limits;
+    on_finished = std::move(finished);
+    on_progress = std::move(progress);
+    stop_flag.store(false, std::memory_order_relaxed);
+    node_count.store(0, std::memory_order_relaxed);
+    started = std::chrono::steady_clock::now();
+
+    running.store(static_cast<int>(trees.size()), std::memory_order_release);
+    for (int i = 0; i < (int)trees.size(); ++i) threads.emplace_back(&Searcher::worker, this, i);
+}
+
+void Searcher::wait() {
+    for (auto& t : threads) {
+        if (t.joinable()) t.join();
+    }
+    threads.clear();
+}
+
+void Searcher::worker(int index) {
+    SWD_TRACE_SCOPE_ARG("search_worker", index);
+    SearchTree& tree = *trees[index];
+    Game probe;
+    probe.load_snapshot(root_snap);
+    const bool playable = !probe.is_over();
+    auto last_report = std::chrono::steady_clock::now();
+
+    while (playable && !stop_flag.load(std::memory_order_relaxed)) {
+        tree.iterate(root_snap);
+        uint64_t n = node_count.fetch_add(1, std::memory_order_relaxed) + 1;
+        if (limits.nodes > 0 && n >= limits.nodes) break;
+        if (limits.movetime_ms > 0 && elapsed_ms_since(started) >= limits.movetime_ms) break;
+
+        // 进度只读本线程的树，不与其他线程竞争
+        if (index == 0 && on_progress && std::chrono::steady_clock::now() - last_report >= std::chrono::seconds(1)) {
+            last_report = std::chrono::steady_clock::now();
+            SearchResult r;
+            const auto& nodes = tree.get_nodes();
+            const auto& root = nodes[0];
+            int32_t best = -1;
+            for (int i = 0; i < root.child_count; ++i) {
+                if (best < 0 || nodes[root.first_child + i].visits > nodes[best].visits) best = root.first_child + i;
+            }
+            if (best >= 0 && nodes[best].visits > 0) {
+                r.has_move = true;
+                r.best = nodes[best].move;
+                r.win_rate = nodes[best].wins / nodes[best].visits;
+                r.pv.push_back(r.best);
+            }
+            r.nodes = node_count.load(std::memory_order_relaxed);
+            r.elapsed_ms = elapsed_ms_since(started);
+            on_progress(r);
+        }
+    }
+    // 一个线程达到限制后通知其余线程
+    stop_flag.store(true, std::memory_order_relaxed);
+
+    if (running.fetch_sub(1, std::memory_order_acq_rel) == 1 && on_finished) {
+        on_finished(collect());
+    }
+}
+
+SearchResult Searcher::result() const {
+    return collect();
+}
+
+uint64_t Searcher::root_visits() const {
+    uint64_t visits = 0;
+    for (const auto& tree : trees) visits += tree->get_nodes()[0].visits;
+    return visits;
+}
+
+SearchResult Searcher::collect() const {
+    SearchResult r;
+    r.nodes = node_count.load(std::memory_order_relaxed);
+    r.elapsed_ms = elapsed_ms_since(started);
+
+    // 按动作合并各树根节点的子节点统计
+    struct Entry { Move move; uint64_t visits = 0; double wins = 0; };
+    std::vector<Entry> merged;
+    for (const auto& tree : trees) {
+        const auto& nodes = tree->get_nodes();
+        const auto& root = nodes[0];
+        for (int i = 0; i < root.child_count; ++i) {
+            const auto& c = nodes[root.first_child + i];
+            auto it = std::find_if(merged.begin(), merged.end(), [&](const Entry& e) { return e.move == c.move; });
+            if (it == merged.end()) it = merged.insert(merged.end(), Entry{c.move});
+            it->visits += c.visits;
+            it->wins += c.wins;
+        }
+    }
+    auto best = std::max_element(merged.begin(), merged.end(),
+                                 [](const Entry& a, const Entry& b) { return a.visits < b.visits; });
+    if (best == merged.end() || best->visits == 0) return r;
+    r.has_move = true;
+    r.best = best->move;
+    r.win_rate = best->wins / best->visits;
+
+    // 主变例：取最佳动作访问次数最多的那棵树，沿访问次数最多的子节点下行
+    const SearchTree* deepest = nullptr;
+    uint32_t deepest_visits = 0;
+    int32_t start_node = -1;
+    for (const auto& tree : trees) {
+        const auto& nodes = tree->get_nodes();
+        for (int i = 0; i < nodes[0].child_count; ++i) {
+            const auto& c = nodes[nodes[0].first_child + i];
+            if (c.move == r.best && c.visits > deepest_visits) {
+                deepest = tree.get();
+                deepest_visits = c.visits;
+                start_node = nodes[0].first_child + i;
+            }
+        }
+    }
+    r.pv.push_back(r.best);
+    if (deepest) {
+        const auto& nodes = deepest->get_nodes();
+        int32_t cur = start_node;
+        while (nodes[cur].child_count > 0) {
+            int32_t next = -1;
+            for (int i = 0; i < nodes[cur].child_count; ++i) {
+                int32_t c = nodes[cur].first_child + i;
+                if (next < 0 || nodes[c].visits > nodes[next].visits) next = c;
+            }
+            if (nodes[next].visits == 0) break;
+            r.pv.push_back(nodes[next].move);
+            cur = next;
+        }
+    }
+    return r;
+}
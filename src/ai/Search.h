@@ -0,0 +1,108 @@
+#ifndef SEARCH_H
+#define SEARCH_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "core/Move.h"
+#include "ai/HeuristicEval.h"
+#include "core/Snapshot.h"
+
+class Game;
+class SearchTree;
+
+/**
+ * 搜索限制：各项为 0 表示不限；全部为 0 即无限搜索，直到 stop()
+ */
+struct SearchLimits {
+    int64_t movetime_ms = 0;
+    uint64_t nodes = 0;       // 全部线程合计的迭代（模拟）次数
+};
+
+/**
+ * 搜索结果：评估为根节点行动方的胜率（0~1）
+ */
+struct SearchResult {
+    bool has_move = false;
+    Move best;
+    double win_rate = 0.5;
+    std::vector<Move> pv;     // 主变例（首步即 best）
+    uint64_t nodes = 0;
+    int64_t elapsed_ms = 0;
+};
+
+/**
+ * Searcher 类：多线程蒙特卡洛树搜索（UCT + 随机走子模拟）
+ *
+ * - 根并行：每个线程维护自己的一棵树，结果按根节点各子动作合并
+ * - start() 在后台线程中搜索后立即返回，调用线程可以继续处理输入；
+ *   stop() 只设置停止标志，wait() 等待全部线程退出
+ * - 搜索结束（达到限制或被 stop）时，最后退出的线程调用 on_finished
+ * - 多次 start() 之间保留搜索树；advance() 把树根移到实际走出的子节点上，
+ *   已有的统计继续沿用（后台思考 / 换手时不丢弃搜索结果）
+ *
+ * 默认每次模拟随机走到终局；set_evaluation() 之后随机走 rollout_moves 步即停，
+ * 以 HeuristicEval 的静态评估折算成胜率回传（截断模拟，评估随模拟对局的事件增量更新）。
+ *
+ * 隐藏信息按确定化处理：每次迭代先对背面朝上的牌、以后各时代的牌序与盒中进步标记
+ * 重新随机采样，再在采样出的局面上选择与模拟，搜索不会用到行动方看不到的牌。
+ */
+class Searcher {
+public:
+    using FinishedCallback = std::function<void(const SearchResult&)>;
+    using ProgressCallback = std::function<void(const SearchResult&)>;
+
+    explicit Searcher(int threads = 1);
+    ~Searcher();
+    Searcher(const Searcher&) = delete;
+    Searcher& operator=(const Searcher&) = delete;
+
+    // 以下三个函数只能在未搜索时调用
+    void set_threads(int threads);
+    // rollout_moves > 0 时启用截断模拟与静态评估，0 恢复走到终局
+    void set_evaluation(const EvalWeights& weights, int rollout_moves);
+    void set_position(const Game& game);   // 重置全部搜索树
+    bool advance(const Move& move);        // 树根移到 move 之后的局面；非法动作返回 false
+
+    // 开始后台搜索；progress 约每秒由 0 号线程调用一次（可为空）
+    // 两个回调都在搜索线程中执行，不能在其中再调用 start()/wait()
+    void start(const SearchLimits& limits, FinishedCallback on_finished = nullptr,
+               ProgressCallback on_progress = nullptr);
+    void stop() { stop_flag.store(true, std::memory_order_relaxed); }
+    void wait();
+    bool is_searching() const { return running.load(std::memory_order_acquire) > 0; }
+
+    // 合并各线程的根节点统计（未搜索时调用）
+    SearchResult result() const;
+    // 树根上已累积的模拟次数（未搜索时调用），可以看出移根后沿用了多少统计
+    uint64_t root_visits() const;
+    const GameSnapshot& root() const { return root_snap; }
+    uint64_t root_hash() const { return root_position_hash; }
+    int get_threads() const { return static_cast<int>(trees.size()); }
+
+private:
+    void worker(int index);
+    SearchResult collect() const;
+
+    GameSnapshot root_snap;
+    uint64_t root_position_hash = 0;   // Game::position_hash()，供调用方核对树根是否与实际对局一致
+    std::vector<std::unique_ptr<SearchTree>> trees;
+    EvalWeights eval_weights;
+    int eval_rollout_moves = 0;
+    std::vector<std::thread> threads;
+
+    SearchLimits limits;
+    FinishedCallback on_finished;
+    ProgressCallback on_progress;
+    std::atomic<bool> stop_flag{false};
+    std::atomic<int> running{0};
+    std::atomic<uint64_t> node_count{0};
+    std::chrono::steady_clock::time_point started;
+};
+
+#endif
@@ -0,0 +1,76 @@
+#include "swd_env.h"
+#include "env/VecEnv.h"
+#include <exception>
+#include <stdexcept>
+#include <string>
+
+struct swd_env {
+    VecEnv env;
+    swd_env(int num_envs, int num_threads) : env(num_envs, num_threads) {}
+};
+
+namespace {
+
+thread_local std::string last_error;
+
+// C 接口不能让异常越过边界：统一转成负返回值
+template <typename F>
+int guarded(F&& f) {
+    try {
+        last_error.clear();
+        return f();
+    } catch (const std::exception& e) {
+        last_error = e.what();
+    } catch (...) {
+        last_error = "unknown error";
+    }
+    return -1;
+}
+
+} // namespace
+
+extern "C" {
+
+int swd_env_abi_version(void) { return SWD_ENV_ABI_VERSION; }
+int swd_env_num_actions(void) { return VecEnv::kNumActions; }
+int swd_env_obs_size(void) { return VecEnv::kObsSize; }
+
+swd_env* swd_env_create(int num_envs, int num_threads) {
+    swd_env* env = nullptr;
+    guarded([&] {
+        env = new swd_env(num_envs, num_threads);
+        return 0;
+    });
+    return env;
+}
+
+void swd_env_destroy(swd_env* env) { delete env; }
+
+int swd_env_num_envs(const swd_env* env) { return env ? env->env.size() : -1; }
+
+int swd_env_bind(swd_env* env, int8_t* obs, uint8_t* legal_mask, float* rewards, uint8_t* dones, int32_t* to_play) {
+    return guarded([&] {
+        if (!env) throw std::invalid_argument("null env");
+        env->env.bind({obs, legal_mask, rewards, dones, to_play});
+        return 0;
+    });
+}
+
+int swd_env_reset(swd_env* env, const uint64_t* seeds) {
+    return guarded([&] {
+        if (!env) throw std::invalid_argument("null env");
+        env->env.reset(seeds);
+        return 0;
+    });
+}
+
+int swd_env_step(swd_env* env, const int32_t* actions) {
+    return guarded([&] {
+        if (!env) throw std::invalid_argument("null env");
+        return env->env.step(actions);
+    });
+}
+
+const char* swd_env_last_error(void) { return last_error.c_str(); }
+
+} // extern "C"
@@ -0,0 +1,86 @@
+/*
+ * swd_env.h —— 向量化强化学习环境的 C 接口（libswd_env.so）
+ *
+ * 供 Python（ctypes / cffi）或其他宿主语言直接调用：宿主分配连续缓冲区并绑定一次，
+ * 之后每次 reset/step 的结果直接写入这些缓冲区，不经过逐局拷贝。
+ *
+ *   obs        int8   [N][swd_env_obs_size()]     每局的观测特征（见下）
+ *   legal_mask uint8  [N][swd_env_num_actions()]  合法动作为 1
+ *   rewards    float  [N]                         本步行动方的收益：赢 +1，输 -1，其余 0
+ *   dones      uint8  [N]                         本步结束了一局（该局已自动重开）
+ *   to_play    int32  [N]                         下一步做决策的座位号
+ *
+ * 观测以 to_play 一方为视角编码（env/ObservationEncoder.h），“我方”段在前、“对方”段在后，
+ * 只含该方在实体桌面上看得到的信息：不含发牌种子、背面朝上的牌的身份、盒中（未上版图）的进步标记。
+ * 各段依次为（括号内为元素个数，除注明外均为 0/1 标志）：
+ *   age[3]                     当前时代（独热）
+ *   decision[6]                待决策类型（独热，按 Decision::Type）
+ *   pending_slot[20]           CHOOSE_WONDER 决策时已选定的地基槽位（独热），其余决策全 0
+ *   slot_card[20 × 72]         金字塔各槽位正面朝上的牌的卡牌编号（独热）；已取走或背面朝上时全 0
+ *   slot_hidden[20]            槽位上是背面朝上的牌
+ *   slot_accessible[20]        槽位上的牌当前可拿
+ *   player[2] × 172：我方、对方各一段，段内依次为
+ *       coins, vp                          计数（截断到 127）
+ *       production[5]                      木/泥/石/玻璃/纸草 固定产量
+ *       wild_raw, wild_manufactured        多选一资源个数
+ *       trade_price[5]                     该方购买每种资源的单价
+ *       science[7]                         已有的科技符号
+ *       color_count[7]                     各颜色已建卡牌数
+ *       progress_tokens[10]                已得的进步标记
+ *       chain[22]                          已有的连锁符号
+ *       wonders[4] × { id[12], built }     奇迹编号（独热）与是否已建
+ *       built_cards[60]                    已建卡牌按建造顺序的卡牌编号 + 1，其后为 0
+ *   pawn[19]                   军事棋子位置（独热，已翻转：18 为我方压制）
+ *   looting[4]                 仍在版图上的掠夺标记：我方小、我方大、对方小、对方大
+ *   board_tokens[10]           版图上可取的进步标记
+ *   discard[60]                弃牌堆按弃牌顺序的卡牌编号 + 1，其后为 0
+ * 总长由 swd_env_obs_size() 给出（当前为 1946）；各段偏移与 ObservationEncoder 的常量一致。
+ *
+ * 动作编号见 core/Move.h 中的 action_space；非法动作按行动方判负并重开该局。
+ * 除 swd_env_last_error 外，返回 int 的函数以负数表示出错，错误信息由 swd_env_last_error 取得。
+ * 同一个 swd_env 不能被多个线程同时调用。
+ */
+#ifndef SWD_ENV_H
+#define SWD_ENV_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__GNUC__)
+#define SWD_API __attribute__((visibility("default")))
+#else
+#define SWD_API
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SWD_ENV_ABI_VERSION 3   /* v2：观测由快照原始字节改为 int8 特征；v3：加入地基槽位、已建卡牌与弃牌堆 */
+
+typedef struct swd_env swd_env;
+
+SWD_API int swd_env_abi_version(void);
+SWD_API int swd_env_num_actions(void);
+SWD_API int swd_env_obs_size(void);
+
+/* num_threads 为工作线程数（含调用线程）；失败返回 NULL */
+SWD_API swd_env* swd_env_create(int num_envs, int num_threads);
+SWD_API void swd_env_destroy(swd_env* env);
+SWD_API int swd_env_num_envs(const swd_env* env);
+
+SWD_API int swd_env_bind(swd_env* env, int8_t* obs, uint8_t* legal_mask, float* rewards,
+                         uint8_t* dones, int32_t* to_play);
+/* seeds 为 NULL 时各局沿用自己的下一个种子（初始为 0..N-1） */
+SWD_API int swd_env_reset(swd_env* env, const uint64_t* seeds);
+/* 返回本步非法动作的个数（>= 0） */
+SWD_API int swd_env_step(swd_env* env, const int32_t* actions);
+
+/* 调用线程上最近一次错误的描述；没有错误时为空串 */
+SWD_API const char* swd_env_last_error(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
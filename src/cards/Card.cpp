@@ -1,6 +1,8 @@
 #include "Card.h"
 #include "player/Player.h"
 #include "core/Game.h"
+#include "instrument/AllocTracker.h"
+#include "instrument/Profiler.h"
 #include <algorithm>
 
 Card::Card(std::string n, int a, Color c) 
@@ -14,6 +16,8 @@ bool Card::can_be_free(const Player& p) const {
 }
 
 void Card::apply_effect(Player& p, Game& g) const {
+    SWD_ALLOC_PHASE(AllocPhase::EFFECT);
+    SWD_PROFILE_SCOPE(ProfilePoint::APPLY_EFFECT);
     // 1. 基础数值
     if (victory_points > 0) p.add_victory_points(victory_points);
     if (shields > 0) g.move_pawn(shields);
@@ -209,5 +213,28 @@ std::vector<std::unique_ptr<Card>> createAllCards() {
     // 补全剩余公会 (Shipowners, Moneylenders, Magistrates)
     for(int i=0; i<3; ++i) cards.push_back(std::make_unique<Card>("Other Guild", 3, Color::PURPLE));
 
+    for (int i = 0; i < (int)cards.size(); ++i) cards[i]->id = i;
     return cards;
+}
+
+const std::vector<std::unique_ptr<Card>>& card_catalog() {
+    // 目录是全局只读的，必须从全局堆构建，不能落入某局的 arena
+    static const std::vector<std::unique_ptr<Card>> catalog = [] {
+        GameArena::Scope heap(nullptr);
+        return createAllCards();
+    }();
+    return catalog;
+}
+
+std::unique_ptr<Card> clone_card(int id) {
+    const auto& catalog = card_catalog();
+    if (id < 0 || id >= (int)catalog.size()) return nullptr;
+    return std::make_unique<Card>(*catalog[id]);
+}
+
+int find_card_id(std::string_view name) {
+    for (const auto& c : card_catalog()) {
+        if (c->name == name) return c->id;
+    }
+    return -1;
 }
\ No newline at end of file
@@ -2,7 +2,9 @@
 #define CARD_H
 
 #include "Types.h"
+#include "core/GameArena.h"
 #include <string>
+#include <string_view>
 #include <vector>
 #include <map>
 #include <functional>
@@ -11,7 +13,8 @@
 class Player;
 class Game;
 
-class Card {
+// 卡牌对象从当前对局的 GameArena 分配（见 ArenaAllocated）
+class Card : public ArenaAllocated {
 public:
     using CardEffect = std::function<void(Player&, Game&)>;
 
@@ -30,6 +33,7 @@ public:
     };
 
     // --- 基础属性 ---
+    int id = -1;              // 在 createAllCards() 目录中的下标，用于快照与克隆
     std::string name;
     int age;
     Color color;
@@ -56,4 +60,13 @@ public:
 
 std::vector<std::unique_ptr<Card>> createAllCards();
 
+// 全局只读卡牌目录：首次调用时创建一次，下标即 Card::id
+const std::vector<std::unique_ptr<Card>>& card_catalog();
+
+// 按目录下标复制一张卡牌（用于发牌与快照恢复），下标非法时返回 nullptr
+std::unique_ptr<Card> clone_card(int id);
+
+// 按名称查找目录下标（同名卡返回第一张），找不到时返回 -1
+int find_card_id(std::string_view name);
+
 #endif
\ No newline at end of file
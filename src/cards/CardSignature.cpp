@@ -0,0 +1,91 @@
+#include "CardSignature.h"
+#include "Card.h"
+#include "core/Game.h"
+#include "player/Player.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory_resource>
+#include <stdexcept>
+
+namespace {
+
+CardSignature extract(const Card& card, Game& scratch_game) {
+    CardSignature s{};
+    s.color = static_cast<int8_t>(card.color);
+    s.chain = card.link_prerequisite == LinkSymbol::NONE ? -1 : static_cast<int8_t>(card.link_prerequisite);
+    s.link = card.link_provides == LinkSymbol::NONE ? -1 : static_cast<int8_t>(card.link_provides);
+    s.victory_points = static_cast<int8_t>(card.victory_points);
+    s.shields = static_cast<int8_t>(card.shields);
+    const bool is_science = card.science_symbol >= Resource::COMPASS && card.science_symbol <= Resource::LAW;
+    s.science = is_science ? static_cast<int8_t>(card.science_symbol) : -1;
+    for (auto const& [res, amount] : card.cost) {
+        if (res == Resource::COIN) s.coin_cost = static_cast<int8_t>(amount);
+        else if ((int)res < CardSignature::kTradable) s.need[(int)res] = static_cast<int8_t>(amount);
+        else throw std::logic_error("CardSignature: non-tradable resource in card cost: " + card.name);
+    }
+    const auto& reward = card.special_reward;
+    if (reward.active) {
+        s.reward_active = 1;
+        s.reward_color = static_cast<int8_t>(reward.target_color);
+        s.reward_coins = static_cast<int8_t>(reward.coins_per_card);
+        s.reward_vp = static_cast<int8_t>(reward.vp_per_card);
+        s.reward_wonders = reward.count_wonders ? 1 : 0;
+        s.reward_both = reward.count_both ? 1 : 0;
+    }
+    if (!card.immediate_func) return s;
+
+    // 即时效果：在空白玩家上执行一次，读出实际改动
+    alignas(std::max_align_t) char scratch[2048];
+    std::pmr::monotonic_buffer_resource memory(scratch, sizeof(scratch));
+    Player probe("probe", PlayerType::HUMAN, &memory);
+    const int coins_before = probe.get_coins();
+    card.immediate_func(probe, scratch_game);
+    for (int r = 0; r < CardSignature::kTradable; ++r) {
+        s.produce[r] = static_cast<int8_t>(probe.get_resource(static_cast<Resource>(r)));
+        if (probe.get_trade_cost(static_cast<Resource>(r)) == 1) s.fixed_mask |= static_cast<uint8_t>(1u << r);
+    }
+    s.coin_gain = static_cast<int8_t>(probe.get_coins() - coins_before);
+    for (const auto& options : probe.get_wildcard_resources()) {
+        if (s.choice_count == CardSignature::kMaxChoices) {
+            throw std::logic_error("CardSignature: too many resource choices on " + card.name);
+        }
+        uint16_t bits = 0;
+        for (Resource r : options) bits |= static_cast<uint16_t>(1u << (int)r);
+        s.choices[s.choice_count++] = bits;
+    }
+    std::sort(s.choices, s.choices + s.choice_count);
+    return s;
+}
+
+} // namespace
+
+bool operator==(const CardSignature& a, const CardSignature& b) {
+    return std::memcmp(&a, &b, sizeof(CardSignature)) == 0;
+}
+
+const std::vector<CardSignature>& card_signatures() {
+    static const std::vector<CardSignature> signatures = [] {
+        GameArena::Scope heap(nullptr);
+        Game scratch;
+        std::vector<CardSignature> out;
+        for (const auto& card : card_catalog()) out.push_back(extract(*card, scratch));
+        return out;
+    }();
+    return signatures;
+}
+
+int card_class(int card_id) {
+    static const std::vector<int> classes = [] {
+        const auto& sigs = card_signatures();
+        std::vector<int> out(sigs.size());
+        for (int i = 0; i < (int)sigs.size(); ++i) {
+            out[i] = i;
+            for (int j = 0; j < i; ++j) {
+                if (sigs[j] == sigs[i]) { out[i] = out[j]; break; }
+            }
+        }
+        return out;
+    }();
+    return card_id >= 0 && card_id < (int)classes.size() ? classes[card_id] : -1;
+}
@@ -0,0 +1,55 @@
+#ifndef CARD_SIGNATURE_H
+#define CARD_SIGNATURE_H
+
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+/**
+ * CardSignature：一张卡牌的完整规则签名
+ *
+ * 费用、颜色、胜利分、盾牌、科技符号、连锁（前置与提供）、特殊奖励，以及即时效果的实际作用
+ * （在空白玩家上执行一次后读出的产出、金币、固定交易价与多选一资源）。
+ * 名称与所属时代不参与：时代只决定发到哪一副牌里，发牌之后不再影响规则。
+ * 签名相同的两张卡牌在任何局面下都可以互换，目录里的占位卡（Age2_Fill_Card 等）因此归为一类。
+ *
+ * 定长、无填充字节，可以直接按字节比较与哈希。
+ */
+struct CardSignature {
+    static constexpr int kTradable = 5;     // WOOD..PAPYRUS
+    static constexpr int kMaxChoices = 4;
+
+    uint16_t choices[kMaxChoices];   // 多选一资源，按 Resource 取位，升序，不足补 0
+    int8_t color;
+    int8_t coin_cost;
+    int8_t need[kTradable];          // 费用中的各资源数量
+    int8_t chain;                    // 连锁前置 LinkSymbol，无为 -1
+    int8_t link;                     // 提供的 LinkSymbol，无为 -1
+    int8_t victory_points;
+    int8_t shields;
+    int8_t science;                  // 科技符号 Resource，无为 -1
+    int8_t produce[kTradable];
+    int8_t coin_gain;
+    uint8_t fixed_mask;              // 交易价固定为 1 的资源位集
+    uint8_t choice_count;
+    int8_t reward_active;
+    int8_t reward_color;
+    int8_t reward_coins;
+    int8_t reward_vp;
+    int8_t reward_wonders;
+    int8_t reward_both;
+};
+
+static_assert(std::has_unique_object_representations_v<CardSignature>,
+              "CardSignature is compared and hashed bytewise and must not contain padding");
+
+bool operator==(const CardSignature& a, const CardSignature& b);
+inline bool operator!=(const CardSignature& a, const CardSignature& b) { return !(a == b); }
+
+// 目录中每张卡牌的签名（下标即 Card::id），首次调用时提取一次
+const std::vector<CardSignature>& card_signatures();
+
+// 等价类编号：签名相同的卡牌共用该类中最小的目录下标；下标非法时返回 -1
+int card_class(int card_id);
+
+#endif
@@ -1,13 +1,24 @@
 #include "CardStructure.h"
+#include "CardSignature.h"
+#include "core/PositionHash.h"
+#include "core/Rules.h"
+#include "core/Snapshot.h"
+#include "instrument/AllocTracker.h"
+#include "instrument/Profiler.h"
+#include <array>
 #include <stdexcept>
 #include <algorithm>
 
 CardStructure::CardStructure(int age, std::vector<std::unique_ptr<Card>> deck) 
-    : current_age(age), cards(std::move(deck)) {
+    : cards(std::move(deck)),
+      unlocks(GameArena::current_resource()),
+      dependency_count(GameArena::current_resource()),
+      accessible(GameArena::current_resource()),
+      current_age(age) {
     
     // 规则校验：对决版每时代使用 20 张牌（时代 III 包含 3 张公会卡共 23 张槽位）
     // 为了逻辑统一，此处按您之前要求的 20 张逻辑进行布局
-    if (cards.size() != 20) {
+    if ((int)cards.size() != rules::kPyramidSlots) {
         throw std::runtime_error("CardStructure Error: Deck must contain exactly 20 cards.");
     }
 
@@ -43,7 +54,8 @@ void CardStructure::setup_dependencies_and_faces(int age) {
         add_dependency(15, 18); add_dependency(16, 18); add_dependency(16, 19); add_dependency(17, 19);
 
         // 初始可见性: L1, L3, L5 翻开; L2, L4 盖住
-        for (int i = 0; i < 20; ++i) {
+        for (int i = 0; i < rules::kPyramidSlots; ++i) {
+            if (!cards[i]) continue;
             if (i <= 5) cards[i]->is_face_up = true;        // L1
             else if (i <= 10) cards[i]->is_face_up = false; // L2
             else if (i <= 14) cards[i]->is_face_up = true;  // L3
@@ -62,7 +74,8 @@ void CardStructure::setup_dependencies_and_faces(int age) {
         add_dependency(9, 14); add_dependency(10, 14); add_dependency(10, 15); add_dependency(11, 15); add_dependency(11, 16); add_dependency(11, 17); add_dependency(12, 17); add_dependency(12, 18); add_dependency(13, 18); add_dependency(13, 19);
 
         // 初始可见性: 倒金字塔规则相反
-        for (int i = 0; i < 20; ++i) {
+        for (int i = 0; i < rules::kPyramidSlots; ++i) {
+            if (!cards[i]) continue;
             if (i <= 1) cards[i]->is_face_up = true;
             else if (i <= 4) cards[i]->is_face_up = false;
             else if (i <= 8) cards[i]->is_face_up = true;
@@ -82,7 +95,8 @@ void CardStructure::setup_dependencies_and_faces(int age) {
         add_dependency(13, 16); add_dependency(13, 17); add_dependency(14, 17); 
         add_dependency(15, 18); add_dependency(16, 18); add_dependency(16, 19); add_dependency(17, 19); 
 
-        for (int i = 0; i < 20; ++i) {
+        for (int i = 0; i < rules::kPyramidSlots; ++i) {
+            if (!cards[i]) continue;
             if (i <= 1) cards[i]->is_face_up = true;
             else if (i <= 4) cards[i]->is_face_up = false;
             else if (i <= 8) cards[i]->is_face_up = true;
@@ -95,6 +109,8 @@ void CardStructure::setup_dependencies_and_faces(int age) {
 }
 
 std::unique_ptr<Card> CardStructure::take_card(int pos) {
+    SWD_ALLOC_PHASE(AllocPhase::TAKE_CARD);
+    SWD_PROFILE_SCOPE(ProfilePoint::TAKE_CARD);
     // 1. 验证是否可拿取
     if (accessible.find(pos) == accessible.end()) {
         throw std::runtime_error("Logic Error: Card at position " + std::to_string(pos) + " is blocked!");
@@ -126,6 +142,18 @@ std::vector<int> CardStructure::get_accessible() const {
     return std::vector<int>(accessible.begin(), accessible.end());
 }
 
+void CardStructure::collect_accessible(std::vector<int>& out) const {
+    out.assign(accessible.begin(), accessible.end());
+}
+
+uint32_t CardStructure::blockers_mask(int pos) const {
+    uint32_t mask = 0;
+    for (auto const& [supporter, targets] : unlocks) {
+        if (std::find(targets.begin(), targets.end(), pos) != targets.end()) mask |= 1u << supporter;
+    }
+    return mask;
+}
+
 bool CardStructure::is_empty() const {
     return accessible.empty();
 }
@@ -133,4 +161,122 @@ bool CardStructure::is_empty() const {
 const Card* CardStructure::get_card(int pos) const {
     if (pos < 0 || pos >= (int)cards.size()) return nullptr;
     return cards[pos].get();
-}
\ No newline at end of file
+}
+
+void CardStructure::save_state(GameSnapshot& snap) const {
+    snap.structure_age = static_cast<uint8_t>(current_age);
+    snap.face_up_mask = 0;
+    for (int i = 0; i < GameSnapshot::kSlots; ++i) {
+        const Card* c = (i < (int)cards.size()) ? cards[i].get() : nullptr;
+        snap.slots[i] = c ? static_cast<uint8_t>(c->id) : GameSnapshot::kEmpty;
+        if (c && c->is_face_up) snap.face_up_mask |= (1u << i);
+    }
+}
+
+uint64_t CardStructure::hash_state(uint64_t h) const {
+    h = hash_mix(h, current_age);
+    for (int i = 0; i < (int)cards.size(); ++i) {
+        const Card* c = cards[i].get();
+        h = hash_mix(h, c ? (static_cast<uint64_t>(c->id) << 1 | (c->is_face_up ? 1 : 0)) : 0xFFFF);
+    }
+    return h;
+}
+
+int CardStructure::mirror_slot(int age, int pos) {
+    // 候选镜像：各时代每一行的首尾槽位（与 setup_dependencies_and_faces 中的层级一致），
+    // 首次使用时按实际依赖关系核对，不对称的时代不做镜像
+    static const auto table = [] {
+        static constexpr int kRows[rules::kAges][8][2] = {
+            {{0, 5}, {6, 10}, {11, 14}, {15, 17}, {18, 19}},
+            {{0, 1}, {2, 4}, {5, 8}, {9, 13}, {14, 19}},
+            {{0, 1}, {2, 4}, {5, 8}, {9, 10}, {11, 14}, {15, 17}, {18, 19}},
+        };
+        std::array<std::array<int, rules::kPyramidSlots>, rules::kAges> mirror{};
+        GameArena::Scope heap(nullptr);
+        for (int a = 0; a < rules::kAges; ++a) {
+            for (int p = 0; p < rules::kPyramidSlots; ++p) {
+                mirror[a][p] = p;
+                for (const auto& row : kRows[a]) {
+                    if (row[1] > 0 && p >= row[0] && p <= row[1]) mirror[a][p] = row[0] + row[1] - p;
+                }
+            }
+            CardStructure layout(a + 1, std::vector<std::unique_ptr<Card>>(rules::kPyramidSlots));
+            bool symmetric = true;
+            for (int p = 0; p < rules::kPyramidSlots; ++p) {
+                uint32_t mirrored_blockers = 0;
+                const uint32_t blockers = layout.blockers_mask(p);
+                for (int q = 0; q < rules::kPyramidSlots; ++q) {
+                    if ((blockers >> q) & 1u) mirrored_blockers |= 1u << mirror[a][q];
+                }
+                symmetric = symmetric && layout.blockers_mask(mirror[a][p]) == mirrored_blockers;
+            }
+            if (!symmetric) {
+                for (int p = 0; p < rules::kPyramidSlots; ++p) mirror[a][p] = p;
+            }
+        }
+        return mirror;
+    }();
+    if (age < 1 || age > rules::kAges || pos < 0 || pos >= rules::kPyramidSlots) return pos;
+    return table[age - 1][pos];
+}
+
+uint64_t CardStructure::visible_key() const {
+    uint64_t h = hash_mix(0, current_age);
+    for (int i = 0; i < rules::kPyramidSlots; ++i) {
+        const Card* c = i < (int)cards.size() ? cards[i].get() : nullptr;
+        if (!c) h = hash_mix(h, 0);
+        else h = hash_mix(h, c->is_face_up ? static_cast<uint64_t>(card_class(c->id) + 1) << 1 | 1 : 2);
+    }
+    return h;
+}
+
+uint64_t CardStructure::canonical_key(int without, bool* mirrored) const {
+    // 每个槽位的规范值：空槽 0，否则 (等价类 + 1) << 1 | 翻面
+    uint64_t value[rules::kPyramidSlots];
+    for (int i = 0; i < rules::kPyramidSlots; ++i) {
+        const Card* c = i < (int)cards.size() ? cards[i].get() : nullptr;
+        value[i] = (c && i != without) ? (static_cast<uint64_t>(card_class(c->id) + 1) << 1 | (c->is_face_up ? 1 : 0)) : 0;
+    }
+    if (without >= 0) {
+        auto it = unlocks.find(without);
+        if (it != unlocks.end()) {
+            for (int target : it->second) {
+                auto dep = dependency_count.find(target);
+                if (dep != dependency_count.end() && dep->second == 1 && value[target] != 0) value[target] |= 1;
+            }
+        }
+    }
+
+    uint64_t direct = hash_mix(0, current_age);
+    uint64_t mirror = direct;
+    for (int i = 0; i < rules::kPyramidSlots; ++i) {
+        direct = hash_mix(direct, value[i]);
+        mirror = hash_mix(mirror, value[mirror_slot(current_age, i)]);
+    }
+    if (mirrored) *mirrored = mirror < direct;
+    return std::min(direct, mirror);
+}
+
+std::unique_ptr<CardStructure> CardStructure::from_snapshot(const GameSnapshot& snap) {
+    std::vector<std::unique_ptr<Card>> slots(GameSnapshot::kSlots);
+    for (int i = 0; i < GameSnapshot::kSlots; ++i) {
+        if (snap.slots[i] != GameSnapshot::kEmpty) slots[i] = clone_card(snap.slots[i]);
+    }
+    auto structure = std::make_unique<CardStructure>(snap.structure_age, std::move(slots));
+
+    // 已取走的槽位不再支撑上方卡牌
+    for (int i = 0; i < GameSnapshot::kSlots; ++i) {
+        if (structure->cards[i]) continue;
+        auto it = structure->unlocks.find(i);
+        if (it == structure->unlocks.end()) continue;
+        for (int target : it->second) structure->dependency_count[target]--;
+    }
+    structure->accessible.clear();
+    for (int i = 0; i < GameSnapshot::kSlots; ++i) {
+        Card* c = structure->cards[i].get();
+        if (!c) continue;
+        if (structure->dependency_count[i] == 0) structure->accessible.insert(i);
+        c->is_face_up = (snap.face_up_mask >> i) & 1u;
+    }
+    return structure;
+}
@@ -6,13 +6,17 @@
 #include <map>
 #include <set>
 #include <memory>
+#include <memory_resource>
 
-class CardStructure {
+struct GameSnapshot;
+
+// 金字塔及其内部容器均从当前对局的 GameArena 分配
+class CardStructure : public ArenaAllocated {
 private:
     std::vector<std::unique_ptr<Card>> cards;
-    std::map<int, std::vector<int>> unlocks;
-    std::map<int, int> dependency_count;
-    std::set<int> accessible;
+    std::pmr::map<int, std::pmr::vector<int>> unlocks;
+    std::pmr::map<int, int> dependency_count;
+    std::pmr::set<int> accessible;
     int current_age;
 
     // --- 重点修改：确保函数名与 .cpp 一致 ---
@@ -22,10 +26,32 @@ private:
 public:
     CardStructure(int age, std::vector<std::unique_ptr<Card>> deck);
     std::vector<int> get_accessible() const;
+    // 复用调用方缓冲区的版本，稳态下不分配内存
+    void collect_accessible(std::vector<int>& out) const;
+    bool is_accessible(int pos) const { return accessible.count(pos) > 0; }
     std::unique_ptr<Card> take_card(int pos);
     bool is_empty() const;
     const Card* get_card(int pos) const; 
     int get_age() const { return current_age; }
+    // 压住 pos 的槽位位集：这些槽位全部取走后 pos 才可拿取（供位集形式的模拟器建表）
+    uint32_t blockers_mask(int pos) const;
+
+    // --- 快照 ---
+    void save_state(GameSnapshot& snap) const;
+    // 把金字塔内容与翻面状态混入局面哈希（见 core/PositionHash.h）
+    uint64_t hash_state(uint64_t h) const;
+
+    // --- 规范化（见 cards/CardSignature.h）---
+    // 左右镜像槽位：同一行内对称的两个槽位互为镜像；依赖关系不左右对称的时代（时代 II）返回 pos 本身
+    static int mirror_slot(int age, int pos);
+    // 规范化的金字塔键：各槽位按卡牌等价类与翻面状态混合，取原布局与镜像布局中较小的一个；
+    // without >= 0 时按取走该槽位之后的金字塔计算（与 take_card 相同地翻开新露出的牌）。
+    // mirrored 非空时写出是否取了镜像布局
+    uint64_t canonical_key(int without = -1, bool* mirrored = nullptr) const;
+    // 可见的金字塔键：正面朝上的牌按等价类计，背面朝上的牌只记“有牌”；不取镜像（槽位编号保持不变）
+    uint64_t visible_key() const;
+    // 按快照中的槽位与翻面状态重建金字塔（依赖计数与可拿取集合由布局重新推导）
+    static std::unique_ptr<CardStructure> from_snapshot(const GameSnapshot& snap);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,93 @@
+#include "PyramidTempo.h"
+#include "CardStructure.h"
+#include "Wonder.h"
+#include "core/Game.h"
+#include "core/Snapshot.h"
+#include "player/Player.h"
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+PyramidTempo::PyramidTempo(int a) : age(a) {
+    if (age < 1 || age > rules::kAges) throw std::logic_error("PyramidTempo: invalid age " + std::to_string(age));
+    GameArena::Scope heap(nullptr);
+    CardStructure layout(age, std::vector<std::unique_ptr<Card>>(rules::kPyramidSlots));
+    for (int p = 0; p < rules::kPyramidSlots; ++p) blockers[p] = layout.blockers_mask(p);
+}
+
+uint32_t PyramidTempo::accessible(uint32_t present) const {
+    uint32_t out = 0;
+    for (uint32_t m = present; m; m &= m - 1) {
+        const int p = __builtin_ctz(m);
+        if ((blockers[p] & present) == 0) out |= 1u << p;
+    }
+    return out;
+}
+
+uint32_t PyramidTempo::mover_forces(uint32_t present, int mover_extra, int other_extra) {
+    const auto clamp = [](int n) { return n < 0 ? 0 : (n > kMaxExtraTurns ? kMaxExtraTurns : n); };
+    return solve(present & ((1u << rules::kPyramidSlots) - 1), clamp(mover_extra), clamp(other_extra));
+}
+
+uint32_t PyramidTempo::solve(uint32_t present, int mover_extra, int other_extra) {
+    if (present == 0) return 0;
+    const uint32_t key = present | static_cast<uint32_t>(mover_extra) << 20 | static_cast<uint32_t>(other_extra) << 24;
+    auto it = cache.find(key);
+    if (it != cache.end()) return it->second;
+
+    uint32_t forced = 0;
+    for (uint32_t m = accessible(present); m; m &= m - 1) {
+        const uint32_t taken = m & (~m + 1);
+        const uint32_t next = present & ~taken;
+        // 交给对方：对方保证不了的槽位都归我
+        forced |= taken | (next & ~solve(next, other_extra, mover_extra));
+        // 以奇迹地基拿牌并再走一回合
+        if (mover_extra > 0) forced |= solve(next, mover_extra - 1, other_extra);
+        if (forced == present) break;   // 已经全部能保证
+    }
+    cache.emplace(key, forced);
+    return forced;
+}
+
+PyramidTempo::Report PyramidTempo::analyze(const Game& game) {
+    if (game.get_current_age() != age) throw std::logic_error("PyramidTempo: analysing a pyramid of another age");
+    const CardStructure& structure = game.get_structure();
+    Report r;
+    r.mover = game.get_decision().player;
+    for (int p = 0; p < rules::kPyramidSlots; ++p) {
+        if (structure.get_card(p)) r.present |= 1u << p;
+    }
+    r.accessible = accessible(r.present);
+
+    int extra[2] = {0, 0};
+    for (int seat = 0; seat < 2; ++seat) {
+        const Player& player = game.get_player(seat);
+        for (int w = 0; w < player.get_wonder_count(); ++w) {
+            const Wonder& wonder = player.get_wonder(w);
+            if (!wonder.is_built && wonder_grants_extra_turn(wonder.id)) extra[seat]++;
+        }
+    }
+    r.mover_forces = mover_forces(r.present, extra[r.mover], extra[1 - r.mover]);
+    r.other_forces = r.present & ~r.mover_forces;
+    return r;
+}
+
+bool PyramidTempo::wonder_grants_extra_turn(int wonder_id) {
+    static const std::vector<bool> grants = [] {
+        const auto& catalog = wonder_catalog();
+        std::vector<bool> out(catalog.size(), false);
+        for (const Wonder& w : catalog) {
+            if (!w.effect) continue;
+            Game game;
+            game.init(1);
+            Player& self = *game.get_current_player();
+            Player& opp = *game.get_opponent();
+            w.effect(self, opp, game);
+            GameSnapshot after;
+            game.save_snapshot(after);
+            out[w.id] = after.extra_turn != 0;
+        }
+        return out;
+    }();
+    return wonder_id >= 0 && wonder_id < (int)grants.size() && grants[wonder_id];
+}
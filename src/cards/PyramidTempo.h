@@ -0,0 +1,65 @@
+#ifndef PYRAMID_TEMPO_H
+#define PYRAMID_TEMPO_H
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include "core/Rules.h"
+
+class Game;
+
+/**
+ * PyramidTempo 类：金字塔拿牌节奏分析（只看布局，不看牌面）
+ *
+ * 把一个时代剩下的拿牌过程抽象成双方轮流从可拿取槽位中取走一张的游戏：
+ * 状态是剩余槽位位集（加上双方还能使用的额外回合次数），每个槽位最终恰好被一方拿走，
+ * 因此对每个槽位，要么轮到的一方能保证自己拿到，要么对方能保证——二者必居其一。
+ *
+ *   forced(mask) = ∪_{a 可拿取} ( {a} ∪ (mask' \ forced_对方(mask')) ∪ forced_自己再走(mask') )
+ *
+ * 其中 mask' = mask \ {a}；后一项只在还有额外回合时出现（以奇迹地基拿牌并立即再走一回合）。
+ * 按剩余位集记忆化（位集 DP），同一实例上的重复查询直接命中缓存；某个槽位集合一旦全部
+ * 能保证即停止枚举，整座金字塔求解只访问几百到两千个状态（亚毫秒），之后的查询多为查表。
+ *
+ * 额外回合按"能用就能用"的上界计：不检查奇迹是否负担得起。
+ */
+class PyramidTempo {
+public:
+    // 每方额外回合次数的上限（与每方奇迹数一致）
+    static constexpr int kMaxExtraTurns = rules::kWondersPerPlayer;
+
+    explicit PyramidTempo(int age);
+
+    int get_age() const { return age; }
+
+    // 轮到的一方能保证自己拿到的槽位位集；另一方能保证的是 present & ~结果
+    uint32_t mover_forces(uint32_t present, int mover_extra_turns = 0, int other_extra_turns = 0);
+
+    struct Report {
+        int mover = 0;              // 轮到的座位号
+        uint32_t present = 0;       // 剩余槽位
+        uint32_t accessible = 0;    // 当前可拿取
+        uint32_t mover_forces = 0;  // 轮到的一方能保证拿到（即对对方的封锁）
+        uint32_t other_forces = 0;  // 对方能保证拿到
+    };
+    // 对 game 当前金字塔做分析；双方额外回合次数取各自尚未建造、效果带额外回合的奇迹数。
+    // game 的时代须与本实例一致，否则抛出 std::logic_error
+    Report analyze(const Game& game);
+
+    // 空位集下可拿取的槽位
+    uint32_t accessible(uint32_t present) const;
+    std::size_t cache_size() const { return cache.size(); }
+    void clear_cache() { cache.clear(); }
+
+    // 奇迹效果是否给予额外回合（首次调用时在模拟对局上逐个执行奇迹效果得出）
+    static bool wonder_grants_extra_turn(int wonder_id);
+
+private:
+    uint32_t solve(uint32_t present, int mover_extra, int other_extra);
+
+    int age;
+    uint32_t blockers[rules::kPyramidSlots] = {};
+    std::unordered_map<uint32_t, uint32_t> cache;   // 键：present | mover_extra << 20 | other_extra << 24
+};
+
+#endif
@@ -24,7 +24,7 @@ std::vector<Wonder> createAllWonders() {
     // 规则：拆掉对手一张灰卡，1盾，3分
     auto circus = Wonder("Circus Maximus", {{Resource::STONE, 2}, {Resource::GLASS, 1}},
         [](Player& s, Player& o, Game& g) { 
-            o.destroy_card_by_color(Color::GREY); 
+            g.trigger_card_destruction(o, Color::GREY); 
         });
     circus.victory_points = 3;
     circus.shields = 1;
@@ -103,7 +103,7 @@ std::vector<Wonder> createAllWonders() {
     // 规则：拆掉对手一张棕卡，1盾，3分
     auto zeus = Wonder("The Statue of Zeus", {{Resource::CLAY, 1}, {Resource::STONE, 1}, {Resource::PAPYRUS, 2}},
         [](Player& s, Player& o, Game& g) { 
-            o.destroy_card_by_color(Color::BROWN); 
+            g.trigger_card_destruction(o, Color::BROWN); 
         });
     zeus.victory_points = 3;
     zeus.shields = 1;
@@ -119,5 +119,11 @@ std::vector<Wonder> createAllWonders() {
     artemis.victory_points = 0; 
     wonders.push_back(artemis);
 
+    for (int i = 0; i < (int)wonders.size(); ++i) wonders[i].id = i;
     return wonders;
+}
+
+const std::vector<Wonder>& wonder_catalog() {
+    static const std::vector<Wonder> catalog = createAllWonders();
+    return catalog;
 }
\ No newline at end of file
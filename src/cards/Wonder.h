@@ -16,6 +16,7 @@ public:
     // 定义奇迹特殊效果的 Lambda 类型：(自己, 对手, 游戏实例)
     using WonderEffect = std::function<void(Player& self, Player& opponent, Game& game)>;
 
+    int id = -1;              // 在 createAllWonders() 目录中的下标
     std::string name;
     std::map<Resource, int> cost;
     
@@ -23,6 +24,7 @@ public:
     int victory_points = 0;
     int shields = 0;
     bool is_built = false;
+    int foundation = -1;      // 压在下面的地基牌（卡牌目录下标）；建成前为 -1
 
     // 存储特殊逻辑 (如“再来一回合”、“拆牌”、“选择进展标记”)
     WonderEffect effect;
@@ -33,4 +35,7 @@ public:
 // 工厂函数：创建对决版全部 12 张奇迹卡
 std::vector<Wonder> createAllWonders();
 
+// 全局只读奇迹目录：下标即 Wonder::id
+const std::vector<Wonder>& wonder_catalog();
+
 #endif
\ No newline at end of file
@@ -1,49 +1,41 @@
 #include "Board.h"
 #include "../player/Player.h"
+#include "Snapshot.h"
+#include "GameEvents.h"
+#include "PositionHash.h"
+#include "Rules.h"
 #include <algorithm>
 
-Board::Board() : pawn_position(9) {
+Board::Board() : pawn_position(rules::kPawnStart) {
     for(int i = 0; i < 4; ++i) military_tokens_active[i] = true;
 }
 
 bool Board::move_pawn(int amount, Player& p1, Player& p2) {
+    int from = pawn_position;
     pawn_position += amount;
     
     // 边界限制
-    if (pawn_position < 0) pawn_position = 0;
-    if (pawn_position > 18) pawn_position = 18;
+    if (pawn_position < rules::kPawnMin) pawn_position = rules::kPawnMin;
+    if (pawn_position > rules::kPawnMax) pawn_position = rules::kPawnMax;
+    if (events) events->publish(PawnMoved{from, pawn_position});
 
     // --- 军事惩罚逻辑 (Looting Tokens) ---
 
-    // 棋子向 P1 侧移动 (amount < 0)，检查 P1 侧标记
-    if (amount < 0) {
-        if (pawn_position <= 6 && military_tokens_active[0]) {
-            p1.add_coins(-2); 
-            military_tokens_active[0] = false;
-            std::cout << "[Board] " << p1.get_name() << " lost 2 coins (Military Penalty)!\n";
-        }
-        if (pawn_position <= 3 && military_tokens_active[1]) {
-            p1.add_coins(-5); 
-            military_tokens_active[1] = false;
-            std::cout << "[Board] " << p1.get_name() << " lost 5 coins (Military Penalty)!\n";
-        }
-    } 
-    // 棋子向 P2 侧移动 (amount > 0)，检查 P2 侧标记
-    else if (amount > 0) {
-        if (pawn_position >= 12 && military_tokens_active[2]) {
-            p2.add_coins(-2); 
-            military_tokens_active[2] = false;
-            std::cout << "[Board] " << p2.get_name() << " lost 2 coins (Military Penalty)!\n";
-        }
-        if (pawn_position >= 15 && military_tokens_active[3]) {
-            p2.add_coins(-5); 
-            military_tokens_active[3] = false;
-            std::cout << "[Board] " << p2.get_name() << " lost 5 coins (Military Penalty)!\n";
-        }
+    // 棋子向 P1 侧移动 (amount < 0) 只检查 P1 侧标记，反之只检查 P2 侧
+    Player* victims[2] = {&p1, &p2};
+    for (int i = 0; i < 4; ++i) {
+        const rules::LootingToken& token = rules::kLootingTokens[i];
+        if (!military_tokens_active[i]) continue;
+        const bool reached = token.victim == 0 ? (amount < 0 && pawn_position <= token.threshold)
+                                               : (amount > 0 && pawn_position >= token.threshold);
+        if (!reached) continue;
+        victims[token.victim]->add_coins(-token.coins);
+        military_tokens_active[i] = false;
+        if (events) events->publish(LootingTokenConsumed{token.victim, token.coins});
     }
 
     // 返回是否有人获胜
-    return (pawn_position == 0 || pawn_position == 18);
+    return (pawn_position == rules::kPawnMin || pawn_position == rules::kPawnMax);
 }
 
 int Board::get_military_vp(int player_index) const {
@@ -52,15 +44,15 @@ int Board::get_military_vp(int player_index) const {
     // P2 (idx 1) 得分区域在 0-8
     int distance = 0;
     if (player_index == 0) {
-        distance = pawn_position - 9;
+        distance = pawn_position - rules::kPawnStart;
     } else {
-        distance = 9 - pawn_position;
+        distance = rules::kPawnStart - pawn_position;
     }
 
     if (distance <= 0) return 0;   // 棋子在己方半场，不加分
-    if (distance <= 2) return 2;   // 第一阶梯
-    if (distance <= 5) return 5;   // 第二阶梯
-    return 10;                     // 第三阶梯 (不含18，因为18直接获胜了)
+    if (distance <= rules::kMilitaryTier1Distance) return rules::kMilitaryTier1Points;   // 第一阶梯
+    if (distance <= rules::kMilitaryTier2Distance) return rules::kMilitaryTier2Points;   // 第二阶梯
+    return rules::kMilitaryTier3Points;  // 第三阶梯 (不含18，因为18直接获胜了)
 }
 
 void Board::setup_progress_tokens(const std::vector<ProgressToken>& tokens) {
@@ -72,4 +64,30 @@ void Board::remove_progress_token(ProgressToken token) {
     if (it != active_progress_tokens.end()) {
         active_progress_tokens.erase(it);
     }
-}
\ No newline at end of file
+}
+
+void Board::save_state(GameSnapshot& snap) const {
+    snap.pawn_position = static_cast<uint8_t>(pawn_position);
+    for (int i = 0; i < 4; ++i) snap.looting_tokens[i] = military_tokens_active[i] ? 1 : 0;
+    snap.board_token_count = static_cast<uint8_t>(active_progress_tokens.size());
+    for (int i = 0; i < (int)active_progress_tokens.size(); ++i) {
+        snap.board_tokens[i] = static_cast<uint8_t>(active_progress_tokens[i]);
+    }
+}
+
+uint64_t Board::hash_state(uint64_t h) const {
+    h = hash_mix(h, pawn_position);
+    uint64_t tokens = 0;
+    for (int i = 0; i < 4; ++i) tokens |= (military_tokens_active[i] ? 1u : 0u) << i;
+    for (ProgressToken t : active_progress_tokens) tokens |= 1u << (4 + (int)t);
+    return hash_mix(h, tokens);
+}
+
+void Board::load_state(const GameSnapshot& snap) {
+    pawn_position = snap.pawn_position;
+    for (int i = 0; i < 4; ++i) military_tokens_active[i] = snap.looting_tokens[i] != 0;
+    active_progress_tokens.clear();
+    for (int i = 0; i < snap.board_token_count && i < GameSnapshot::kMaxProgressTokens; ++i) {
+        active_progress_tokens.push_back(static_cast<ProgressToken>(snap.board_tokens[i]));
+    }
+}
@@ -7,6 +7,8 @@
 
 // 前向声明，避免循环引用
 class Player;
+class EventBus;
+struct GameSnapshot;
 
 /**
  * Board 类：管理军事冲突条和场上的科技标记
@@ -23,8 +25,11 @@ private:
     // 场上公开的科技标记
     std::vector<ProgressToken> active_progress_tokens;
 
+    EventBus* events = nullptr;   // 棋子移动与军事惩罚事件的发布目标
+
 public:
     Board();
+    void set_event_bus(EventBus* bus) { events = bus; }
     
     /**
      * 移动冲突棋子
@@ -42,6 +47,12 @@ public:
     void setup_progress_tokens(const std::vector<ProgressToken>& tokens);
     void remove_progress_token(ProgressToken token);
     const std::vector<ProgressToken>& get_active_progress_tokens() const { return active_progress_tokens; }
+
+    // --- 快照 ---
+    void save_state(GameSnapshot& snap) const;
+    // 把棋子位置、军事惩罚标记与版图上的进步标记混入局面哈希
+    uint64_t hash_state(uint64_t h) const;
+    void load_state(const GameSnapshot& snap);
 };
 
 #endif
\ No newline at end of file
@@ -1,13 +1,24 @@
 #include "Game.h"
 #include "Board.h"
+#include "Snapshot.h"
+#include "PositionHash.h"
+#include "Rules.h"
 #include "player/Player.h"
 #include "player/CostCalculator.h"
 #include "cards/Card.h"
 #include "cards/CardStructure.h"
+#include "cards/CardSignature.h"
 #include "view/Ctrller.h"
+#include "instrument/AllocTracker.h"
+#include "instrument/Profiler.h"
+#include "instrument/Tracer.h"
 #include <iostream>
 #include <algorithm>
 #include <random>
+#include <cstring>
+#include <stdexcept>
+#include <memory_resource>
+#include <cstddef>
 
 // 1. 核心修复：初始化单例静态指针 (解决 Error 1 / ld 报错)
 Game* Game::instance = nullptr;
@@ -20,18 +31,56 @@ Game& Game::getInstance() {
 }
 
 Game::Game() : board(std::make_unique<Board>()), 
+               seed(0),
                current_age(1), 
                current_player_idx(0), 
                is_game_over(false), 
-               extra_turn_triggered(false) {}
+               extra_turn_triggered(false) {
+    board->set_event_bus(&event_bus);
+    discard_pile.reserve(60);
+    for (auto& pile : built_cards) pile.reserve(GameSnapshot::kMaxBuiltCards);
+}
+
+Game::~Game() = default;
+
+void Game::release_game_memory() {
+    // 先销毁所有从 arena 分配的对象，再一次性回收
+    players.clear();
+    cardStructure.reset();
+    discard_pile.clear();
+    for (auto& pile : built_cards) pile.clear();
+    arena.reset();
+}
+
+std::shared_ptr<Player> Game::make_player(const std::string& name, int seat) {
+    auto player = std::allocate_shared<Player>(std::pmr::polymorphic_allocator<Player>(&arena),
+                                               name, PlayerType::HUMAN, &arena);
+    player->attach_events(&event_bus, seat);
+    return player;
+}
 
 void Game::init() {
-    std::cout << "[Game] Initializing 7 Wonders Duel..." << std::endl;
+    std::random_device rd;
+    init((static_cast<uint64_t>(rd()) << 32) | rd());
+}
+
+void Game::init(uint64_t game_seed) {
+    SWD_ALLOC_PHASE(AllocPhase::AGE_SETUP);
+    seed = game_seed;
+    release_game_memory();
+    GameArena::Scope scope(&arena);
+    board = std::make_unique<Board>();
+    board->set_event_bus(&event_bus);
+    current_age = 1;
+    current_player_idx = 0;
+    is_game_over = false;
+    extra_turn_triggered = false;
+    pending = Decision{};
+    setup_progress_tokens();
     
     // 初始化玩家
-    players.clear();
-    players.push_back(std::make_shared<Player>("Player 1"));
-    players.push_back(std::make_shared<Player>("Player 2"));
+    players.push_back(make_player("Player 1", 0));
+    players.push_back(make_player("Player 2", 1));
 
     // 规则书 P6：初始金币为 7
     for(auto& p : players) {
@@ -45,10 +94,71 @@ void Game::init() {
     setup_age_structure(1);
 }
 
+namespace {
+
+// 与 std::seed_seq{a, b, c} 输出逐位相同（算法由标准 [rand.util.seedseq] 规定），
+// 但按 mt19937 的 624 个字展开、去掉逐项取模：libstdc++ 的实现每次发牌要花十几微秒
+struct SeedSeq3 {
+    using result_type = uint32_t;
+    uint32_t v[3];
+
+    template <typename It>
+    void generate(It begin, It end) const {
+        const std::size_t n = end - begin;
+        if (n != 624) {
+            std::seed_seq fallback{v[0], v[1], v[2]};
+            fallback.generate(begin, end);
+            return;
+        }
+        constexpr std::size_t kN = 624, kS = 3, kT = 11, kP = (kN - kT) / 2, kQ = kP + kT;
+        uint32_t b[kN];
+        std::fill(b, b + kN, 0x8b8b8b8bu);
+        auto T = [](uint32_t x) { return x ^ (x >> 27); };
+        std::size_t kp = kP, kq = kQ, km1 = kN - 1;
+        for (std::size_t k = 0; k < kN; ++k) {
+            const uint32_t r1 = 1664525u * T(b[k] ^ b[kp] ^ b[km1]);
+            const uint32_t r2 = r1 + static_cast<uint32_t>(k == 0 ? kS : (k <= kS ? k + v[k - 1] : k));
+            b[kp] += r1;
+            b[kq] += r2;
+            b[k] = r2;
+            km1 = k;
+            if (++kp == kN) kp = 0;
+            if (++kq == kN) kq = 0;
+        }
+        for (std::size_t k = 0; k < kN; ++k) {
+            const uint32_t r3 = 1566083941u * T(b[k] + b[kp] + b[km1]);
+            const uint32_t r4 = r3 - static_cast<uint32_t>(k);
+            b[kp] ^= r3;
+            b[kq] ^= r4;
+            b[k] = r4;
+            km1 = k;
+            if (++kp == kN) kp = 0;
+            if (++kq == kN) kq = 0;
+        }
+        std::copy(b, b + kN, begin);
+    }
+};
+
+} // namespace
+
+std::mt19937 Game::seeded_rng(uint64_t game_seed, int stream) {
+    SeedSeq3 seq{{static_cast<uint32_t>(game_seed), static_cast<uint32_t>(game_seed >> 32), static_cast<uint32_t>(stream)}};
+    return std::mt19937(seq);
+}
+
+void Game::setup_progress_tokens() {
+    // 规则 P5：随机 5 个进步标记上版图，其余留在盒中（大图书馆从盒中抽取）
+    ProgressToken tokens[10];
+    for (int i = 0; i < 10; ++i) tokens[i] = static_cast<ProgressToken>(i);
+    std::mt19937 g = make_rng(4);
+    std::shuffle(std::begin(tokens), std::end(tokens), g);
+    board->setup_progress_tokens(std::vector<ProgressToken>(tokens, tokens + 5));
+    progress_token_pool.assign(tokens + 5, tokens + 10);
+}
+
 void Game::distribute_wonders() {
-    auto all_wonders = createAllWonders();
-    std::random_device rd;
-    std::mt19937 g(rd());
+    std::vector<Wonder> all_wonders = wonder_catalog();
+    std::mt19937 g = make_rng(0);
     std::shuffle(all_wonders.begin(), all_wonders.end(), g);
     
     // 规则 P7：给 P1 前 4 个，P2 后 4 个
@@ -57,26 +167,26 @@ void Game::distribute_wonders() {
 }
 
 void Game::setup_age_structure(int age) {
-    auto all_cards = createAllCards();
-    std::vector<std::unique_ptr<Card>> age_deck;
-    for (auto& c : all_cards) {
-        if (c->age == age) age_deck.push_back(std::move(c));
+    SWD_ALLOC_PHASE(AllocPhase::AGE_SETUP);
+    SWD_TRACE_SCOPE_ARG("age_setup", age);
+    // 只洗目录下标，选中的 20 张再从目录克隆，避免每个时代重建整副牌
+    std::vector<int> age_ids;
+    for (const auto& c : card_catalog()) {
+        if (c->age == age) age_ids.push_back(c->id);
     }
 
-    // 增加一个调试打印，看看实际找到了多少张牌
-    std::cout << "[DEBUG] Loading Age " << age << ", found " << age_deck.size() << " cards." << std::endl;
-
-    std::random_device rd;
-    std::mt19937 g(rd());
-    std::shuffle(age_deck.begin(), age_deck.end(), g);
+    std::mt19937 g = make_rng(age);
+    std::shuffle(age_ids.begin(), age_ids.end(), g);
 
     // 必须确保正好 20 张
-    if (age_deck.size() > 20) {
-        age_deck.resize(20); // 使用 resize 更安全
-    } else if (age_deck.size() < 20) {
+    if ((int)age_ids.size() < rules::kPyramidSlots) {
         std::cerr << "Fatal Error: Not enough cards for Age " << age << std::endl;
         exit(1);
     }
+    GameArena::Scope scope(&arena);
+    std::vector<std::unique_ptr<Card>> age_deck;
+    age_deck.reserve(rules::kPyramidSlots);
+    for (int i = 0; i < rules::kPyramidSlots; ++i) age_deck.push_back(clone_card(age_ids[i]));
     
     cardStructure = std::make_unique<CardStructure>(age, std::move(age_deck));
 }
@@ -97,10 +207,8 @@ bool Game::take_card(int pos, Player& player) {
     // 执行结构化效果 (VP, 盾牌, 符号)
     card->apply_effect(player, *this);
     player.add_built_card(card->name, card->color);
-
-    if (check_supremacy_victory()) return true;
-
-    handle_turn_switch();
+    event_bus.publish(CardBuilt{player.get_seat(), card->id, card->color});
+    built_cards[player.get_seat()].push_back(std::move(card));
     return true;
 } 
 
@@ -113,22 +221,21 @@ void Game::discard_for_coins(int pos, Player& player) {
     int gain = 2 + player.count_yellow();
     player.add_coins(gain);
     
+    event_bus.publish(CardDiscarded{player.get_seat(), card->id, gain});
     discard_pile.push_back(std::move(card));
-    std::cout << "[Game] " << player.get_name() << " gained " << gain << " coins." << std::endl;
-    
-    handle_turn_switch();
 }
 
 // --- 核心动作 3：建造奇迹 ---
 bool Game::build_wonder(int wonder_idx, int pos, Player& player) {
     Wonder& wonder = player.get_wonder(wonder_idx);
     
-    // 检查奇迹状态及金字塔是否有地基
+    // 检查奇迹状态及金字塔是否有地基，并支付奇迹费用（含交易）
     if (wonder.is_built || !cardStructure->get_card(pos)) return false;
+    if (!CostCalculator::execute_wonder_build(player, *get_opponent(player), wonder)) return false;
 
-    // 取走卡牌作为地基（面朝下）
-    std::unique_ptr<Card> foundation = cardStructure->take_card(pos);
-    discard_pile.push_back(std::move(foundation));
+    // 取走卡牌作为地基：面朝下压在奇迹下，不进入弃牌堆（不能再被摩索拉斯王陵墓建造）；
+    // 取走前是正面朝上的，双方都见过，记下身份
+    wonder.foundation = cardStructure->take_card(pos)->id;
 
     // 应用奇迹结构化效果
     player.add_victory_points(wonder.victory_points);
@@ -136,19 +243,20 @@ bool Game::build_wonder(int wonder_idx, int pos, Player& player) {
     
     // 执行 Lambda 效果 (如 Appian Way 扣钱)
     if (wonder.effect) {
+        SWD_ALLOC_PHASE(AllocPhase::EFFECT);
+        SWD_PROFILE_SCOPE(ProfilePoint::WONDER_EFFECT);
         wonder.effect(player, *get_opponent(), *this);
     }
 
     wonder.is_built = true;
     player.increment_wonder_count();
-
-    handle_turn_switch();
+    event_bus.publish(WonderBuilt{player.get_seat(), wonder.id});
     return true;
 }
 
 void Game::handle_turn_switch() {
     if (extra_turn_triggered) {
-        std::cout << ">>> EXTRA TURN! <<<" << std::endl;
+        event_bus.publish(ExtraTurn{current_player_idx});
         extra_turn_triggered = false; 
     } else {
         current_player_idx = (current_player_idx + 1) % 2;
@@ -165,38 +273,178 @@ void Game::move_pawn(int steps) {
 
 bool Game::check_supremacy_victory() {
     // 军事压制
-    if (board->get_pawn_position() <= 0 || board->get_pawn_position() >= 18) return true;
+    if (board->get_pawn_position() <= rules::kPawnMin || board->get_pawn_position() >= rules::kPawnMax) return true;
     // 科技压制
-    if (get_current_player()->get_unique_science_count() >= 6) return true;
+    if (get_current_player()->get_unique_science_count() >= rules::kScienceSupremacy) return true;
     return false;
 }
 
-void Game::run() {
-    init();
-    Controller controller(*this); 
-
-    while (!is_game_over && current_age <= 3) {
-        while (!cardStructure->is_empty() && !is_game_over) { 
-            controller.player_turn(*get_current_player());
-            if (check_supremacy_victory()) {
-                is_game_over = true;
-                break;
-            }
-        }
-
-        if (!is_game_over) {
+void Game::finish_turn() {
+    // 压制判定针对刚行动的玩家，须在换手之前
+    if (!is_game_over && check_supremacy_victory()) is_game_over = true;
+    if (!is_game_over) {
+        handle_turn_switch();
+        if (cardStructure->is_empty()) {
             current_age++;
+            SWD_TRACE_INSTANT("age_transition", current_age);
             if (current_age <= 3) {
-                std::cout << "\n--- Starting Age " << current_age << " ---" << std::endl;
+                event_bus.publish(AgeChanged{current_age});
                 setup_age_structure(current_age);
+            } else {
+                is_game_over = true;
             }
         }
     }
+    pending = Decision{};
+    pending.type = is_game_over ? Decision::Type::GAME_OVER : Decision::Type::PICK_ACTION;
+    pending.player = static_cast<int8_t>(current_player_idx);
+}
+
+void Game::open_decision(Decision::Type type) {
+    pending = Decision{};
+    pending.type = type;
+    pending.player = static_cast<int8_t>(current_player_idx);
+}
+
+void Game::run() {
+    run(ConsoleOptions());
+}
+
+void Game::run(const ConsoleOptions& options) {
+    if (players.empty()) init();
+    Controller controller(*this, options);
+
+    // 控制台只是驱动状态机的一种方式：逐个决策点读取输入
+    while (!is_game_over) {
+        if (!controller.resolve_decision()) return;  // 输入已关闭
+    }
     
-    Player* winner = players[0]->calculate_final_score() > players[1]->calculate_final_score() ? players[0].get() : players[1].get();
+    Player* winner = players[get_winner()].get();
     std::cout << "\nGAME OVER! Winner: " << winner->get_name() << std::endl;
 }
 
+void Game::legal_moves(std::vector<Move>& out) const {
+    SWD_PROFILE_SCOPE(ProfilePoint::MOVE_GEN);
+    out.clear();
+    const Player& self = *players[current_player_idx];
+    switch (pending.type) {
+        case Decision::Type::PICK_ACTION: {
+            const Player& opp = *players[(current_player_idx + 1) % 2];
+            // 可建的奇迹与地基位置无关，先算一次
+            int wonders[rules::kWondersPerPlayer];
+            int wonder_count = 0;
+            for (int w = 0; w < self.get_wonder_count() && wonder_count < rules::kWondersPerPlayer; ++w) {
+                if (is_buildable_wonder(self, w)) wonders[wonder_count++] = w;
+            }
+            // 奇迹直接带上编号枚举，机器人无需经过 CHOOSE_WONDER 这一步
+            for (int pos = 0; pos < rules::kPyramidSlots; ++pos) {
+                if (!cardStructure->is_accessible(pos)) continue;
+                const Card* card = cardStructure->get_card(pos);
+                if (CostCalculator::can_afford_with_trade(self, opp, *card)) out.emplace_back(Move::Type::BUILD, pos);
+                out.emplace_back(Move::Type::DISCARD, pos);
+                for (int i = 0; i < wonder_count; ++i) out.emplace_back(Move::Type::WONDER, pos, wonders[i]);
+            }
+            break;
+        }
+        case Decision::Type::CHOOSE_WONDER:
+            for (int w = 0; w < self.get_wonder_count(); ++w) {
+                if (is_buildable_wonder(self, w)) out.emplace_back(Move::Type::CHOOSE_WONDER, pending.pos, w);
+            }
+            break;
+        case Decision::Type::CHOOSE_PROGRESS_TOKEN:
+            for (int i = 0; i < pending.offered_count; ++i) {
+                out.emplace_back(Move::Type::PICK_TOKEN, static_cast<int>(pending.offered_tokens[i]));
+            }
+            break;
+        case Decision::Type::CHOOSE_DISCARDED_CARD:
+            for (int i = 0; i < (int)discard_pile.size(); ++i) out.emplace_back(Move::Type::BUILD_DISCARDED, i);
+            break;
+        case Decision::Type::CHOOSE_CARD_TO_DESTROY: {
+            const auto& pile = built_cards[(current_player_idx + 1) % 2];
+            for (int i = 0; i < (int)pile.size(); ++i) {
+                if (pile[i]->color == pending.color) out.emplace_back(Move::Type::DESTROY_CARD, i);
+            }
+            break;
+        }
+        case Decision::Type::GAME_OVER:
+            break;
+    }
+}
+
+bool Game::apply_move(const Move& move) {
+    if (is_game_over || pending.type == Decision::Type::GAME_OVER) return false;
+    SWD_TRACE_SCOPE_ARG("turn", current_player_idx + 1);
+    Player& player = *get_current_player();
+
+    // 先把决策点复位为 PICK_ACTION：若效果又打开了新的决策点，pending 会被改写
+    const Decision asked = pending;
+    pending.type = Decision::Type::PICK_ACTION;
+    bool ok = false;
+    switch (asked.type) {
+        case Decision::Type::PICK_ACTION:            ok = apply_action(move, player); break;
+        case Decision::Type::CHOOSE_WONDER:
+            ok = move.type == Move::Type::CHOOSE_WONDER && is_buildable_wonder(player, move.wonder_idx) &&
+                 build_wonder(move.wonder_idx, asked.pos, player);
+            break;
+        case Decision::Type::CHOOSE_PROGRESS_TOKEN:  ok = move.type == Move::Type::PICK_TOKEN && take_progress_token(asked, move.pos, player); break;
+        case Decision::Type::CHOOSE_DISCARDED_CARD:  ok = move.type == Move::Type::BUILD_DISCARDED && build_from_discard(move.pos, player); break;
+        case Decision::Type::CHOOSE_CARD_TO_DESTROY: ok = move.type == Move::Type::DESTROY_CARD && destroy_card(asked.color, move.pos); break;
+        case Decision::Type::GAME_OVER: break;
+    }
+    if (!ok) {
+        pending = asked;
+        return false;
+    }
+    // 没有新的决策点（或对局已结束）时回合结束
+    if (is_game_over || pending.type == Decision::Type::PICK_ACTION) finish_turn();
+    event_bus.publish(MoveApplied{asked.player, move});
+    return true;
+}
+
+bool Game::is_buildable_wonder(const Player& player, int wonder_idx) const {
+    if (wonder_idx < 0 || wonder_idx >= player.get_wonder_count() || player.get_wonder(wonder_idx).is_built) return false;
+    if (players[0]->count_wonder_stages() + players[1]->count_wonder_stages() >= rules::kMaxWondersBuilt) return false;
+    const Player& opp = *players[(player.get_seat() + 1) % 2];
+    return CostCalculator::can_afford_wonder(player, opp, player.get_wonder(wonder_idx));
+}
+
+bool Game::apply_action(const Move& move, Player& player) {
+    if (move.pos < 0 || move.pos >= rules::kPyramidSlots || !cardStructure->is_accessible(move.pos)) return false;
+    switch (move.type) {
+        case Move::Type::BUILD:
+            return take_card(move.pos, player);
+        case Move::Type::DISCARD:
+            discard_for_coins(move.pos, player);
+            return true;
+        case Move::Type::WONDER:
+            if (move.wonder_idx == -1) {
+                // 只选定了地基：停在 CHOOSE_WONDER，等待选择奇迹
+                bool any = false;
+                for (int w = 0; w < player.get_wonder_count(); ++w) any = any || is_buildable_wonder(player, w);
+                if (!any) return false;
+                open_decision(Decision::Type::CHOOSE_WONDER);
+                pending.pos = move.pos;
+                return true;
+            }
+            return is_buildable_wonder(player, move.wonder_idx) && build_wonder(move.wonder_idx, move.pos, player);
+        default:
+            return false;
+    }
+}
+
+int Game::get_winner() const {
+    // 军事压制：P1 把棋子推到 18，P2 推到 0
+    int pawn = board->get_pawn_position();
+    if (pawn >= rules::kPawnMax) return 0;
+    if (pawn <= rules::kPawnMin) return 1;
+    // 科技压制
+    for (int i = 0; i < 2; ++i) {
+        if (players[i]->get_unique_science_count() >= rules::kScienceSupremacy) return i;
+    }
+    // 平局时沿用原先的判定（后手获胜）
+    return players[0]->calculate_final_score() > players[1]->calculate_final_score() ? 0 : 1;
+}
+
 // --- Getter 组 (对齐 snake_case) ---
 
 Player* Game::get_current_player() { return players[current_player_idx].get(); }
@@ -209,19 +457,313 @@ Player* Game::get_opponent(Player& p) {
 // --- 奇迹效果回调接口 ---
 
 void Game::trigger_progress_token_selection(Player& p, int count) {
-    std::cout << "[INFO] Progress Token Selection triggered for " << p.get_name() << std::endl;
+    // 从盒中（未上版图的标记）取前 count 个供选择，未选中的留在盒中
+    int n = std::min({count, Decision::kMaxOfferedTokens, (int)progress_token_pool.size()});
+    if (n == 0) return;
+    open_decision(Decision::Type::CHOOSE_PROGRESS_TOKEN);
+    pending.offered_count = static_cast<int8_t>(n);
+    for (int i = 0; i < n; ++i) pending.offered_tokens[i] = progress_token_pool[i];
+    event_bus.publish(ProgressTokenOffered{p.get_seat(), n});
 }
 
 void Game::trigger_build_from_discard(Player& p) {
-    std::cout << "[INFO] Build from Discard triggered for " << p.get_name() << std::endl;
+    if (discard_pile.empty()) return;
+    open_decision(Decision::Type::CHOOSE_DISCARDED_CARD);
+    event_bus.publish(DiscardBuildOffered{p.get_seat()});
+}
+
+void Game::trigger_card_destruction(Player& target, Color color) {
+    // 对手没有该颜色的牌时效果落空
+    if (target.get_card_count_by_color(color) == 0) return;
+    open_decision(Decision::Type::CHOOSE_CARD_TO_DESTROY);
+    pending.color = color;
+}
+
+bool Game::take_progress_token(const Decision& asked, int token_value, Player& player) {
+    const ProgressToken* offered_end = asked.offered_tokens + asked.offered_count;
+    const ProgressToken token = static_cast<ProgressToken>(token_value);
+    if (std::find(asked.offered_tokens, offered_end, token) == offered_end) return false;
+
+    progress_token_pool.erase(std::remove(progress_token_pool.begin(), progress_token_pool.end(), token),
+                              progress_token_pool.end());
+    player.add_progress_token(token);
+    // 即时效果；其余标记的持续效果尚未在规则层实现，只记录归属
+    switch (token) {
+        case ProgressToken::AGRICULTURE: player.add_coins(6); player.add_victory_points(4); break;
+        case ProgressToken::URBANISM:    player.add_coins(6); break;
+        case ProgressToken::PHILOSOPHY:  player.add_victory_points(7); break;
+        case ProgressToken::LAW:         player.add_science_symbol(Resource::LAW); break;
+        default: break;
+    }
+    return true;
+}
+
+bool Game::build_from_discard(int idx, Player& player) {
+    if (idx < 0 || idx >= (int)discard_pile.size()) return false;
+    std::unique_ptr<Card> card = std::move(discard_pile[idx]);
+    discard_pile.erase(discard_pile.begin() + idx);
+
+    // 免费建造：不支付费用，效果照常结算
+    card->apply_effect(player, *this);
+    player.add_built_card(card->name, card->color);
+    event_bus.publish(CardBuilt{player.get_seat(), card->id, card->color});
+    built_cards[player.get_seat()].push_back(std::move(card));
+    return true;
+}
+
+bool Game::destroy_card(Color color, int idx) {
+    Player& target = *get_opponent();
+    auto& pile = built_cards[target.get_seat()];
+    if (idx < 0 || idx >= (int)pile.size() || pile[idx]->color != color) return false;
+
+    // 撤销该卡的资源产出：在空白玩家上重放其效果得到产出量
+    alignas(std::max_align_t) char scratch[1024];
+    std::pmr::monotonic_buffer_resource probe_memory(scratch, sizeof(scratch));
+    Player probe("probe", PlayerType::HUMAN, &probe_memory);
+    if (pile[idx]->immediate_func) pile[idx]->immediate_func(probe, *this);
+    for (int r = (int)Resource::WOOD; r <= (int)Resource::PAPYRUS; ++r) {
+        int amount = probe.get_resource(static_cast<Resource>(r));
+        if (amount > 0) target.remove_resource(static_cast<Resource>(r), amount);
+    }
+    target.remove_built_card(idx, color);
+
+    // 被拆的牌进入弃牌堆
+    discard_pile.push_back(std::move(pile[idx]));
+    pile.erase(pile.begin() + idx);
+    event_bus.publish(CardDestroyed{target.get_seat(), color});
+    return true;
 }
 
 std::vector<Card*> Game::get_discard_pile_view() {
     std::vector<Card*> view;
-    for(auto& c : discard_pile) view.push_back(c.get());
+    collect_discard_pile(view);
     return view;
 }
 
+void Game::collect_discard_pile(std::vector<Card*>& out) const {
+    out.clear();
+    for (const auto& c : discard_pile) out.push_back(c.get());
+}
+
 void Game::check_science_victory(Player& p) {
-    if (p.get_unique_science_count() >= 6) is_game_over = true;
-}
\ No newline at end of file
+    if (p.get_unique_science_count() >= rules::kScienceSupremacy) is_game_over = true;
+}
+
+// --- 局面哈希 ---
+
+uint64_t Game::position_hash() const {
+    uint64_t h = hash_mix(0, static_cast<uint64_t>(current_age) << 16 | current_player_idx << 8 | (int)pending.type);
+    h = board->hash_state(h);
+    h = cardStructure->hash_state(h);
+    for (int i = 0; i < (int)players.size(); ++i) {
+        h = players[i]->hash_state(hash_mix(h, i));
+        // 已建卡牌与取得顺序无关
+        uint64_t cards = 0;
+        for (const auto& c : built_cards[i]) cards += hash_mix(i + 1, c->id);
+        h = hash_mix(h, cards);
+    }
+    return h;
+}
+
+uint64_t Game::canonical_hash() const {
+    uint64_t h = hash_mix(0, static_cast<uint64_t>(current_age) << 16 | current_player_idx << 8 | (int)pending.type);
+    h = board->hash_state(h);
+    bool mirrored = false;
+    h = hash_mix(h, cardStructure->canonical_key(-1, &mirrored));
+    switch (pending.type) {
+        case Decision::Type::CHOOSE_WONDER:
+            h = hash_mix(h, mirrored ? CardStructure::mirror_slot(current_age, pending.pos) : pending.pos);
+            break;
+        case Decision::Type::CHOOSE_PROGRESS_TOKEN:
+            for (int i = 0; i < pending.offered_count; ++i) h = hash_mix(h, (int)pending.offered_tokens[i]);
+            break;
+        case Decision::Type::CHOOSE_CARD_TO_DESTROY:
+            h = hash_mix(h, (int)pending.color);
+            break;
+        default:
+            break;
+    }
+    for (int i = 0; i < (int)players.size(); ++i) {
+        h = players[i]->hash_state(hash_mix(h, i));
+        uint64_t cards = 0;
+        for (const auto& c : built_cards[i]) cards += hash_mix(i + 1, card_class(c->id));
+        h = hash_mix(h, cards);
+    }
+    uint64_t discarded = 0;
+    for (const auto& c : discard_pile) discarded += hash_mix(3, card_class(c->id));
+    return hash_mix(h, discarded);
+}
+
+uint64_t Game::visible_hash() const {
+    uint64_t h = hash_mix(0, static_cast<uint64_t>(current_age) << 16 | current_player_idx << 8 | (int)pending.type);
+    h = board->hash_state(h);
+    h = hash_mix(h, cardStructure->visible_key());
+    switch (pending.type) {
+        case Decision::Type::CHOOSE_WONDER:
+            h = hash_mix(h, pending.pos);
+            break;
+        case Decision::Type::CHOOSE_PROGRESS_TOKEN:
+            for (int i = 0; i < pending.offered_count; ++i) h = hash_mix(h, (int)pending.offered_tokens[i]);
+            break;
+        case Decision::Type::CHOOSE_CARD_TO_DESTROY:
+            h = hash_mix(h, (int)pending.color);
+            break;
+        default:
+            break;
+    }
+    for (int i = 0; i < (int)players.size(); ++i) {
+        h = players[i]->hash_state(hash_mix(h, i));
+        uint64_t cards = 0;
+        for (const auto& c : built_cards[i]) cards += hash_mix(i + 1, card_class(c->id));
+        h = hash_mix(h, cards);
+    }
+    uint64_t discarded = 0;
+    for (const auto& c : discard_pile) discarded += hash_mix(3, card_class(c->id));
+    return hash_mix(h, discarded);
+}
+
+void Game::canonical_moves(std::vector<Move>& out) const {
+    legal_moves(out);
+    if (out.size() < 2) return;
+
+    // 每个动作的归并键；键相同的动作只保留第一个
+    uint64_t keys[action_space::kCount];
+    uint64_t pyramid_after[rules::kPyramidSlots];
+    bool pyramid_known[rules::kPyramidSlots] = {};
+    const auto& destroy_pile = built_cards[(current_player_idx + 1) % 2];
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < out.size() && i < (std::size_t)action_space::kCount; ++i) {
+        const Move& m = out[i];
+        uint64_t key = hash_mix(static_cast<uint64_t>(m.type), static_cast<uint64_t>(m.wonder_idx + 1));
+        switch (m.type) {
+            case Move::Type::BUILD:
+            case Move::Type::DISCARD:
+            case Move::Type::WONDER:
+                if (!pyramid_known[m.pos]) {
+                    pyramid_after[m.pos] = cardStructure->canonical_key(m.pos);
+                    pyramid_known[m.pos] = true;
+                }
+                // 作为奇迹地基的卡牌不进入任何牌堆，不必区分等价类
+                if (m.type != Move::Type::WONDER) key = hash_mix(key, card_class(cardStructure->get_card(m.pos)->id));
+                key = hash_mix(key, pyramid_after[m.pos]);
+                break;
+            case Move::Type::BUILD_DISCARDED:
+                key = hash_mix(key, card_class(discard_pile[m.pos]->id));
+                break;
+            case Move::Type::DESTROY_CARD:
+                key = hash_mix(key, card_class(destroy_pile[m.pos]->id));
+                break;
+            default:
+                key = hash_mix(key, static_cast<uint64_t>(m.pos));
+                break;
+        }
+        if (std::find(keys, keys + kept, key) != keys + kept) continue;
+        keys[kept] = key;
+        out[kept++] = m;
+    }
+    out.resize(kept);
+}
+
+// --- 快照存取 ---
+
+void Game::save_snapshot(GameSnapshot& snap) const {
+    std::memset(&snap, 0, sizeof(snap));
+    snap.magic = GameSnapshot::kMagic;
+    snap.version = GameSnapshot::kVersion;
+    snap.size = sizeof(GameSnapshot);
+    snap.seed = seed;
+
+    snap.current_age = static_cast<uint8_t>(current_age);
+    snap.current_player = static_cast<uint8_t>(current_player_idx);
+    snap.game_over = is_game_over ? 1 : 0;
+    snap.extra_turn = extra_turn_triggered ? 1 : 0;
+
+    snap.decision_type = static_cast<uint8_t>(pending.type);
+    snap.decision_player = static_cast<uint8_t>(pending.player);
+    snap.decision_pos = pending.pos;
+    snap.decision_color = static_cast<uint8_t>(pending.color);
+    snap.offered_token_count = static_cast<uint8_t>(pending.offered_count);
+    for (int i = 0; i < pending.offered_count; ++i) snap.offered_tokens[i] = static_cast<uint8_t>(pending.offered_tokens[i]);
+
+    board->save_state(snap);
+    snap.pool_token_count = static_cast<uint8_t>(std::min<size_t>(progress_token_pool.size(), GameSnapshot::kMaxProgressTokens));
+    for (int i = 0; i < snap.pool_token_count; ++i) snap.pool_tokens[i] = static_cast<uint8_t>(progress_token_pool[i]);
+
+    if (cardStructure) {
+        cardStructure->save_state(snap);
+    } else {
+        std::memset(snap.slots, GameSnapshot::kEmpty, sizeof(snap.slots));
+    }
+
+    if (discard_pile.size() > GameSnapshot::kMaxDiscard) {
+        throw std::runtime_error("Game::save_snapshot - discard pile exceeds snapshot capacity");
+    }
+    snap.discard_count = static_cast<uint8_t>(discard_pile.size());
+    for (int i = 0; i < (int)discard_pile.size(); ++i) snap.discard[i] = static_cast<uint8_t>(discard_pile[i]->id);
+
+    for (int i = 0; i < (int)players.size() && i < 2; ++i) {
+        players[i]->save_state(snap, i);
+        // Player 只记卡名，而目录中有同名卡；以对局自己的已建卡牌覆盖为准确的目录下标
+        const auto& pile = built_cards[i];
+        if (pile.size() == snap.players[i].built_card_count) {
+            for (int j = 0; j < (int)pile.size(); ++j) snap.players[i].built_cards[j] = static_cast<uint8_t>(pile[j]->id);
+        }
+    }
+}
+
+bool Game::load_snapshot(const GameSnapshot& snap) {
+    if (!snap.is_valid()) return false;
+
+    // 载入快照即开始新的一局：回收上一局的全部内存
+    release_game_memory();
+    GameArena::Scope scope(&arena);
+
+    seed = snap.seed;
+    current_age = snap.current_age;
+    current_player_idx = snap.current_player;
+    is_game_over = snap.game_over != 0;
+    extra_turn_triggered = snap.extra_turn != 0;
+
+    pending = Decision{};
+    pending.type = static_cast<Decision::Type>(snap.decision_type);
+    pending.player = static_cast<int8_t>(snap.decision_player);
+    pending.pos = snap.decision_pos;
+    pending.color = static_cast<Color>(snap.decision_color);
+    pending.offered_count = static_cast<int8_t>(std::min<int>(snap.offered_token_count, Decision::kMaxOfferedTokens));
+    for (int i = 0; i < pending.offered_count; ++i) pending.offered_tokens[i] = static_cast<ProgressToken>(snap.offered_tokens[i]);
+
+    board->load_state(snap);
+    progress_token_pool.clear();
+    for (int i = 0; i < snap.pool_token_count; ++i) {
+        progress_token_pool.push_back(static_cast<ProgressToken>(snap.pool_tokens[i]));
+    }
+
+    cardStructure = CardStructure::from_snapshot(snap);
+
+    for (int i = 0; i < snap.discard_count; ++i) {
+        auto card = clone_card(snap.discard[i]);
+        if (card) discard_pile.push_back(std::move(card));
+    }
+
+    players.push_back(make_player("Player 1", 0));
+    players.push_back(make_player("Player 2", 1));
+    for (int i = 0; i < 2; ++i) {
+        players[i]->load_state(snap, i);
+        for (int j = 0; j < snap.players[i].built_card_count; ++j) {
+            auto card = clone_card(snap.players[i].built_cards[j]);
+            if (card) built_cards[i].push_back(std::move(card));
+        }
+    }
+    return true;
+}
+
+bool Game::save_to_file(const std::string& path) const {
+    GameSnapshot snap;
+    save_snapshot(snap);
+    return write_snapshot_file(path, snap);
+}
+
+bool Game::load_from_file(const std::string& path) {
+    GameSnapshot snap;
+    return read_snapshot_file(path, snap) && load_snapshot(snap);
+}
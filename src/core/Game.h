@@ -2,51 +2,96 @@
 #include <vector>
 #include <memory>
 #include <string>
+#include <cstdint>
+#include <random>
 #include "Types.h" // 核心：包含所有枚举，如 ProgressToken
 #include "cards/Card.h"
 #include "cards/Wonder.h"
+#include "GameArena.h"
+#include "Move.h"
+#include "GameEvents.h"
 
 // 前向声明
 class Board;
 class Player;
 class CardStructure;
 class Controller;
+struct ConsoleOptions;
+struct GameSnapshot;
 
 class Game {
 private:
     static Game* instance;
-    Game(); 
+
+    // 本局内存池：必须声明在所有从中分配的成员之前，保证最后析构
+    GameArena arena;
+    EventBus event_bus;       // 规则事件：界面/日志订阅，无界面对局无订阅者
 
     std::unique_ptr<Board> board;
     std::vector<std::shared_ptr<Player>> players;
     std::unique_ptr<CardStructure> cardStructure;
     
+    uint64_t seed;            // 发牌种子：奇迹分发与各时代牌序均由它派生
     int current_age;
     int current_player_idx;
     bool is_game_over;
     bool extra_turn_triggered; 
 
     std::vector<std::unique_ptr<Card>> discard_pile; 
-    std::vector<ProgressToken> progress_token_pool;   
+    // 双方已建卡牌对象，顺序与 Player::get_built_card_names() 一致（被拆时移入弃牌堆）
+    std::vector<std::unique_ptr<Card>> built_cards[2];
+    std::vector<ProgressToken> progress_token_pool;   // 盒中（未上版图）的进步标记
+    Decision pending;                                 // 当前停留的决策点
 
     // 内部私有辅助
     void setup_age_structure(int age);
+    void release_game_memory();  // 销毁本局对象并重置 arena
+    std::shared_ptr<Player> make_player(const std::string& name, int seat);
     void handle_turn_switch();
     void distribute_wonders(); 
+    void setup_progress_tokens();
+    std::mt19937 make_rng(int stream) const { return seeded_rng(seed, stream); }
+
+    // --- 状态机内部 ---
+    void open_decision(Decision::Type type);  // 效果触发时停在新的决策点
+    void finish_turn();                       // 回合收尾：压制判定、换手、时代推进
+    bool apply_action(const Move& move, Player& player);
+    // 未建、双方合计未满 7 座且付得起（含交易）
+    bool is_buildable_wonder(const Player& player, int wonder_idx) const;
+    bool take_progress_token(const Decision& asked, int token_value, Player& player);
+    bool build_from_discard(int idx, Player& player);
+    bool destroy_card(Color color, int idx);
+
+    // --- 核心动作：只执行动作本身，回合推进由 apply_move 负责 ---
+    bool take_card(int pos, Player& player);
+    bool build_wonder(int wonder_idx, int pos, Player& player);
+    void discard_for_coins(int pos, Player& player);
 
 public:
+    // 控制台程序使用单例；模拟/工具可以直接构造多个独立对局
+    Game();
     static Game& getInstance();
     Game(const Game&) = delete;
     void operator=(const Game&) = delete;
 
     void init(); 
-    void run();  
+    void init(uint64_t game_seed);
+    void run();  // 控制台驱动：若尚未初始化（或未载入快照）则先 init()
+    void run(const ConsoleOptions& options);  // 同上，可由机器人执一方 / 开启提示
     void end_age(); 
 
-    // --- 核心动作 (对齐 snake_case) ---
-    bool take_card(int pos, Player& player);
-    bool build_wonder(int wonder_idx, int pos, Player& player);
-    void discard_for_coins(int pos, Player& player);
+    // --- 决策驱动接口（状态机） ---
+    // 对局停在哪个决策点、等待哪位玩家；外部驱动据此喂入 Move
+    const Decision& get_decision() const { return pending; }
+    // 生成当前决策点的全部合法选择（复用 out 的容量，稳态下不分配内存）
+    void legal_moves(std::vector<Move>& out) const;
+    // 回答当前决策点并推进到下一个决策点后立即返回；非法选择返回 false 且状态不变
+    bool apply_move(const Move& move);
+    bool is_over() const { return is_game_over; }
+    // 胜者下标：军事/科技压制优先，否则比较最终得分
+    int get_winner() const;
+    int get_current_player_idx() const { return current_player_idx; }
+    const Player& get_player(int idx) const { return *players[idx]; }
 
     // --- 状态检查 ---
     bool check_supremacy_victory(); 
@@ -54,6 +99,7 @@ public:
 
     // --- Getter & Setter (对齐 snake_case) ---
     Board* get_board() { return board.get(); }
+    const Board* get_board() const { return board.get(); }
     Player* get_current_player();
     
     // 获取当前非回合玩家
@@ -62,6 +108,7 @@ public:
     Player* get_opponent(Player& p); 
 
     CardStructure& get_structure() { return *cardStructure; } 
+    const CardStructure& get_structure() const { return *cardStructure; }
     int get_current_age() const { return current_age; }
     
     // --- 供 Wonder/Card 调用的回调接口 ---
@@ -71,9 +118,37 @@ public:
     // 交互触发
     void trigger_progress_token_selection(Player& p, int count);
     void trigger_build_from_discard(Player& p);
+    void trigger_card_destruction(Player& target, Color color);
     
     // 获取弃牌堆视图
     std::vector<Card*> get_discard_pile_view(); 
+    void collect_discard_pile(std::vector<Card*>& out) const; // 复用调用方缓冲区
+    const GameArena& get_arena() const { return arena; }
+    EventBus& events() { return event_bus; }
+
+    // --- 快照存取 (见 core/Snapshot.h) ---
+    void save_snapshot(GameSnapshot& snap) const;
+    bool load_snapshot(const GameSnapshot& snap);
+    bool save_to_file(const std::string& path) const;
+    bool load_from_file(const std::string& path);
+    uint64_t get_seed() const { return seed; }
+    // 发牌随机流：stream 0 = 奇迹，1-3 = 各时代牌序，4 = 进步标记（批量模拟器据此复现同一副牌）
+    static std::mt19937 seeded_rng(uint64_t game_seed, int stream);
+
+    // 局面哈希：金字塔、双方玩家、版图、轮到谁与待决策类型（不含发牌种子）
+    uint64_t position_hash() const;
+
+    // --- 规范化（卡牌等价类见 cards/CardSignature.h）---
+    // 规范局面键：卡牌按等价类计、已建卡牌与弃牌堆按多重集计、金字塔取左右镜像中较小者；
+    // 可互换的局面得到同一个键，可作为置换表/缓存的键
+    uint64_t canonical_hash() const;
+    // 可见局面键：与 canonical_hash 相同地按等价类与多重集计，但背面朝上的牌只记“有牌”、
+    // 不取镜像（动作的槽位编号保持有效）；不含行动方看不到的信息，不同发牌种子下的同一可见局面键相同
+    uint64_t visible_hash() const;
+    // 合法动作去重：结果规范等价的动作只保留第一个（顺序与 legal_moves 相同）。
+    // 回合动作按 (类型, 奇迹, 卡牌等价类, 取走后的规范金字塔) 归并；
+    // 弃牌堆建造与拆牌按所选卡牌的等价类归并
+    void canonical_moves(std::vector<Move>& out) const;
 
-    ~Game() = default;
+    ~Game();
 };
\ No newline at end of file
@@ -0,0 +1,73 @@
+#include "GameArena.h"
+#include <new>
+
+namespace {
+thread_local GameArena* active_arena = nullptr;
+
+// 对象头：记录来源 arena（nullptr 表示全局堆），按最大对齐填充
+struct alignas(alignof(std::max_align_t)) AllocHeader {
+    GameArena* arena;
+};
+}
+
+GameArena::GameArena(std::size_t initial_bytes)
+    : initial_size(initial_bytes),
+      initial_buffer(new std::byte[initial_bytes]),
+      monotonic(initial_buffer.get(), initial_bytes, std::pmr::new_delete_resource()),
+      used_bytes(0),
+      peak(0) {}
+
+void GameArena::reset() {
+    monotonic.release();
+    used_bytes = 0;
+}
+
+void* GameArena::do_allocate(std::size_t bytes, std::size_t alignment) {
+    void* p = monotonic.allocate(bytes, alignment);
+    used_bytes += bytes;
+    if (used_bytes > peak) peak = used_bytes;
+    return p;
+}
+
+void GameArena::do_deallocate(void*, std::size_t, std::size_t) {
+    // 单调分配：单个对象不回收，统一在 reset() 时释放
+}
+
+bool GameArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
+
+GameArena::Scope::Scope(GameArena* arena) : previous(active_arena) {
+    active_arena = arena;
+}
+
+GameArena::Scope::~Scope() {
+    active_arena = previous;
+}
+
+GameArena* GameArena::current() {
+    return active_arena;
+}
+
+std::pmr::memory_resource* GameArena::current_resource() {
+    return active_arena ? static_cast<std::pmr::memory_resource*>(active_arena)
+                        : std::pmr::get_default_resource();
+}
+
+// --- ArenaAllocated ---
+
+void* ArenaAllocated::operator new(std::size_t size) {
+    const std::size_t total = sizeof(AllocHeader) + size;
+    GameArena* arena = active_arena;
+    void* raw = arena ? arena->allocate(total, alignof(AllocHeader)) : ::operator new(total);
+    AllocHeader* header = static_cast<AllocHeader*>(raw);
+    header->arena = arena;
+    return header + 1;
+}
+
+void ArenaAllocated::operator delete(void* p) noexcept {
+    if (!p) return;
+    AllocHeader* header = static_cast<AllocHeader*>(p) - 1;
+    if (header->arena == nullptr) ::operator delete(header);
+    // 来自 arena 的对象在 GameArena::reset() 时统一回收
+}
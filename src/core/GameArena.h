@@ -0,0 +1,82 @@
+#ifndef GAME_ARENA_H
+#define GAME_ARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+
+/**
+ * GameArena 类：单局游戏的单调内存池（monotonic buffer）
+ *
+ * - 玩家容器、金字塔结构、卡牌对象本身从所属对局的 arena 中分配
+ * - 释放是空操作，新开一局时由 reset() 一次性回收全部内存
+ * - 初始缓冲区在构造时申请一次并在 reset() 后复用
+ * - 每个 Game 持有自己的 arena，不同线程上的对局之间没有分配器争用
+ *
+ * 覆盖范围：逐步走子的对局循环不分配（tournament --check-no-alloc 检查这一点），
+ * 但时代布局仍走全局堆——卡牌/奇迹的 name、cost 与效果对象（std::string / std::map /
+ * std::function），以及 CardStructure::cards、弃牌堆与已建卡牌列表的 std::vector，
+ * 约每局 130 次分配。
+ *
+ * 注意：reset() 之前必须先销毁所有从该 arena 分配的对象。
+ */
+class GameArena : public std::pmr::memory_resource {
+public:
+    static constexpr std::size_t kDefaultInitialBytes = 64 * 1024;
+
+    explicit GameArena(std::size_t initial_bytes = kDefaultInitialBytes);
+    GameArena(const GameArena&) = delete;
+    GameArena& operator=(const GameArena&) = delete;
+
+    // 一次性回收本局所有内存（保留初始缓冲区）
+    void reset();
+
+    std::size_t bytes_in_use() const { return used_bytes; }
+    std::size_t peak_bytes() const { return peak; }
+    std::size_t capacity() const { return initial_size; }
+
+    /**
+     * Scope：RAII 激活当前线程的 arena
+     * 作用域内通过 ArenaAllocated::operator new 创建的对象从该 arena 分配；
+     * 传入 nullptr 可临时切回全局堆（例如构建全局只读目录时）。
+     */
+    class Scope {
+    public:
+        explicit Scope(GameArena* arena);
+        ~Scope();
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    private:
+        GameArena* previous;
+    };
+
+    // 当前线程激活的 arena（可能为 nullptr）
+    static GameArena* current();
+
+    // 当前线程应使用的 pmr 资源：激活的 arena，否则为默认资源
+    static std::pmr::memory_resource* current_resource();
+
+protected:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+private:
+    std::size_t initial_size;
+    std::unique_ptr<std::byte[]> initial_buffer;
+    std::pmr::monotonic_buffer_resource monotonic;
+    std::size_t used_bytes;
+    std::size_t peak;
+};
+
+/**
+ * ArenaAllocated：为派生类提供类级 operator new/delete
+ * 创建时若当前线程激活了 GameArena 则从中分配，否则走全局堆；
+ * 每个对象前置一个小头记录来源，delete 时据此决定是否真正释放。
+ */
+struct ArenaAllocated {
+    static void* operator new(std::size_t size);
+    static void operator delete(void* p) noexcept;
+};
+
+#endif
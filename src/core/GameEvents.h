@@ -0,0 +1,129 @@
+#ifndef GAME_EVENTS_H
+#define GAME_EVENTS_H
+
+#include <stdexcept>
+#include <type_traits>
+#include <variant>
+#include "Types.h"
+#include "Move.h"
+
+/**
+ * 游戏事件：规则代码只负责发布事件，由订阅者（控制台、日志、统计等）决定如何呈现
+ * 玩家一律用座位号表示（0 = Player 1, 1 = Player 2）
+ */
+struct CardBuilt            { int player; int card_id; Color color; };
+struct CardDiscarded        { int player; int card_id; int coins_gained; };
+struct CoinsChanged         { int player; int delta; int total; };
+struct PawnMoved            { int from; int to; };
+struct LootingTokenConsumed { int player; int coins_lost; };
+struct WonderBuilt          { int player; int wonder_id; };
+struct CardDestroyed        { int player; Color color; };
+struct ExtraTurn            { int player; };
+struct AgeChanged           { int age; };
+struct ProgressTokenOffered { int player; int count; };
+struct DiscardBuildOffered  { int player; };
+struct MoveApplied          { int player; Move move; };   // apply_move 完成（已推进到下一个决策点）
+struct VictoryPointsChanged { int player; int delta; int total; };
+struct ScienceSymbolGained  { int player; Resource symbol; int unique_count; };
+struct EconomyChanged       { int player; };   // 产出、多选一资源或固定交易价变化
+
+using GameEvent = std::variant<CardBuilt, CardDiscarded, CoinsChanged, PawnMoved, LootingTokenConsumed,
+                               WonderBuilt, CardDestroyed, ExtraTurn, AgeChanged,
+                               ProgressTokenOffered, DiscardBuildOffered, MoveApplied,
+                               VictoryPointsChanged, ScienceSymbolGained, EconomyChanged>;
+
+/**
+ * NullSink：无界面/搜索使用的空订阅者
+ * kEnabled = false 的订阅者在 subscribe 时直接被忽略，发布端只剩一次空表判断；
+ * 以 SWD_NO_EVENTS=ON 编译时连这次判断也被去掉。
+ */
+struct NullSink {
+    static constexpr bool kEnabled = false;
+    template <class E> void on(const E&) {}
+};
+
+/**
+ * EventBus 类：类型化事件分发
+ *
+ * 订阅者是任意带 on(const E&) 重载（可用模板兜底）的类型，通过模板参数选定，
+ * 分发时直接调用具体类型的 on()，不经过虚函数表。
+ *
+ * 有意的取舍：订阅者的类型在 subscribe 时选定，而不是作为 Game 的模板参数——那样整个规则引擎
+ * （Game、Player、Board、卡牌效果）都要变成模板并按订阅者组合实例化。发布端因此是一张
+ * 运行时函数指针表（每个订阅者一次间接调用）；需要零开销的两处另有编译期路径：
+ * 模拟驱动 Playout<Policy, Sink> 直接静态调用 Sink，SWD_NO_EVENTS=ON 则把 publish 整个编译掉。
+ *
+ * 订阅表定长，表满时 subscribe 抛出 std::logic_error，不会悄悄丢掉订阅者。
+ * 以 SWD_NO_EVENTS=ON 编译时 publish 是空操作：只有声明了 kPollsWithoutEvents = true、
+ * 会自行按局面补偿的订阅者（HeuristicEval、PonderBot）可以订阅，其余订阅者在 subscribe 时抛出；
+ * 本来就可有可无的订阅者（ConsoleEventLog）应令 kEnabled = EventBus::compiled_in()，随之整体关闭。
+ */
+class EventBus {
+public:
+    static constexpr int kMaxSubscribers = 4;
+
+    static constexpr bool compiled_in() {
+#ifdef SWD_DISABLE_EVENTS
+        return false;
+#else
+        return true;
+#endif
+    }
+
+    template <class Sink>
+    void subscribe(Sink& sink) {
+        if constexpr (Sink::kEnabled) {
+            if (!compiled_in() && !polls_without_events<Sink>::value) {
+                throw std::logic_error("EventBus: events are compiled out (SWD_NO_EVENTS), subscriber would never be called");
+            }
+            if (count >= kMaxSubscribers) throw std::logic_error("EventBus: subscriber table is full");
+            subscribers[count++] = Subscriber{&dispatch<Sink>, &sink};
+        }
+    }
+
+    // 按订阅对象移除
+    void unsubscribe(const void* sink) {
+        for (int i = 0; i < count; ++i) {
+            if (subscribers[i].context == sink) {
+                subscribers[i] = subscribers[--count];
+                return;
+            }
+        }
+    }
+
+    template <class E>
+    void publish(const E& event) const {
+#ifndef SWD_DISABLE_EVENTS
+        if (count == 0) return;
+        const GameEvent wrapped(event);
+        for (int i = 0; i < count; ++i) subscribers[i].handler(subscribers[i].context, wrapped);
+#else
+        (void)event;
+#endif
+    }
+
+    bool has_subscribers() const { return count > 0; }
+
+private:
+    template <class Sink, class = void>
+    struct polls_without_events : std::false_type {};
+    template <class Sink>
+    struct polls_without_events<Sink, std::void_t<decltype(Sink::kPollsWithoutEvents)>>
+        : std::bool_constant<Sink::kPollsWithoutEvents> {};
+
+    struct Subscriber {
+        void (*handler)(void*, const GameEvent&);
+        void* context;
+    };
+
+    template <class Sink>
+    static void dispatch(void* context, const GameEvent& event) {
+        Sink* sink = static_cast<Sink*>(context);
+        std::visit([sink](const auto& e) { sink->on(e); }, event);
+    }
+
+    Subscriber subscribers[kMaxSubscribers] = {};
+    int count = 0;
+};
+
+#endif
@@ -0,0 +1,85 @@
+#include "Move.h"
+#include <cstdlib>
+
+namespace {
+
+const char kTypeLetters[] = {'b', 'd', 'w', 'c', 't', 'r', 'x'};
+
+} // namespace
+
+std::string move_to_text(const Move& move) {
+    std::string text(1, kTypeLetters[static_cast<int>(move.type)]);
+    text += std::to_string(move.pos);
+    if ((move.type == Move::Type::WONDER || move.type == Move::Type::CHOOSE_WONDER) && move.wonder_idx >= 0) {
+        text += '.';
+        text += std::to_string(move.wonder_idx);
+    }
+    return text;
+}
+
+bool parse_move_text(const std::string& text, Move& move) {
+    if (text.size() < 2) return false;
+    int type = -1;
+    for (int i = 0; i < (int)sizeof(kTypeLetters); ++i) {
+        if (text[0] == kTypeLetters[i]) type = i;
+    }
+    if (type < 0) return false;
+
+    const char* begin = text.c_str() + 1;
+    char* end = nullptr;
+    long pos = std::strtol(begin, &end, 10);
+    if (end == begin || pos < 0 || pos > 127) return false;
+
+    long wonder_idx = -1;
+    Move::Type t = static_cast<Move::Type>(type);
+    if (*end == '.') {
+        if (t != Move::Type::WONDER && t != Move::Type::CHOOSE_WONDER) return false;
+        const char* w_begin = end + 1;
+        wonder_idx = std::strtol(w_begin, &end, 10);
+        if (end == w_begin || wonder_idx < 0 || wonder_idx > 127) return false;
+    }
+    if (*end != '\0') return false;
+    if (t == Move::Type::CHOOSE_WONDER && wonder_idx < 0) return false;
+
+    move = Move(t, static_cast<int>(pos), static_cast<int>(wonder_idx));
+    return true;
+}
+
+int move_to_action(const Move& move) {
+    using namespace action_space;
+    auto in = [](int v, int n) { return v >= 0 && v < n; };
+    switch (move.type) {
+        case Move::Type::BUILD:
+            return in(move.pos, rules::kPyramidSlots) ? kBuild + move.pos : -1;
+        case Move::Type::DISCARD:
+            return in(move.pos, rules::kPyramidSlots) ? kDiscard + move.pos : -1;
+        case Move::Type::WONDER:
+            if (!in(move.pos, rules::kPyramidSlots) || !in(move.wonder_idx, rules::kWondersPerPlayer)) return -1;
+            return kWonder + move.pos * rules::kWondersPerPlayer + move.wonder_idx;
+        case Move::Type::CHOOSE_WONDER:
+            return in(move.wonder_idx, rules::kWondersPerPlayer) ? kChooseWonder + move.wonder_idx : -1;
+        case Move::Type::PICK_TOKEN:
+            return in(move.pos, rules::kProgressTokens) ? kPickToken + move.pos : -1;
+        case Move::Type::BUILD_DISCARDED:
+            return in(move.pos, kMaxDiscard) ? kBuildDiscarded + move.pos : -1;
+        case Move::Type::DESTROY_CARD:
+            return in(move.pos, kMaxBuiltCards) ? kDestroyCard + move.pos : -1;
+    }
+    return -1;
+}
+
+bool action_to_move(int action, const Decision& decision, Move& move) {
+    using namespace action_space;
+    if (action < 0 || action >= kCount) return false;
+    if (action < kDiscard) move = Move(Move::Type::BUILD, action - kBuild);
+    else if (action < kWonder) move = Move(Move::Type::DISCARD, action - kDiscard);
+    else if (action < kChooseWonder) {
+        const int a = action - kWonder;
+        move = Move(Move::Type::WONDER, a / rules::kWondersPerPlayer, a % rules::kWondersPerPlayer);
+    }
+    else if (action < kPickToken) move = Move(Move::Type::CHOOSE_WONDER, decision.pos, action - kChooseWonder);
+    else if (action < kBuildDiscarded) move = Move(Move::Type::PICK_TOKEN, action - kPickToken);
+    else if (action < kDestroyCard) move = Move(Move::Type::BUILD_DISCARDED, action - kBuildDiscarded);
+    else move = Move(Move::Type::DESTROY_CARD, action - kDestroyCard);
+    return true;
+}
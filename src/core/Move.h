@@ -0,0 +1,98 @@
+#ifndef MOVE_H
+#define MOVE_H
+
+#include <cstdint>
+#include <string>
+#include "Types.h"
+#include "Rules.h"
+
+/**
+ * Move：一次玩家决策，供无界面驱动（机器人、模拟、工具）与控制台共用
+ *
+ * 回合动作（Decision::PICK_ACTION 时）：
+ * - BUILD   : 建造金字塔 pos 位置的卡牌
+ * - DISCARD : 弃掉 pos 位置的卡牌换钱
+ * - WONDER  : 以 pos 位置的卡牌为地基建造第 wonder_idx 个奇迹；
+ *             wonder_idx 为 -1 时只选定地基，随后进入 CHOOSE_WONDER 决策
+ * 效果触发的后续决策（pos 为所选项的下标/取值）：
+ * - CHOOSE_WONDER   : 为已选定的地基选择第 wonder_idx 个奇迹
+ * - PICK_TOKEN      : 选择进步标记，pos = ProgressToken 取值（大图书馆）
+ * - BUILD_DISCARDED : 免费建造弃牌堆中第 pos 张牌（摩索拉斯王陵墓）
+ * - DESTROY_CARD    : 拆掉对手已建卡牌列表中的第 pos 张（大竞技场 / 宙斯神像）
+ */
+struct Move {
+    enum class Type : uint8_t { BUILD, DISCARD, WONDER, CHOOSE_WONDER, PICK_TOKEN, BUILD_DISCARDED, DESTROY_CARD };
+
+    Type type = Type::BUILD;
+    int8_t pos = -1;
+    int8_t wonder_idx = -1;
+
+    Move() = default;
+    Move(Type t, int p, int w = -1) : type(t), pos(static_cast<int8_t>(p)), wonder_idx(static_cast<int8_t>(w)) {}
+
+    bool operator==(const Move& o) const { return type == o.type && pos == o.pos && wonder_idx == o.wonder_idx; }
+    bool operator!=(const Move& o) const { return !(*this == o); }
+};
+
+/**
+ * Decision：对局当前停在哪个决策点、等待哪位玩家
+ * Game::apply_move 每次推进到下一个决策点后立即返回，不阻塞调用线程，
+ * 因此一个线程可以交替驱动任意多局对局。
+ */
+struct Decision {
+    enum class Type : uint8_t {
+        PICK_ACTION,            // 选牌并选择动作（建造 / 弃牌 / 建奇迹）
+        CHOOSE_WONDER,          // 已选地基，选择要建的奇迹
+        CHOOSE_PROGRESS_TOKEN,  // 从 offered_tokens 中选一个进步标记
+        CHOOSE_DISCARDED_CARD,  // 从弃牌堆中选一张免费建造
+        CHOOSE_CARD_TO_DESTROY, // 选择对手一张 color 颜色的卡牌拆掉
+        GAME_OVER
+    };
+
+    static constexpr int kMaxOfferedTokens = 3;
+
+    Type type = Type::PICK_ACTION;
+    int8_t player = 0;          // 做决策的座位号
+    int8_t pos = -1;            // CHOOSE_WONDER：已选定的地基位置
+    Color color = Color::BROWN; // CHOOSE_CARD_TO_DESTROY：要拆的颜色
+    int8_t offered_count = 0;
+    ProgressToken offered_tokens[kMaxOfferedTokens] = {};
+};
+
+/**
+ * 动作的文本记法（引擎协议、日志与工具共用）：
+ *   b<pos>          BUILD            d<pos>        DISCARD
+ *   w<pos>.<w>      WONDER（w<pos> 只选定地基）   c<pos>.<w>    CHOOSE_WONDER
+ *   t<token>        PICK_TOKEN       r<idx>        BUILD_DISCARDED
+ *   x<idx>          DESTROY_CARD
+ */
+std::string move_to_text(const Move& move);
+// 解析失败返回 false，move 不变
+bool parse_move_text(const std::string& text, Move& move);
+
+/**
+ * 定长动作编号（强化学习环境的动作空间与合法动作掩码共用）：
+ *   [kBuild + pos]                  BUILD            [kDiscard + pos]         DISCARD
+ *   [kWonder + pos * 4 + w]         WONDER           [kChooseWonder + w]      CHOOSE_WONDER（地基取自决策点）
+ *   [kPickToken + token]            PICK_TOKEN       [kBuildDiscarded + idx]  BUILD_DISCARDED
+ *   [kDestroyCard + idx]            DESTROY_CARD
+ */
+namespace action_space {
+constexpr int kBuild = 0;
+constexpr int kMaxDiscard = 80;          // 与 GameSnapshot::kMaxDiscard 一致
+constexpr int kMaxBuiltCards = 64;       // 与 GameSnapshot::kMaxBuiltCards 一致
+constexpr int kDiscard = kBuild + rules::kPyramidSlots;
+constexpr int kWonder = kDiscard + rules::kPyramidSlots;
+constexpr int kChooseWonder = kWonder + rules::kPyramidSlots * rules::kWondersPerPlayer;
+constexpr int kPickToken = kChooseWonder + rules::kWondersPerPlayer;
+constexpr int kBuildDiscarded = kPickToken + rules::kProgressTokens;
+constexpr int kDestroyCard = kBuildDiscarded + kMaxDiscard;
+constexpr int kCount = kDestroyCard + kMaxBuiltCards;
+} // namespace action_space
+
+// 超出动作空间（下标越界或只选地基的 WONDER）时返回 -1
+int move_to_action(const Move& move);
+// 编号无效时返回 false；CHOOSE_WONDER 的地基位置取自 decision.pos
+bool action_to_move(int action, const Decision& decision, Move& move);
+
+#endif
@@ -0,0 +1,18 @@
+#ifndef POSITION_HASH_H
+#define POSITION_HASH_H
+
+#include <cstdint>
+
+/**
+ * 局面哈希的混合函数（splitmix64 终结器）
+ * 各模块的 hash_state(h) 依次把自己的字段混入 h；与顺序无关的集合（如已建卡牌）
+ * 先逐项 hash_mix 再相加，保证同一组卡牌以不同顺序取得时哈希相同
+ */
+inline uint64_t hash_mix(uint64_t h, uint64_t v) {
+    uint64_t z = h ^ (v + 0x9E3779B97F4A7C15ull + (h << 6) + (h >> 2));
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+#endif
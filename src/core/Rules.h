@@ -0,0 +1,43 @@
+#ifndef RULES_H
+#define RULES_H
+
+/**
+ * 规则常量：编译期已知，供规则代码与模拟循环共用
+ * （循环上界、阈值判断因此可以被编译器展开与常量折叠）
+ */
+namespace rules {
+
+constexpr int kPyramidSlots = 20;        // 每时代金字塔布局的卡牌数
+constexpr int kAges = 3;
+constexpr int kWondersPerPlayer = 4;
+constexpr int kMaxWondersBuilt = 7;      // 双方合计最多建成 7 座奇迹，第 8 座随之作废
+constexpr int kProgressTokens = 10;
+
+// 冲突棋子：0 = P2 军事压制，18 = P1 军事压制，9 为中点
+constexpr int kPawnMin = 0;
+constexpr int kPawnMax = 18;
+constexpr int kPawnStart = 9;
+
+// 掠夺标记：棋子进入对应区域时一次性扣对手金币
+struct LootingToken {
+    int victim;     // 被扣金币的座位号
+    int threshold;  // 触发位置（P1 侧为 <=，P2 侧为 >=）
+    int coins;
+};
+constexpr LootingToken kLootingTokens[4] = {
+    {0, 6, 2}, {0, 3, 5},     // P1 侧
+    {1, 12, 2}, {1, 15, 5},   // P2 侧
+};
+
+// 军事得分阶梯：棋子越过中点的距离 -> 胜利分
+constexpr int kMilitaryTier1Distance = 2, kMilitaryTier1Points = 2;
+constexpr int kMilitaryTier2Distance = 5, kMilitaryTier2Points = 5;
+constexpr int kMilitaryTier3Points = 10;
+
+constexpr int kScienceSupremacy = 6;     // 不同科技符号数达到即获胜
+
+static_assert(kPawnStart * 2 == kPawnMax, "pawn track must be symmetric");
+
+} // namespace rules
+
+#endif
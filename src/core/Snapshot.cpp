@@ -0,0 +1,30 @@
+#include "Snapshot.h"
+#include "Move.h"
+#include <cstdio>
+
+const GameSnapshot* view_snapshot(const void* data, std::size_t length) {
+    if (data == nullptr || length < sizeof(GameSnapshot)) return nullptr;
+    // mmap 返回页对齐地址，调用方自行保证偏移按 alignof(GameSnapshot) 对齐
+    const GameSnapshot* snap = static_cast<const GameSnapshot*>(data);
+    return snap->is_valid() ? snap : nullptr;
+}
+
+bool write_snapshot_file(const std::string& path, const GameSnapshot& snap) {
+    std::FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f) return false;
+    bool ok = std::fwrite(&snap, sizeof(GameSnapshot), 1, f) == 1;
+    ok = (std::fclose(f) == 0) && ok;
+    return ok;
+}
+
+bool read_snapshot_file(const std::string& path, GameSnapshot& snap) {
+    std::FILE* f = std::fopen(path.c_str(), "rb");
+    if (!f) return false;
+    bool ok = std::fread(&snap, sizeof(GameSnapshot), 1, f) == 1;
+    std::fclose(f);
+    return ok && snap.is_valid();
+}
+
+// 动作空间按快照容量划定弃牌堆 / 已建卡牌下标的范围
+static_assert(GameSnapshot::kMaxDiscard == action_space::kMaxDiscard, "action space must cover the discard pile");
+static_assert(GameSnapshot::kMaxBuiltCards == action_space::kMaxBuiltCards, "action space must cover built cards");
@@ -0,0 +1,117 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <type_traits>
+#include "Rules.h"
+
+/**
+ * GameSnapshot：一局游戏的完整二进制快照
+ *
+ * 设计要点：
+ * - 定长、无指针、可平凡拷贝：一次 read() 或 mmap 即可得到完整对象，无需逐字段解析
+ * - 卡牌/奇迹以目录下标（Card::id / Wonder::id）保存，Lambda 效果在加载时从目录克隆恢复
+ * - 字节序为本机序（x86-64 小端），文件头带魔数与版本号，版本不匹配时拒绝加载
+ * - 多个快照可以首尾相接写入同一文件，mmap 后按 sizeof(GameSnapshot) 步进访问
+ */
+struct GameSnapshot {
+    static constexpr uint32_t kMagic = 0x53445753;   // "SWDS"
+    static constexpr uint16_t kVersion = 3;       // v3：奇迹地基；v2：待决策状态与进步标记
+    static constexpr uint8_t kEmpty = 0xFF;          // 空槽位 / 无卡
+
+    static constexpr int kSlots = rules::kPyramidSlots; // 每时代金字塔槽位数
+    static constexpr int kMaxDiscard = 80;
+    static constexpr int kMaxBuiltCards = 64;
+    static constexpr int kMaxWildcards = 16;
+    static constexpr int kMaxWonders = 8;
+    static constexpr int kResourceCount = 14;        // Resource::WOOD .. Resource::LAW
+    static constexpr int kColorCount = 7;
+    static constexpr int kMaxProgressTokens = 10;
+
+    struct PlayerState {
+        char name[24];
+        uint8_t type;                                // PlayerType
+        uint8_t built_wonders_count;
+        uint8_t wonder_count;
+        uint8_t wildcard_count;
+        uint8_t built_card_count;
+        uint8_t pad_;
+        uint16_t progress_tokens;                    // 按 ProgressToken 取位
+        int16_t coins;
+        int16_t military_tokens;
+        int16_t victory_points;
+        uint16_t science_symbols;                    // 按 Resource 取位
+        uint32_t link_symbols;                       // 按 LinkSymbol 取位
+        uint8_t resources[kResourceCount];
+        uint8_t fixed_trade_costs[kResourceCount];   // 0 = 未设置（默认 2）
+        uint8_t cards_by_color[kColorCount];
+        uint8_t pad2_;
+        uint16_t wildcards[kMaxWildcards];           // 每个多选一资源的选项位集
+        uint8_t wonders[kMaxWonders];                // 奇迹目录下标
+        uint8_t wonder_built[kMaxWonders];
+        uint8_t wonder_foundation[kMaxWonders];      // 压在已建奇迹下的地基牌（卡牌目录下标，kEmpty = 未建）
+        uint8_t built_cards[kMaxBuiltCards];         // 已建卡牌（卡牌目录下标，用于恢复名称）
+    };
+
+    // --- 文件头 ---
+    uint32_t magic;
+    uint16_t version;
+    uint16_t reserved;
+    uint32_t size;                                   // sizeof(GameSnapshot)，用于校验
+    uint32_t pad_;
+    uint64_t seed;                                   // 发牌种子（决定后续时代的牌序）
+
+    // --- 回合状态 ---
+    uint8_t current_age;
+    uint8_t current_player;
+    uint8_t game_over;
+    uint8_t extra_turn;
+
+    // --- 待决策（见 core/Move.h 的 Decision）---
+    uint8_t decision_type;
+    uint8_t decision_player;
+    int8_t decision_pos;
+    uint8_t decision_color;
+    uint8_t offered_token_count;
+    uint8_t offered_tokens[3];
+
+    // --- 版图 ---
+    uint8_t pawn_position;
+    uint8_t looting_tokens[4];
+    uint8_t board_token_count;
+    uint8_t board_tokens[kMaxProgressTokens];
+    uint8_t pool_token_count;
+    uint8_t pool_tokens[kMaxProgressTokens];
+
+    // --- 金字塔 ---
+    uint8_t structure_age;
+    uint8_t slots[kSlots];                           // 卡牌目录下标，kEmpty 表示已被取走
+    uint32_t face_up_mask;                           // 第 i 位 = 槽位 i 正面朝上
+
+    // --- 弃牌堆 ---
+    uint8_t discard_count;
+    uint8_t discard[kMaxDiscard];
+
+    PlayerState players[2];
+
+    // 校验文件头（魔数、版本、大小）
+    bool is_valid() const {
+        return magic == kMagic && version == kVersion && size == sizeof(GameSnapshot);
+    }
+};
+
+static_assert(std::is_trivially_copyable<GameSnapshot>::value, "GameSnapshot must stay POD for read()/mmap");
+
+/**
+ * 零拷贝视图：校验一段内存（如 mmap 映射的文件）并直接返回快照指针
+ * @return 校验失败时返回 nullptr
+ */
+const GameSnapshot* view_snapshot(const void* data, std::size_t length);
+
+// 单次 write()/read() 存取快照文件
+bool write_snapshot_file(const std::string& path, const GameSnapshot& snap);
+bool read_snapshot_file(const std::string& path, GameSnapshot& snap);
+
+#endif
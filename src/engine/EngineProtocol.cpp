@@ -0,0 +1,230 @@
+#include "EngineProtocol.h"
+#include "core/Game.h"
+#include "core/Board.h"
+#include "player/Player.h"
+#include <algorithm>
+#include <cstdio>
+#include <ostream>
+
+namespace {
+
+const char* decision_name(Decision::Type type) {
+    switch (type) {
+        case Decision::Type::PICK_ACTION:            return "pick_action";
+        case Decision::Type::CHOOSE_WONDER:          return "choose_wonder";
+        case Decision::Type::CHOOSE_PROGRESS_TOKEN:  return "choose_progress_token";
+        case Decision::Type::CHOOSE_DISCARDED_CARD:  return "choose_discarded_card";
+        case Decision::Type::CHOOSE_CARD_TO_DESTROY: return "choose_card_to_destroy";
+        case Decision::Type::GAME_OVER:              return "game_over";
+    }
+    return "unknown";
+}
+
+constexpr int64_t kDefaultMovetimeMs = 1000;
+
+} // namespace
+
+EngineProtocol::EngineProtocol(std::ostream& out) : out(out), game(std::make_unique<Game>()) {
+    game->init(1);
+    searcher.set_position(*game);
+    moves.reserve(256);
+}
+
+EngineProtocol::~EngineProtocol() {
+    stop_search();
+}
+
+void EngineProtocol::send(const std::string& line) {
+    std::lock_guard<std::mutex> lock(out_mutex);
+    out << line << std::endl;
+}
+
+void EngineProtocol::stop_search() {
+    searcher.stop();
+    searcher.wait();
+}
+
+void EngineProtocol::shutdown() {
+    if (infinite) searcher.stop();
+    searcher.wait();
+}
+
+bool EngineProtocol::handle(const std::string& line) {
+    std::istringstream args(line);
+    std::string cmd;
+    if (!(args >> cmd)) return true;
+
+    if (cmd == "quit") {
+        stop_search();
+        return false;
+    }
+    if (cmd == "stop") {
+        stop_search();
+        return true;
+    }
+    if (cmd == "isready") {
+        send("readyok");
+        return true;
+    }
+    if (cmd == "swd") {
+        send("id name SevenWondersDuel");
+        send("id protocol 1");
+        send("swdok");
+        return true;
+    }
+
+    // 其余命令会读取或修改局面，先结束正在进行的搜索
+    stop_search();
+    if (cmd == "position") cmd_position(args);
+    else if (cmd == "move") cmd_move(args);
+    else if (cmd == "go") cmd_go(args);
+    else if (cmd == "d") cmd_show();
+    else if (cmd == "moves") {
+        game->legal_moves(moves);
+        std::string reply = "moves";
+        for (const Move& m : moves) reply += " " + move_to_text(m);
+        send(reply);
+    } else if (cmd == "setoption") {
+        std::string name;
+        args >> name;
+        int value = 0;
+        std::string path;
+        std::string error;
+        if (name == "threads" && args >> value && value > 0) {
+            searcher.set_threads(value);
+            searcher.set_position(*game);
+        } else if (name == "rollout" && args >> value && value >= 0) {
+            rollout_moves = value;
+            searcher.set_evaluation(eval_weights, rollout_moves);
+        } else if (name == "evalfile" && args >> path) {
+            EvalWeights loaded = eval_weights;
+            if (loaded.load(path, &error)) {
+                eval_weights = loaded;
+                searcher.set_evaluation(eval_weights, rollout_moves);
+            } else {
+                send("error " + error);
+            }
+        } else if (name == "bookfile" && args >> path) {
+            if (!book.open(path, &error)) send("error " + error);
+        } else {
+            send("error usage: setoption threads <N> | rollout <N> | evalfile <path> | bookfile <path>");
+        }
+    } else {
+        send("error unknown command " + cmd);
+    }
+    return true;
+}
+
+void EngineProtocol::cmd_position(std::istringstream& args) {
+    std::string word;
+    uint64_t seed = 0;
+    if (!(args >> word) || word != "seed" || !(args >> seed)) {
+        send("error usage: position seed <S> [moves m1 m2 ...]");
+        return;
+    }
+    auto next = std::make_unique<Game>();
+    next->init(seed);
+    if (args >> word) {
+        if (word != "moves") {
+            send("error expected 'moves', got " + word);
+            return;
+        }
+        while (args >> word) {
+            Move m;
+            if (!parse_move_text(word, m) || !next->apply_move(m)) {
+                send("error illegal move " + word);
+                return;
+            }
+        }
+    }
+    game = std::move(next);
+    searcher.set_position(*game);
+}
+
+void EngineProtocol::cmd_move(std::istringstream& args) {
+    std::string text;
+    Move m;
+    if (!(args >> text) || !parse_move_text(text, m) || !game->apply_move(m)) {
+        send("error illegal move " + text);
+        return;
+    }
+    // 搜索树移到新局面，已有的统计继续使用
+    if (!searcher.advance(m)) searcher.set_position(*game);
+    send("ok");
+}
+
+void EngineProtocol::cmd_go(std::istringstream& args) {
+    SearchLimits limits;
+    infinite = false;
+    std::string word;
+    while (args >> word) {
+        if (word == "movetime" || word == "nodes") {
+            int64_t value = 0;
+            if (!(args >> value) || value < 0) {
+                send("error usage: go [movetime <ms>] [nodes <N>] [infinite]");
+                return;
+            }
+            if (word == "movetime") limits.movetime_ms = value;
+            else limits.nodes = static_cast<uint64_t>(value);
+        } else if (word == "infinite") infinite = true;
+        else {
+            send("error unknown go parameter " + word);
+            return;
+        }
+    }
+    if (book.is_open() && !infinite && send_book_move()) return;
+    if (!infinite && limits.movetime_ms <= 0 && limits.nodes == 0) limits.movetime_ms = kDefaultMovetimeMs;
+    if (infinite) limits = SearchLimits{};
+
+    searcher.start(limits,
+        [this](const SearchResult& r) {
+            send(format_info(r));
+            send(std::string("bestmove ") + (r.has_move ? move_to_text(r.best) : "none"));
+        },
+        [this](const SearchResult& r) { send(format_info(r)); });
+}
+
+bool EngineProtocol::send_book_move() {
+    Move best;
+    if (!book.best_move(*game, best)) return false;
+    // 库按可见局面索引：哈希碰撞或旧库都可能给出当前决策点不合法的动作，此时照常搜索
+    game->legal_moves(moves);
+    if (std::find(moves.begin(), moves.end(), best) == moves.end()) return false;
+    std::vector<BookMove> entries;
+    book.probe(*game, entries);
+    for (const BookMove& m : entries) {
+        if (!(m.move == best)) continue;
+        char buf[96];
+        std::snprintf(buf, sizeof(buf), "info book visits %u winrate %.3f pv ", m.visits,
+                      static_cast<double>(m.wins) / m.visits);
+        send(buf + move_to_text(best));
+    }
+    send("bestmove " + move_to_text(best));
+    return true;
+}
+
+void EngineProtocol::cmd_show() {
+    const Decision& d = game->get_decision();
+    const Player& p1 = game->get_player(0);
+    const Player& p2 = game->get_player(1);
+    char buf[256];
+    std::snprintf(buf, sizeof(buf),
+                  "decision %s player %d age %d pawn %d coins %d %d vp %d %d hash %016llx",
+                  decision_name(d.type), d.player + 1, game->get_current_age(),
+                  game->get_board()->get_pawn_position(), p1.get_coins(), p2.get_coins(),
+                  p1.get_victory_points(), p2.get_victory_points(),
+                  static_cast<unsigned long long>(game->position_hash()));
+    send(buf);
+    if (game->is_over()) send("winner " + std::to_string(game->get_winner() + 1));
+}
+
+std::string EngineProtocol::format_info(const SearchResult& r) {
+    char buf[160];
+    const uint64_t nps = r.elapsed_ms > 0 ? r.nodes * 1000 / r.elapsed_ms : r.nodes;
+    std::snprintf(buf, sizeof(buf), "info nodes %llu time %lld nps %llu winrate %.3f pv",
+                  static_cast<unsigned long long>(r.nodes), static_cast<long long>(r.elapsed_ms),
+                  static_cast<unsigned long long>(nps), r.win_rate);
+    std::string line = buf;
+    for (const Move& m : r.pv) line += " " + move_to_text(m);
+    return line;
+}
@@ -0,0 +1,70 @@
+#ifndef ENGINE_PROTOCOL_H
+#define ENGINE_PROTOCOL_H
+
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "ai/OpeningBook.h"
+#include "ai/Search.h"
+
+class Game;
+
+/**
+ * EngineProtocol 类：面向外部工具的行式文本协议（仿 UCI）
+ *
+ * 每行一条命令，应答写到构造时传入的输出流：
+ *   swd                               -> id name ... / swdok
+ *   isready                           -> readyok
+ *   position seed <S> [moves m1 m2 ...]   以种子开局并依次走出 moves
+ *   moves                             -> moves <当前决策点的全部合法动作>
+ *   move <m>                          走一步（搜索树随之移根），-> ok
+ *   d                                 -> 当前决策点与局面摘要
+ *   setoption threads <N>
+ *   setoption rollout <N>             模拟随机走 N 步后改用静态评估（0 = 走到终局，默认）
+ *   setoption evalfile <path>         从文件载入评估权重（格式见 ai/HeuristicEval.h）
+ *   setoption bookfile <path>         打开开局库（见 ai/OpeningBook.h，按可见局面查询）；此后 go 先查库，
+ *                                     命中合法动作时 -> info book visits <n> winrate <p> / bestmove <m>，不再搜索
+ *   go [movetime <ms>] [nodes <N>] [infinite]
+ *                                     后台搜索；约每秒一行 info，结束时
+ *                                     -> info ... winrate <p> pv ... / bestmove <m>
+ *   stop                              结束当前搜索（随即输出 bestmove）
+ *   quit
+ * 动作记法见 core/Move.h；出错时输出 "error ..."，状态不变。
+ *
+ * 搜索在后台线程进行，handle() 立即返回，协议循环始终可以响应 stop。
+ */
+class EngineProtocol {
+public:
+    explicit EngineProtocol(std::ostream& out);
+    ~EngineProtocol();
+
+    // 处理一行命令；收到 quit 时返回 false
+    bool handle(const std::string& line);
+    // 输入结束：等待有限制的搜索完成，无限搜索则直接停止
+    void shutdown();
+
+private:
+    void cmd_position(std::istringstream& args);
+    void cmd_move(std::istringstream& args);
+    void cmd_go(std::istringstream& args);
+    void cmd_show();
+    bool send_book_move();   // 当前局面在开局库中有合格动作时直接应答
+    void stop_search();
+    void send(const std::string& line);
+    static std::string format_info(const SearchResult& r);
+
+    std::ostream& out;
+    std::mutex out_mutex;          // 搜索线程也会输出 info / bestmove
+    std::unique_ptr<Game> game;
+    Searcher searcher;
+    std::vector<Move> moves;
+    EvalWeights eval_weights;
+    int rollout_moves = 0;
+    OpeningBook book;
+    bool infinite = false;
+};
+
+#endif
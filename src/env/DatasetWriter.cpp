@@ -0,0 +1,184 @@
+#include "DatasetWriter.h"
+#include "core/Game.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+// ===== Producer =====
+
+DatasetWriter::Producer::Producer(DatasetWriter* owner)
+    : owner(owner), encoder(std::make_unique<ObservationEncoder>()) {
+    chunk.reserve(static_cast<std::size_t>(owner->options.records_per_chunk) * kRecordBytes);
+}
+
+DatasetWriter::Producer::Producer(Producer&& other) noexcept
+    : owner(std::exchange(other.owner, nullptr)),
+      encoder(std::move(other.encoder)),
+      game_records(std::move(other.game_records)),
+      chunk(std::move(other.chunk)),
+      chunk_records(std::exchange(other.chunk_records, 0)) {}
+
+DatasetWriter::Producer::~Producer() {
+    if (owner) flush();
+}
+
+void DatasetWriter::Producer::record(const Game& game, const Move& move) {
+    const std::size_t at = game_records.size();
+    game_records.resize(at + kRecordBytes);
+    uint8_t* rec = game_records.data() + at;
+
+    encoder->encode(game, reinterpret_cast<int8_t*>(rec));
+    const int16_t action = static_cast<int16_t>(move_to_action(move));
+    std::memcpy(rec + ObservationEncoder::kSize, &action, sizeof(action));
+    rec[ObservationEncoder::kSize + 2] = 0;   // 结果在 end_game 时补上
+    rec[ObservationEncoder::kSize + 3] = static_cast<uint8_t>(game.get_decision().player);
+}
+
+void DatasetWriter::Producer::end_game(int winner) {
+    const int per_chunk = owner->options.records_per_chunk;
+    for (std::size_t at = 0; at < game_records.size(); at += kRecordBytes) {
+        uint8_t* rec = game_records.data() + at;
+        const int player = rec[ObservationEncoder::kSize + 3];
+        rec[ObservationEncoder::kSize + 2] = static_cast<uint8_t>(static_cast<int8_t>(player == winner ? 1 : -1));
+        chunk.insert(chunk.end(), rec, rec + kRecordBytes);
+        if (++chunk_records == per_chunk) flush();
+    }
+    game_records.clear();
+}
+
+void DatasetWriter::Producer::flush() {
+    if (chunk_records == 0) return;
+    owner->submit(chunk, chunk_records);
+    chunk_records = 0;
+}
+
+// ===== DatasetWriter =====
+
+DatasetWriter::DatasetWriter(const Options& opts) : options(opts) {
+    if (options.records_per_chunk <= 0 || options.records_per_shard <= 0) {
+        throw std::invalid_argument("DatasetWriter: chunk and shard sizes must be positive");
+    }
+    writer = std::thread(&DatasetWriter::writer_loop, this);
+}
+
+DatasetWriter::~DatasetWriter() {
+    close();
+}
+
+bool DatasetWriter::close() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        closing = true;
+    }
+    ready.notify_one();
+    if (writer.joinable()) writer.join();
+    std::lock_guard<std::mutex> lock(mutex);
+    return error.empty();
+}
+
+DatasetWriter::Stats DatasetWriter::get_stats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
+
+std::string DatasetWriter::get_error() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return error;
+}
+
+// 把生产者的块换成一块空闲缓冲区还给它（容量保留），稳态下不分配内存
+void DatasetWriter::submit(std::vector<uint8_t>& bytes, int records) {
+    std::unique_ptr<Chunk> chunk;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (closing) throw std::logic_error("DatasetWriter: submit after close()");
+        if (!free_chunks.empty()) {
+            chunk = std::move(free_chunks.back());
+            free_chunks.pop_back();
+        }
+    }
+    if (!chunk) chunk = std::make_unique<Chunk>();
+    chunk->bytes.swap(bytes);
+    chunk->records = records;
+    bytes.clear();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        queue.push_back(std::move(chunk));
+        stats.peak_queued = std::max(stats.peak_queued, static_cast<int>(queue.size()));
+    }
+    ready.notify_one();
+}
+
+void DatasetWriter::writer_loop() {
+    for (;;) {
+        std::unique_ptr<Chunk> chunk;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            ready.wait(lock, [&] { return closing || !queue.empty(); });
+            if (queue.empty()) break;
+            chunk = std::move(queue.front());
+            queue.pop_front();
+        }
+        write_chunk(*chunk);
+        std::lock_guard<std::mutex> lock(mutex);
+        free_chunks.push_back(std::move(chunk));
+    }
+    if (file) {
+        if (std::fclose(file) != 0) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (error.empty()) error = "failed to close shard";
+        }
+        file = nullptr;
+    }
+}
+
+void DatasetWriter::write_chunk(const Chunk& chunk) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!error.empty()) return;
+    }
+    if (!file || (shard_records > 0 && shard_records + chunk.records > options.records_per_shard)) open_next_shard();
+
+    const uint32_t header[2] = {static_cast<uint32_t>(chunk.records), 0};
+    bool ok = file && std::fwrite(header, sizeof(header), 1, file) == 1 &&
+              std::fwrite(chunk.bytes.data(), 1, chunk.bytes.size(), file) == chunk.bytes.size();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!ok) {
+        if (error.empty()) error = "failed to write shard in " + options.directory;
+        return;
+    }
+    shard_records += chunk.records;
+    stats.records += chunk.records;
+    stats.chunks++;
+}
+
+void DatasetWriter::open_next_shard() {
+    if (file) std::fclose(file);
+    char name[32];
+    int index;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        index = stats.shards;   // 只有写线程修改，打开成功后才计数
+    }
+    std::snprintf(name, sizeof(name), "-%05d.swds", index);
+    const std::string path = options.directory + "/" + options.prefix + name;
+    file = std::fopen(path.c_str(), "wb");
+    shard_records = 0;
+    if (!file) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stats.shards++;
+    }
+
+    FileHeader header{};
+    std::memcpy(header.magic, "SWDD", 4);
+    header.version = kVersion;
+    header.feature_count = ObservationEncoder::kSize;
+    header.record_bytes = kRecordBytes;
+    if (std::fwrite(&header, sizeof(header), 1, file) != 1) {
+        std::fclose(file);
+        file = nullptr;
+    }
+}
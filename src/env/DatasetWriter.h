@@ -0,0 +1,121 @@
+#ifndef DATASET_WRITER_H
+#define DATASET_WRITER_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "core/Move.h"
+#include "ObservationEncoder.h"
+
+class Game;
+
+/**
+ * DatasetWriter 类：把自对弈产生的 (特征, 动作, 结果) 记录流式写入分块的二进制分片文件
+ *
+ * - 每个自对弈线程持有自己的 Producer：记录先在线程本地暂存，一局结束时补上结果，
+ *   凑满一个块后交给后台写线程；提交只在队列上短暂加锁，不等待磁盘
+ * - 空闲块循环复用；写线程跟不上时临时新建块（内存增长，生产者仍不阻塞），peak_queued 记录积压
+ * - 分片文件 <dir>/<prefix>-00000.swds 起依次编号，每片至多 records_per_shard 条记录
+ *
+ * 文件格式（小端）：
+ *   文件头 FileHeader，随后若干块；每块为 uint32 记录数 + uint32 保留，再接定长记录
+ *   记录：int8 features[ObservationEncoder::kSize]，int16 action（action_space 编号），
+ *        int8 outcome（该记录行动方 +1 胜 / -1 负），uint8 player（行动方座位号）
+ */
+class DatasetWriter {
+public:
+    struct Options {
+        std::string directory = ".";
+        std::string prefix = "shard";
+        int records_per_chunk = 1024;
+        int64_t records_per_shard = 1 << 20;
+    };
+
+    struct FileHeader {
+        char magic[4];          // "SWDD"（"SWDS" 已是 GameSnapshot 的魔数）
+        uint16_t version;
+        uint16_t reserved;
+        uint32_t feature_count;
+        uint32_t record_bytes;
+    };
+    static constexpr uint16_t kVersion = 1;
+    static constexpr int kRecordBytes = ObservationEncoder::kSize + 4;
+
+    struct Stats {
+        int64_t records = 0;
+        int64_t chunks = 0;
+        int shards = 0;
+        int peak_queued = 0;    // 等待写盘的块数峰值
+    };
+
+    // 每个自对弈线程一个；自身不是线程安全的
+    class Producer {
+    public:
+        ~Producer();
+        Producer(Producer&& other) noexcept;
+        Producer& operator=(Producer&&) = delete;
+
+        // 在动作应用之前调用：编码当前局面并暂存 (特征, 动作)
+        void record(const Game& game, const Move& move);
+        // 一局结束：按胜者补齐本局各记录的结果并提交
+        void end_game(int winner);
+        // 丢弃本局未提交的记录
+        void discard_game() { game_records.clear(); }
+
+    private:
+        friend class DatasetWriter;
+        explicit Producer(DatasetWriter* owner);
+        void flush();
+
+        DatasetWriter* owner;
+        std::unique_ptr<ObservationEncoder> encoder;
+        std::vector<uint8_t> game_records;   // 本局暂存（结果未知）
+        std::vector<uint8_t> chunk;          // 正在填充的块（不含块头）
+        int chunk_records = 0;
+    };
+
+    explicit DatasetWriter(const Options& options);
+    ~DatasetWriter();
+    DatasetWriter(const DatasetWriter&) = delete;
+    DatasetWriter& operator=(const DatasetWriter&) = delete;
+
+    Producer make_producer() { return Producer(this); }
+    // 等待已提交的块全部写盘并关闭文件（析构时自动调用）；之后不能再提交。
+    // 写盘出错时返回 false，错误见 get_error()
+    bool close();
+    std::string get_error() const;
+    Stats get_stats() const;
+
+private:
+    struct Chunk {
+        std::vector<uint8_t> bytes;
+        int records = 0;
+    };
+
+    void submit(std::vector<uint8_t>& bytes, int records);
+    void writer_loop();
+    void write_chunk(const Chunk& chunk);
+    void open_next_shard();
+
+    Options options;
+    mutable std::mutex mutex;
+    std::condition_variable ready;
+    std::deque<std::unique_ptr<Chunk>> queue;
+    std::vector<std::unique_ptr<Chunk>> free_chunks;
+    bool closing = false;
+    Stats stats;
+    std::string error;   // 首个写盘错误；出错后丢弃后续块
+
+    // 以下只由写线程访问
+    std::FILE* file = nullptr;
+    int64_t shard_records = 0;
+    std::thread writer;
+};
+
+#endif
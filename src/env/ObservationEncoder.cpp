@@ -0,0 +1,121 @@
+#include "ObservationEncoder.h"
+#include "core/Game.h"
+#include "cards/Card.h"
+#include "cards/CardStructure.h"
+#include "cards/Wonder.h"
+#include "player/CostCalculator.h"
+#include "player/Player.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+
+constexpr uint16_t kRawChoice = (1u << (int)Resource::WOOD) | (1u << (int)Resource::CLAY) | (1u << (int)Resource::STONE);
+
+template <typename T>
+T clamp_value(int v);
+
+template <>
+float clamp_value<float>(int v) { return static_cast<float>(v); }
+
+template <>
+int8_t clamp_value<int8_t>(int v) { return static_cast<int8_t>(std::min(127, std::max(-128, v))); }
+
+} // namespace
+
+ObservationEncoder::ObservationEncoder() {
+    // 特征布局与目录大小绑定：目录变化时必须同步调整（旧数据集随之失效）
+    if ((int)card_catalog().size() != kCardIds || (int)wonder_catalog().size() != kWonderIds) {
+        throw std::logic_error("ObservationEncoder: feature layout does not match the card/wonder catalogs");
+    }
+}
+
+void ObservationEncoder::encode(const Game& game, float* out) { encode_impl(game, out); }
+void ObservationEncoder::encode(const Game& game, int8_t* out) { encode_impl(game, out); }
+
+template <typename T>
+void ObservationEncoder::encode_impl(const Game& game, T* out) {
+    std::fill(out, out + kSize, T(0));
+    auto set = [&](int idx, int v) { out[idx] = clamp_value<T>(v); };
+
+    game.save_snapshot(snapshot);
+    const int me = game.get_decision().player;
+    const int opp = 1 - me;
+
+    if (snapshot.current_age >= 1 && snapshot.current_age <= rules::kAges) set(kAge + snapshot.current_age - 1, 1);
+    if (snapshot.decision_type < kDecisionTypes) set(kDecision + snapshot.decision_type, 1);
+    if (snapshot.decision_type == static_cast<uint8_t>(Decision::Type::CHOOSE_WONDER) &&
+        snapshot.decision_pos >= 0 && snapshot.decision_pos < rules::kPyramidSlots) {
+        set(kPendingSlot + snapshot.decision_pos, 1);
+    }
+
+    // 金字塔：背面牌不泄露身份
+    const CardStructure& structure = game.get_structure();
+    for (int p = 0; p < rules::kPyramidSlots; ++p) {
+        if (snapshot.slots[p] == GameSnapshot::kEmpty) continue;
+        if ((snapshot.face_up_mask >> p) & 1u) set(kSlotCard + p * kCardIds + snapshot.slots[p], 1);
+        else set(kSlotHidden + p, 1);
+        if (structure.is_accessible(p)) set(kSlotAccessible + p, 1);
+    }
+
+    const int seats[2] = {me, opp};
+    for (int side = 0; side < 2; ++side) {
+        const int seat = seats[side];
+        const GameSnapshot::PlayerState& ps = snapshot.players[seat];
+        const int base = kPlayers + side * kPlayerSize;
+        set(base + kCoins, ps.coins);
+        set(base + kVictoryPoints, ps.victory_points);
+        for (int r = 0; r < 5; ++r) set(base + kProduction + r, ps.resources[r]);
+
+        int raw = 0, manufactured = 0;
+        for (int i = 0; i < std::min<int>(ps.wildcard_count, GameSnapshot::kMaxWildcards); ++i) {
+            if (ps.wildcards[i] & kRawChoice) raw++;
+            else manufactured++;
+        }
+        set(base + kWildRaw, raw);
+        set(base + kWildManufactured, manufactured);
+
+        const Player& buyer = game.get_player(seat);
+        const Player& seller = game.get_player(1 - seat);
+        for (int r = 0; r < 5; ++r) {
+            set(base + kTradePrice + r, CostCalculator::calculate_trade_cost(buyer, seller, static_cast<Resource>(r)));
+        }
+        for (int s = 0; s < 7; ++s) {
+            if ((ps.science_symbols >> ((int)Resource::COMPASS + s)) & 1u) set(base + kScience + s, 1);
+        }
+        for (int c = 0; c < 7; ++c) set(base + kColorCount + c, ps.cards_by_color[c]);
+        for (int t = 0; t < rules::kProgressTokens; ++t) {
+            if ((ps.progress_tokens >> t) & 1u) set(base + kProgressTokens + t, 1);
+        }
+        for (int l = 0; l < kChainSymbols; ++l) {
+            if ((ps.link_symbols >> (l + 1)) & 1u) set(base + kChain + l, 1);
+        }
+        for (int w = 0; w < std::min<int>(ps.wonder_count, rules::kWondersPerPlayer); ++w) {
+            const int slot = base + kWonders + w * kWonderStride;
+            if (ps.wonders[w] < kWonderIds) set(slot + ps.wonders[w], 1);
+            set(slot + kWonderIds, ps.wonder_built[w] ? 1 : 0);
+        }
+        for (int i = 0; i < std::min<int>(ps.built_card_count, kListedCards); ++i) {
+            set(base + kBuiltCards + i, ps.built_cards[i] + 1);
+        }
+    }
+
+    // 棋子：0 = P2 压制，18 = P1 压制；翻转后 18 总是我方压制
+    const int pawn = std::min<int>(snapshot.pawn_position, rules::kPawnMax);
+    set(kPawn + (me == 0 ? pawn : rules::kPawnMax - pawn), 1);
+
+    // 掠夺标记按受害方排列：先我方被扣的两枚，再对方的两枚
+    int mine = 0, theirs = 0;
+    for (int i = 0; i < 4; ++i) {
+        const rules::LootingToken& token = rules::kLootingTokens[i];
+        const int idx = token.victim == me ? mine++ : 2 + theirs++;
+        set(kLooting + idx, snapshot.looting_tokens[i] ? 1 : 0);
+    }
+
+    for (int i = 0; i < std::min<int>(snapshot.board_token_count, rules::kProgressTokens); ++i) {
+        if (snapshot.board_tokens[i] < rules::kProgressTokens) set(kBoardTokens + snapshot.board_tokens[i], 1);
+    }
+    for (int i = 0; i < std::min<int>(snapshot.discard_count, kListedCards); ++i) {
+        set(kDiscard + i, snapshot.discard[i] + 1);
+    }
+}
@@ -0,0 +1,81 @@
+#ifndef OBSERVATION_ENCODER_H
+#define OBSERVATION_ENCODER_H
+
+#include <cstddef>
+#include <cstdint>
+#include "core/Rules.h"
+#include "core/Snapshot.h"
+
+class Game;
+
+/**
+ * ObservationEncoder 类：把局面编码成定长特征向量（训练数据与网络评估共用）
+ *
+ * 以当前做决策的一方为视角，“我方”在前、“对方”在后，双方座位因此对称。
+ * 各段为 0/1 标志或小整数计数，float 与 int8 两种输出的数值相同（int8 截断到 [-128, 127]）：
+ *   age[3]  decision[6]
+ *   pending_slot[20]    CHOOSE_WONDER 决策时已选定的地基槽位（独热）
+ *   slot_card[20][72]   只对正面朝上的牌给出卡牌编号（独热），背面牌只在 slot_hidden 置位
+ *   slot_hidden[20]  slot_accessible[20]
+ *   player[2] × { coins, vp, production[5], wild_raw, wild_manufactured, trade_price[5],
+ *                 science[7], color_count[7], progress_tokens[10], chain[22],
+ *                 wonders[4] × { id[12], built },
+ *                 built_cards[60] }   按建造顺序的卡牌编号 + 1（0 = 空）
+ *   pawn[19]     按我方视角翻转，18 为我方军事压制
+ *   looting[4]   我方小、我方大、对方小、对方大（仍在版图上的为 1）
+ *   board_tokens[10]
+ *   discard[60]  按弃牌堆顺序的卡牌编号 + 1（0 = 空）
+ * 已建卡牌与弃牌堆以编号序列给出而不是独热：顺序本身有意义（最近弃掉的牌在后），也省去 2 × 72 维。
+ */
+class ObservationEncoder {
+public:
+    static constexpr int kCardIds = 72;
+    static constexpr int kWonderIds = 12;
+    static constexpr int kChainSymbols = 22;   // LinkSymbol::SWORD .. LinkSymbol::CAPITOL
+    static constexpr int kDecisionTypes = 6;
+    static constexpr int kListedCards = rules::kAges * rules::kPyramidSlots;   // 一局发出的牌数，已建 / 弃牌序列的上限
+
+    static constexpr int kAge = 0;
+    static constexpr int kDecision = kAge + rules::kAges;
+    static constexpr int kPendingSlot = kDecision + kDecisionTypes;
+    static constexpr int kSlotCard = kPendingSlot + rules::kPyramidSlots;
+    static constexpr int kSlotHidden = kSlotCard + rules::kPyramidSlots * kCardIds;
+    static constexpr int kSlotAccessible = kSlotHidden + rules::kPyramidSlots;
+    static constexpr int kPlayers = kSlotAccessible + rules::kPyramidSlots;
+
+    // 玩家段内偏移
+    static constexpr int kCoins = 0;
+    static constexpr int kVictoryPoints = 1;
+    static constexpr int kProduction = 2;
+    static constexpr int kWildRaw = kProduction + 5;
+    static constexpr int kWildManufactured = kWildRaw + 1;
+    static constexpr int kTradePrice = kWildManufactured + 1;
+    static constexpr int kScience = kTradePrice + 5;
+    static constexpr int kColorCount = kScience + 7;
+    static constexpr int kProgressTokens = kColorCount + 7;
+    static constexpr int kChain = kProgressTokens + rules::kProgressTokens;
+    static constexpr int kWonders = kChain + kChainSymbols;
+    static constexpr int kWonderStride = kWonderIds + 1;
+    static constexpr int kBuiltCards = kWonders + rules::kWondersPerPlayer * kWonderStride;
+    static constexpr int kPlayerSize = kBuiltCards + kListedCards;
+
+    static constexpr int kPawn = kPlayers + 2 * kPlayerSize;
+    static constexpr int kLooting = kPawn + rules::kPawnMax + 1;
+    static constexpr int kBoardTokens = kLooting + 4;
+    static constexpr int kDiscard = kBoardTokens + rules::kProgressTokens;
+    static constexpr int kSize = kDiscard + kListedCards;
+
+    ObservationEncoder();
+
+    // out 至少 kSize 个元素；视角为 game.get_decision().player
+    void encode(const Game& game, float* out);
+    void encode(const Game& game, int8_t* out);
+
+private:
+    template <typename T>
+    void encode_impl(const Game& game, T* out);
+
+    GameSnapshot snapshot;   // 复用的暂存，编码不分配内存
+};
+
+#endif
@@ -0,0 +1,173 @@
+#include "VecEnv.h"
+#include "core/Game.h"
+#include "instrument/Tracer.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+VecEnv::VecEnv(int num_envs, int num_threads) {
+    if (num_envs <= 0) throw std::invalid_argument("VecEnv: num_envs must be positive");
+    slots.resize(num_envs);
+    for (int i = 0; i < num_envs; ++i) {
+        slots[i].game = std::make_unique<Game>();
+        slots[i].next_seed = static_cast<uint64_t>(i);
+    }
+
+    const int shards = std::max(1, std::min(num_threads, num_envs));
+    illegal_counts.assign(shards, 0);
+    errors.assign(shards, nullptr);
+    for (int t = 1; t < shards; ++t) workers.emplace_back(&VecEnv::worker_loop, this, t);
+}
+
+VecEnv::~VecEnv() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& t : workers) t.join();
+}
+
+void VecEnv::bind(const Buffers& buffers) {
+    if (!buffers.obs || !buffers.legal_mask || !buffers.rewards || !buffers.dones || !buffers.to_play) {
+        throw std::invalid_argument("VecEnv: all output buffers must be bound");
+    }
+    out = buffers;
+}
+
+void VecEnv::reset(const uint64_t* seeds) {
+    if (!out.obs) throw std::logic_error("VecEnv: reset() before bind()");
+    op_seeds = seeds;
+    run(Op::RESET);
+}
+
+int VecEnv::step(const int32_t* actions) {
+    if (!out.obs) throw std::logic_error("VecEnv: step() before bind()");
+    if (!actions) throw std::invalid_argument("VecEnv: actions must not be null");
+    op_actions = actions;
+    run(Op::STEP);
+    int illegal = 0;
+    for (int n : illegal_counts) illegal += n;
+    return illegal;
+}
+
+// ===== 线程分段 =====
+
+void VecEnv::run(Op op) {
+    const int shards = static_cast<int>(illegal_counts.size());
+    if (shards > 1) {
+        std::lock_guard<std::mutex> lock(mutex);
+        current_op = op;
+        pending_workers = shards - 1;
+        generation++;
+    }
+    wake.notify_all();
+
+    run_shard(op, 0);
+    if (shards > 1) {
+        std::unique_lock<std::mutex> lock(mutex);
+        finished.wait(lock, [&] { return pending_workers == 0; });
+    }
+    for (std::exception_ptr& error : errors) {
+        if (error) {
+            std::exception_ptr first = error;
+            std::fill(errors.begin(), errors.end(), nullptr);
+            std::rethrow_exception(first);
+        }
+    }
+}
+
+void VecEnv::run_shard(Op op, int shard) {
+    SWD_TRACE_SCOPE_ARG("env_shard", shard);
+    try {
+        run_range(op, shard);
+    } catch (...) {
+        errors[shard] = std::current_exception();
+    }
+}
+
+void VecEnv::worker_loop(int shard) {
+    uint64_t seen = 0;
+    for (;;) {
+        Op op;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&] { return stopping || generation != seen; });
+            if (stopping) return;
+            seen = generation;
+            op = current_op;
+        }
+        run_shard(op, shard);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--pending_workers == 0) finished.notify_one();
+        }
+    }
+}
+
+void VecEnv::run_range(Op op, int shard) {
+    const int64_t n = size(), shards = static_cast<int64_t>(illegal_counts.size());
+    const int begin = static_cast<int>(n * shard / shards);
+    const int end = static_cast<int>(n * (shard + 1) / shards);
+    int illegal = 0;
+    for (int i = begin; i < end; ++i) {
+        if (op == Op::RESET) {
+            if (op_seeds) slots[i].next_seed = op_seeds[i];
+            reset_slot(i);
+            out.rewards[i] = 0.0f;
+            out.dones[i] = 0;
+            write_outputs(i);
+        } else {
+            if (!step_slot(i, op_actions[i])) illegal++;
+        }
+    }
+    illegal_counts[shard] = illegal;
+}
+
+// ===== 单局 =====
+
+void VecEnv::reset_slot(int i) {
+    Slot& slot = slots[i];
+    slot.game->init(slot.next_seed);
+    slot.next_seed += static_cast<uint64_t>(size());
+}
+
+bool VecEnv::step_slot(int i, int32_t action) {
+    Slot& slot = slots[i];
+    Game& game = *slot.game;
+    const int actor = game.get_decision().player;
+
+    Move move;
+    const bool legal = action_to_move(action, game.get_decision(), move) && game.apply_move(move);
+    float reward = 0.0f;
+    bool done = false;
+    if (!legal) {
+        reward = -1.0f;
+        done = true;
+    } else if (game.is_over()) {
+        reward = game.get_winner() == actor ? 1.0f : -1.0f;
+        done = true;
+    }
+
+    out.rewards[i] = reward;
+    out.dones[i] = done ? 1 : 0;
+    if (done) reset_slot(i);
+    write_outputs(i);
+    return legal;
+}
+
+void VecEnv::write_outputs(int i) {
+    Slot& slot = slots[i];
+    Game& game = *slot.game;
+
+    slot.encoder.encode(game, out.obs + static_cast<std::size_t>(i) * kObsSize);
+
+    uint8_t* mask = out.legal_mask + static_cast<std::size_t>(i) * kNumActions;
+    std::memset(mask, 0, kNumActions);
+    game.legal_moves(slot.legal);
+    for (const Move& m : slot.legal) {
+        const int a = move_to_action(m);
+        if (a >= 0) mask[a] = 1;
+    }
+    out.to_play[i] = game.get_decision().player;
+}
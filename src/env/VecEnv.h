@@ -0,0 +1,98 @@
+#ifndef VEC_ENV_H
+#define VEC_ENV_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "core/Move.h"
+#include "env/ObservationEncoder.h"
+
+class Game;
+
+/**
+ * VecEnv 类：N 局并排的强化学习环境，供训练循环成批推进
+ *
+ * - 观测为 ObservationEncoder 的 int8 特征（kObsSize 个，布局见 env/ObservationEncoder.h），
+ *   以下一步做决策的一方为视角；只含该方看得到的信息（不含种子、背面牌身份与盒中进步标记），
+ *   动作为 action_space 中的定长编号（见 core/Move.h），合法动作掩码每个动作一个字节
+ * - 输出直接写入调用方用 bind() 绑定的连续缓冲区（第 i 局占第 i 行），
+ *   宿主语言可以把同一块内存当作数组读取，不需要逐局拷贝
+ * - 局终自动重开：done[i] 置 1，reward[i] 给出结果，obs[i] 已经是新一局的开局局面；
+ *   第 i 局依次使用种子 seed_i, seed_i + N, seed_i + 2N, ...
+ * - 各局按区间分给固定的工作线程（调用线程负责第一段），每次 reset/step 唤醒一轮
+ *
+ * reward[i] 是本步做决策一方的收益：赢 +1，输 -1，未结束为 0。
+ * 非法动作按该方判负处理（reward -1 并重开），step() 返回非法动作的个数。
+ * 任一段抛出的异常先记下，等所有段结束后再在调用线程重新抛出（多段同时出错时抛第一段的），
+ * 工作线程不会因此退出，也不会在其他段还在写缓冲区时提前返回。
+ */
+class VecEnv {
+public:
+    static constexpr int kNumActions = action_space::kCount;
+    static constexpr int kObsSize = ObservationEncoder::kSize;
+
+    struct Buffers {
+        int8_t* obs = nullptr;          // [N][kObsSize]
+        uint8_t* legal_mask = nullptr;  // [N][kNumActions]
+        float* rewards = nullptr;       // [N]
+        uint8_t* dones = nullptr;       // [N]
+        int32_t* to_play = nullptr;     // [N] 下一步做决策的座位号
+    };
+
+    VecEnv(int num_envs, int num_threads);
+    ~VecEnv();
+    VecEnv(const VecEnv&) = delete;
+    VecEnv& operator=(const VecEnv&) = delete;
+
+    int size() const { return static_cast<int>(slots.size()); }
+    // 绑定输出缓冲区；之后的 reset/step 都写入这里，五个缓冲区都不能为空
+    void bind(const Buffers& buffers);
+    // 全部对局按 seeds[i] 开局（seeds 为空时沿用各局的下一个种子）
+    void reset(const uint64_t* seeds);
+    // actions[i] 为第 i 局当前决策点的动作编号；返回非法动作的个数
+    int step(const int32_t* actions);
+
+private:
+    struct Slot {
+        std::unique_ptr<Game> game;
+        uint64_t next_seed = 0;
+        std::vector<Move> legal;
+        ObservationEncoder encoder;
+    };
+
+    enum class Op { RESET, STEP };
+
+    void run(Op op);
+    void run_range(Op op, int shard);   // 第 shard 段：[N * shard / 段数, N * (shard + 1) / 段数)
+    void run_shard(Op op, int shard);   // run_range 并把异常记入 errors[shard]
+    void worker_loop(int shard);
+    void reset_slot(int i);
+    bool step_slot(int i, int32_t action);
+    void write_outputs(int i);
+
+    std::vector<Slot> slots;
+    Buffers out;
+
+    // 本轮参数（run() 期间只读）
+    const uint64_t* op_seeds = nullptr;
+    const int32_t* op_actions = nullptr;
+    std::vector<int> illegal_counts;   // 每个工作段一个计数
+    std::vector<std::exception_ptr> errors;   // 每个工作段本轮抛出的异常
+
+    // 工作线程：第 0 段由调用线程执行，其余各段一个线程
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable finished;
+    uint64_t generation = 0;
+    int pending_workers = 0;
+    Op current_op = Op::RESET;
+    bool stopping = false;
+};
+
+#endif
@@ -0,0 +1,197 @@
+#include "AllocTracker.h"
+#include <atomic>
+#include <cstdlib>
+#include <iomanip>
+#include <mutex>
+#include <new>
+#include <ostream>
+
+namespace {
+
+constexpr int kPhaseCount = static_cast<int>(AllocPhase::COUNT);
+constexpr int kMaxThreads = 256;
+
+// 单写者计数器：只有所属线程写入，relaxed 读写即可，不需要原子 RMW
+struct PhaseCounters {
+    std::atomic<uint64_t> allocs{0};
+    std::atomic<uint64_t> frees{0};
+    std::atomic<uint64_t> bytes{0};
+};
+
+struct ThreadStats {
+    PhaseCounters phases[kPhaseCount];
+    AllocPhase phase = AllocPhase::OTHER;
+    int slot = -1;
+};
+
+inline void bump(std::atomic<uint64_t>& c, uint64_t v) {
+    c.store(c.load(std::memory_order_relaxed) + v, std::memory_order_relaxed);
+}
+
+std::mutex registry_mutex;
+ThreadStats* registry[kMaxThreads] = {};
+PhaseCounters retired[kPhaseCount];          // 已退出线程 + 注册表溢出的线程
+std::atomic<int64_t> live_bytes{0};
+std::atomic<int64_t> peak_live_bytes{0};
+
+thread_local ThreadStats thread_stats;
+
+// 线程退出时把计数并入 retired，并从注册表摘除
+struct ThreadGuard {
+    ~ThreadGuard() {
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        if (thread_stats.slot < 0) return;
+        for (int p = 0; p < kPhaseCount; ++p) {
+            retired[p].allocs += thread_stats.phases[p].allocs.load(std::memory_order_relaxed);
+            retired[p].frees += thread_stats.phases[p].frees.load(std::memory_order_relaxed);
+            retired[p].bytes += thread_stats.phases[p].bytes.load(std::memory_order_relaxed);
+        }
+        registry[thread_stats.slot] = nullptr;
+        thread_stats.slot = kMaxThreads;  // 退出后的零星分配不再计入
+    }
+};
+
+ThreadStats& local_stats() {
+    ThreadStats& s = thread_stats;
+    if (s.slot < 0) {
+        // thread_local 的析构注册走 calloc，不会递归进入 operator new
+        static thread_local ThreadGuard guard;
+        (void)guard;
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        s.slot = kMaxThreads;
+        for (int i = 0; i < kMaxThreads; ++i) {
+            if (!registry[i]) { registry[i] = &s; s.slot = i; break; }
+        }
+    }
+    return s;
+}
+
+void accumulate(AllocTracker::Counters& dst, const PhaseCounters& src) {
+    dst.allocs += src.allocs.load(std::memory_order_relaxed);
+    dst.frees += src.frees.load(std::memory_order_relaxed);
+    dst.bytes += src.bytes.load(std::memory_order_relaxed);
+}
+
+#ifdef SWD_ENABLE_ALLOC_TRACKING
+// 每块内存前置 16 字节记录大小，用于释放时维护常驻量
+constexpr std::size_t kHeader = 16;
+
+void* tracked_alloc(std::size_t size) noexcept {
+    void* raw = std::malloc(size + kHeader);
+    if (!raw) return nullptr;
+    *static_cast<std::size_t*>(raw) = size;
+
+    ThreadStats& s = local_stats();
+    PhaseCounters& c = s.phases[static_cast<int>(s.phase)];
+    bump(c.allocs, 1);
+    bump(c.bytes, size);
+
+    int64_t live = live_bytes.fetch_add(static_cast<int64_t>(size), std::memory_order_relaxed) + static_cast<int64_t>(size);
+    int64_t peak = peak_live_bytes.load(std::memory_order_relaxed);
+    while (live > peak && !peak_live_bytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+    return static_cast<char*>(raw) + kHeader;
+}
+
+void tracked_free(void* p) noexcept {
+    if (!p) return;
+    void* raw = static_cast<char*>(p) - kHeader;
+    std::size_t size = *static_cast<std::size_t*>(raw);
+
+    ThreadStats& s = local_stats();
+    bump(s.phases[static_cast<int>(s.phase)].frees, 1);
+    live_bytes.fetch_sub(static_cast<int64_t>(size), std::memory_order_relaxed);
+    std::free(raw);
+}
+#endif
+
+} // namespace
+
+#ifdef SWD_ENABLE_ALLOC_TRACKING
+// --- 全局 operator new/delete 替换（仅在开启统计时编译） ---
+void* operator new(std::size_t size) {
+    void* p = tracked_alloc(size);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+void* operator new[](std::size_t size) {
+    void* p = tracked_alloc(size);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return tracked_alloc(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return tracked_alloc(size); }
+void operator delete(void* p) noexcept { tracked_free(p); }
+void operator delete[](void* p) noexcept { tracked_free(p); }
+void operator delete(void* p, std::size_t) noexcept { tracked_free(p); }
+void operator delete[](void* p, std::size_t) noexcept { tracked_free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { tracked_free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { tracked_free(p); }
+#endif
+
+AllocTracker::Report AllocTracker::collect() {
+    Report report;
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    for (int p = 0; p < kPhaseCount; ++p) {
+        accumulate(report.phases[p], retired[p]);
+        for (int i = 0; i < kMaxThreads; ++i) {
+            if (registry[i]) accumulate(report.phases[p], registry[i]->phases[p]);
+        }
+        report.total.allocs += report.phases[p].allocs;
+        report.total.frees += report.phases[p].frees;
+        report.total.bytes += report.phases[p].bytes;
+    }
+    report.live_bytes = live_bytes.load(std::memory_order_relaxed);
+    report.peak_live_bytes = peak_live_bytes.load(std::memory_order_relaxed);
+    return report;
+}
+
+AllocTracker::Counters AllocTracker::thread_counters(AllocPhase phase) {
+    Counters c;
+    accumulate(c, local_stats().phases[static_cast<int>(phase)]);
+    return c;
+}
+
+void AllocTracker::reset_peak() {
+    peak_live_bytes.store(live_bytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+const char* AllocTracker::phase_name(AllocPhase phase) {
+    switch (phase) {
+        case AllocPhase::OTHER:     return "other";
+        case AllocPhase::AGE_SETUP: return "age_setup";
+        case AllocPhase::TAKE_CARD: return "take_card";
+        case AllocPhase::EFFECT:    return "effect";
+        case AllocPhase::COST:      return "cost";
+        case AllocPhase::RENDER:    return "render";
+        default:                    return "?";
+    }
+}
+
+void AllocTracker::print_report(std::ostream& os, const Report& report) {
+    os << "\n=== Allocation Report ===\n";
+    if (!compiled_in()) {
+        os << "(allocation tracking not compiled in; configure with -DSWD_ALLOC_TRACKING=ON)\n";
+        return;
+    }
+    os << std::left << std::setw(12) << "phase" << std::right
+       << std::setw(14) << "allocs" << std::setw(14) << "frees" << std::setw(16) << "bytes" << "\n";
+    for (int p = 0; p < kPhaseCount; ++p) {
+        const Counters& c = report.phases[p];
+        os << std::left << std::setw(12) << phase_name(static_cast<AllocPhase>(p)) << std::right
+           << std::setw(14) << c.allocs << std::setw(14) << c.frees << std::setw(16) << c.bytes << "\n";
+    }
+    os << std::left << std::setw(12) << "total" << std::right
+       << std::setw(14) << report.total.allocs << std::setw(14) << report.total.frees
+       << std::setw(16) << report.total.bytes << "\n";
+    os << "live bytes: " << report.live_bytes << " | peak live bytes: " << report.peak_live_bytes << "\n";
+}
+
+AllocTracker::PhaseScope::PhaseScope(AllocPhase phase) {
+    ThreadStats& s = local_stats();
+    previous = s.phase;
+    s.phase = phase;
+}
+
+AllocTracker::PhaseScope::~PhaseScope() {
+    thread_stats.phase = previous;
+}
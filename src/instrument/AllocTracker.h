@@ -0,0 +1,84 @@
+#ifndef ALLOC_TRACKER_H
+#define ALLOC_TRACKER_H
+
+#include <cstdint>
+#include <iosfwd>
+
+/**
+ * 引擎阶段：内存分配按当前线程所处的阶段归类
+ */
+enum class AllocPhase : uint8_t {
+    OTHER,       // 未标注的代码（驱动程序、工具等）
+    AGE_SETUP,   // 开局与时代布局（发奇迹、洗牌、构建金字塔）
+    TAKE_CARD,   // CardStructure::take_card
+    EFFECT,      // 卡牌与奇迹效果
+    COST,        // CostCalculator 成本计算
+    RENDER,      // 控制台渲染
+    COUNT
+};
+
+/**
+ * AllocTracker 类：可选的全局内存分配统计
+ *
+ * 使用 CMake 选项 SWD_ALLOC_TRACKING=ON 编译时，会替换全局 operator new/delete，
+ * 统计分配次数、字节数与峰值常驻内存，并按 AllocPhase 归类；
+ * 未开启时所有 SWD_ALLOC_PHASE 标注都被编译掉，operator new 保持标准实现。
+ *
+ * 计数器按线程存放（仅所属线程写入），汇总时加锁遍历，热路径上没有共享写。
+ */
+class AllocTracker {
+public:
+    struct Counters {
+        uint64_t allocs = 0;
+        uint64_t frees = 0;
+        uint64_t bytes = 0;   // 累计申请字节数
+    };
+
+    struct Report {
+        Counters phases[static_cast<int>(AllocPhase::COUNT)];
+        Counters total;
+        int64_t live_bytes = 0;
+        int64_t peak_live_bytes = 0;
+    };
+
+    // 是否编译了统计功能（SWD_ALLOC_TRACKING）
+    static constexpr bool compiled_in() {
+#ifdef SWD_ENABLE_ALLOC_TRACKING
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    // 汇总所有线程（含已退出线程）的计数
+    static Report collect();
+    // 当前线程在某阶段的计数（用于精确检查某段循环是否分配）
+    static Counters thread_counters(AllocPhase phase);
+    // 把峰值重置为当前常驻量，便于分段测量
+    static void reset_peak();
+
+    static void print_report(std::ostream& os, const Report& report);
+    static const char* phase_name(AllocPhase phase);
+
+    // RAII：在作用域内切换当前线程的分配阶段
+    class PhaseScope {
+    public:
+        explicit PhaseScope(AllocPhase phase);
+        ~PhaseScope();
+        PhaseScope(const PhaseScope&) = delete;
+        PhaseScope& operator=(const PhaseScope&) = delete;
+    private:
+        AllocPhase previous;
+    };
+};
+
+#define SWD_ALLOC_CONCAT_(a, b) a##b
+#define SWD_ALLOC_CONCAT(a, b) SWD_ALLOC_CONCAT_(a, b)
+
+#ifdef SWD_ENABLE_ALLOC_TRACKING
+#define SWD_ALLOC_PHASE(phase) AllocTracker::PhaseScope SWD_ALLOC_CONCAT(swd_alloc_phase_, __LINE__)(phase)
+#else
+#define SWD_ALLOC_PHASE(phase) ((void)0)
+#endif
+
+#endif
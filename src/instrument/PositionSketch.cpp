@@ -0,0 +1,112 @@
+#include "PositionSketch.h"
+#include "core/Game.h"
+#include "core/Board.h"
+#include "player/Player.h"
+#include <iomanip>
+#include <ostream>
+
+namespace {
+
+// 模式键：kind | age | a | b 各占 8 位，原样作为报告中的描述
+enum PatternKind : uint64_t {
+    SCIENCE = 1,    // 双方不同科技符号数
+    WONDERS = 2,    // 双方已建奇迹数
+    MILITARY = 3,   // 冲突棋子位置
+    TREASURY = 4,   // 双方金币（每 5 枚一档）
+};
+
+uint64_t pattern_key(PatternKind kind, int age, int a, int b) {
+    return static_cast<uint64_t>(kind) << 24 | static_cast<uint64_t>(age & 0xFF) << 16 |
+           static_cast<uint64_t>(a & 0xFF) << 8 | static_cast<uint64_t>(b & 0xFF);
+}
+
+// 高频局面随键保存的摘要，报告时用来描述该局面
+uint64_t pack_summary(const Game& game) {
+    const Player& p1 = game.get_player(0);
+    const Player& p2 = game.get_player(1);
+    auto clamp8 = [](int v) { return static_cast<uint64_t>(v < 0 ? 0 : (v > 255 ? 255 : v)); };
+    return clamp8(game.get_current_age()) | clamp8(game.get_board()->get_pawn_position()) << 8 |
+           clamp8(p1.get_coins()) << 16 | clamp8(p2.get_coins()) << 24 |
+           clamp8(p1.get_victory_points()) << 32 | clamp8(p2.get_victory_points()) << 40 |
+           clamp8((int)p1.get_built_card_names().size()) << 48 | clamp8((int)p2.get_built_card_names().size()) << 56;
+}
+
+const char* kAgeNames[] = {"-", "I", "II", "III", "IV"};
+
+} // namespace
+
+PositionSketch::PositionSketch(int top_k)
+    : position_counts(4, 16), position_distinct(14), position_top(top_k),
+      pattern_counts(4, 12), pattern_distinct(12), pattern_top(top_k) {}
+
+void PositionSketch::observe(const Game& game) {
+    uint64_t h = game.position_hash();
+    uint32_t est = position_counts.add(h);
+    position_distinct.add(h);
+    position_top.offer(h, est, pack_summary(game));
+
+    const int age = game.get_current_age();
+    const Player& p1 = game.get_player(0);
+    const Player& p2 = game.get_player(1);
+    observe_pattern(pattern_key(SCIENCE, age, p1.get_unique_science_count(), p2.get_unique_science_count()));
+    observe_pattern(pattern_key(WONDERS, age, p1.count_wonder_stages(), p2.count_wonder_stages()));
+    observe_pattern(pattern_key(MILITARY, age, game.get_board()->get_pawn_position(), 0));
+    observe_pattern(pattern_key(TREASURY, age, p1.get_coins() / 5, p2.get_coins() / 5));
+}
+
+void PositionSketch::observe_pattern(uint64_t pattern) {
+    uint32_t est = pattern_counts.add(pattern);
+    pattern_distinct.add(pattern);
+    pattern_top.offer(pattern, est, pattern);
+}
+
+void PositionSketch::merge(const PositionSketch& other) {
+    position_counts.merge(other.position_counts);
+    position_distinct.merge(other.position_distinct);
+    position_top.merge(other.position_top, position_counts);
+    pattern_counts.merge(other.pattern_counts);
+    pattern_distinct.merge(other.pattern_distinct);
+    pattern_top.merge(other.pattern_top, pattern_counts);
+}
+
+void PositionSketch::print_report(std::ostream& os, int top) const {
+    const std::size_t memory = position_counts.memory_bytes() + position_distinct.memory_bytes() +
+                               pattern_counts.memory_bytes() + pattern_distinct.memory_bytes();
+    os << "=== Position Sketch ===\n";
+    os << "observations: " << position_counts.total()
+       << " | distinct positions ~" << static_cast<uint64_t>(position_distinct.estimate())
+       << " | distinct patterns ~" << static_cast<uint64_t>(pattern_distinct.estimate())
+       << " | sketch memory: " << memory / 1024 << " KB\n";
+
+    os << "top positions (count is an upper bound):\n";
+    os << std::setw(10) << "count" << "  age pawn  coins    vp   cards\n";
+    int shown = 0;
+    for (const auto& e : position_top.top()) {
+        if (shown++ >= top) break;
+        uint64_t s = e.payload;
+        auto field = [s](int i) { return static_cast<int>((s >> (8 * i)) & 0xFF); };
+        os << std::setw(10) << e.count << "  " << std::setw(3) << kAgeNames[std::min(field(0), 4)]
+           << std::setw(5) << field(1) << std::setw(4) << field(2) << "/" << std::setw(2) << field(3)
+           << std::setw(4) << field(4) << "/" << std::setw(2) << field(5)
+           << std::setw(4) << field(6) << "/" << field(7) << "\n";
+    }
+
+    os << "top patterns:\n";
+    shown = 0;
+    for (const auto& e : pattern_top.top()) {
+        if (shown++ >= top) break;
+        int kind = static_cast<int>(e.payload >> 24);
+        int age = static_cast<int>((e.payload >> 16) & 0xFF);
+        int a = static_cast<int>((e.payload >> 8) & 0xFF);
+        int b = static_cast<int>(e.payload & 0xFF);
+        os << std::setw(10) << e.count << "  Age " << kAgeNames[std::min(age, 4)] << ": ";
+        switch (kind) {
+            case SCIENCE:  os << "unique science symbols P1=" << a << " P2=" << b; break;
+            case WONDERS:  os << "wonders built P1=" << a << " P2=" << b; break;
+            case MILITARY: os << "conflict pawn at " << a; break;
+            case TREASURY: os << "coins P1=" << a * 5 << "-" << a * 5 + 4 << " P2=" << b * 5 << "-" << b * 5 + 4; break;
+            default:       os << "pattern " << e.payload; break;
+        }
+        os << "\n";
+    }
+}
@@ -0,0 +1,41 @@
+#ifndef POSITION_SKETCH_H
+#define POSITION_SKETCH_H
+
+#include <cstdint>
+#include <iosfwd>
+#include "Sketch.h"
+
+class Game;
+
+/**
+ * PositionSketch 类：统计自对弈中局面与取牌模式的重复情况，内存固定
+ *
+ * - 驱动循环每走一步调用一次 observe()，对完整局面（金字塔与翻面、双方玩家、版图）求哈希，
+ *   送入 CountMinSketch（频次）、HyperLogLog（不同局面数）与前 K 高频表
+ * - 同时提取若干粗粒度“模式”键（如“第二时代双方各有 3 种科技符号”）做同样统计
+ * - 每个线程一份（可同时喂入该线程交替推进的多局），结束时 merge() 后输出报告
+ */
+class PositionSketch {
+public:
+    explicit PositionSketch(int top_k = 32);
+
+    void observe(const Game& game);
+    void merge(const PositionSketch& other);
+    void print_report(std::ostream& os, int top = 10) const;
+
+    uint64_t observations() const { return position_counts.total(); }
+    double distinct_positions() const { return position_distinct.estimate(); }
+
+private:
+    void observe_pattern(uint64_t pattern);
+
+    CountMinSketch position_counts;
+    HyperLogLog position_distinct;
+    HeavyHitters position_top;
+
+    CountMinSketch pattern_counts;
+    HyperLogLog pattern_distinct;
+    HeavyHitters pattern_top;
+};
+
+#endif
@@ -0,0 +1,175 @@
+#include "Profiler.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <mutex>
+#include <ostream>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr int kPointCount = static_cast<int>(ProfilePoint::COUNT);
+
+// 单写者直方图：只有所属线程写入，relaxed 读写即可
+struct AtomicHistogram {
+    std::atomic<uint64_t> count{0};
+    std::atomic<uint64_t> total_ticks{0};
+    std::atomic<uint64_t> max_ticks{0};
+    std::atomic<uint64_t> buckets[Profiler::kBuckets] = {};
+};
+
+inline void bump(std::atomic<uint64_t>& c, uint64_t v) {
+    c.store(c.load(std::memory_order_relaxed) + v, std::memory_order_relaxed);
+}
+
+void merge(Profiler::Histogram& dst, const AtomicHistogram& src) {
+    dst.count += src.count.load(std::memory_order_relaxed);
+    dst.total_ticks += src.total_ticks.load(std::memory_order_relaxed);
+    dst.max_ticks = std::max(dst.max_ticks, src.max_ticks.load(std::memory_order_relaxed));
+    for (int b = 0; b < Profiler::kBuckets; ++b) dst.buckets[b] += src.buckets[b].load(std::memory_order_relaxed);
+}
+
+void merge(Profiler::Histogram& dst, const Profiler::Histogram& src) {
+    dst.count += src.count;
+    dst.total_ticks += src.total_ticks;
+    dst.max_ticks = std::max(dst.max_ticks, src.max_ticks);
+    for (int b = 0; b < Profiler::kBuckets; ++b) dst.buckets[b] += src.buckets[b];
+}
+
+struct ThreadHistograms;
+
+std::mutex registry_mutex;
+std::vector<ThreadHistograms*> registry;
+Profiler::Histogram retired[kPointCount];
+
+struct ThreadHistograms {
+    AtomicHistogram points[kPointCount];
+
+    ThreadHistograms() {
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        registry.push_back(this);
+    }
+    ~ThreadHistograms() {
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        for (int p = 0; p < kPointCount; ++p) merge(retired[p], points[p]);
+        registry.erase(std::remove(registry.begin(), registry.end(), this), registry.end());
+    }
+};
+
+ThreadHistograms& local_histograms() {
+    static thread_local ThreadHistograms histograms;
+    return histograms;
+}
+
+inline int bucket_of(uint64_t ticks) {
+    int b = 63 - __builtin_clzll(ticks | 1);
+    return std::min(b, Profiler::kBuckets - 1);
+}
+
+} // namespace
+
+void Profiler::record(ProfilePoint point, uint64_t ticks) {
+    AtomicHistogram& h = local_histograms().points[static_cast<int>(point)];
+    bump(h.count, 1);
+    bump(h.total_ticks, ticks);
+    if (ticks > h.max_ticks.load(std::memory_order_relaxed)) h.max_ticks.store(ticks, std::memory_order_relaxed);
+    bump(h.buckets[bucket_of(ticks)], 1);
+}
+
+Profiler::Report Profiler::collect() {
+    Report report;
+    {
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        for (int p = 0; p < kPointCount; ++p) {
+            merge(report.points[p], retired[p]);
+            for (const ThreadHistograms* t : registry) merge(report.points[p], t->points[p]);
+        }
+    }
+    report.ns_per_tick = ns_per_tick();
+    return report;
+}
+
+double Profiler::ns_per_tick() {
+    static const double ratio = [] {
+        auto t0 = std::chrono::steady_clock::now();
+        uint64_t c0 = now_ticks();
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        uint64_t c1 = now_ticks();
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count();
+        return (c1 > c0) ? ns / static_cast<double>(c1 - c0) : 1.0;
+    }();
+    return ratio;
+}
+
+double Profiler::percentile_ns(const Histogram& h, double q, double ns_per_tick) {
+    if (h.count == 0) return 0.0;
+    uint64_t target = static_cast<uint64_t>(q * static_cast<double>(h.count));
+    uint64_t seen = 0;
+    for (int b = 0; b < kBuckets; ++b) {
+        seen += h.buckets[b];
+        if (seen > target) return static_cast<double>(2ull << b) * ns_per_tick;
+    }
+    return static_cast<double>(h.max_ticks) * ns_per_tick;
+}
+
+const char* Profiler::point_name(ProfilePoint point) {
+    switch (point) {
+        case ProfilePoint::COST_CALC:       return "cost_calc";
+        case ProfilePoint::TAKE_CARD:       return "take_card";
+        case ProfilePoint::APPLY_EFFECT:    return "apply_effect";
+        case ProfilePoint::WONDER_EFFECT:   return "wonder_effect";
+        case ProfilePoint::MOVE_GEN:        return "move_gen";
+        case ProfilePoint::SEARCH_SELECT:   return "search_select";
+        case ProfilePoint::SEARCH_EXPAND:   return "search_expand";
+        case ProfilePoint::SEARCH_ROLLOUT:  return "search_rollout";
+        case ProfilePoint::SEARCH_BACKPROP: return "search_backprop";
+        default:                            return "?";
+    }
+}
+
+void Profiler::print_report(std::ostream& os, const Report& report) {
+    os << "\n=== Hot Path Timings (ns) ===\n";
+    if (!compiled_in()) {
+        os << "(profiling not compiled in; configure with -DSWD_PROFILING=ON)\n";
+        return;
+    }
+    os << std::left << std::setw(16) << "point" << std::right << std::setw(12) << "count"
+       << std::setw(10) << "mean" << std::setw(10) << "p50" << std::setw(10) << "p90"
+       << std::setw(10) << "p99" << std::setw(12) << "max" << "\n";
+    os << std::fixed << std::setprecision(1);
+    for (int p = 0; p < kPointCount; ++p) {
+        const Histogram& h = report.points[p];
+        if (h.count == 0) continue;
+        double k = report.ns_per_tick;
+        os << std::left << std::setw(16) << point_name(static_cast<ProfilePoint>(p)) << std::right
+           << std::setw(12) << h.count
+           << std::setw(10) << (static_cast<double>(h.total_ticks) / h.count) * k
+           << std::setw(10) << percentile_ns(h, 0.50, k)
+           << std::setw(10) << percentile_ns(h, 0.90, k)
+           << std::setw(10) << percentile_ns(h, 0.99, k)
+           << std::setw(12) << static_cast<double>(h.max_ticks) * k << "\n";
+    }
+    os.unsetf(std::ios::floatfield);
+}
+
+void Profiler::write_json(std::ostream& os, const Report& report) {
+    os << "{\"ns_per_tick\":" << report.ns_per_tick << ",\"points\":{";
+    bool first = true;
+    for (int p = 0; p < kPointCount; ++p) {
+        const Histogram& h = report.points[p];
+        if (h.count == 0) continue;
+        if (!first) os << ",";
+        first = false;
+        os << "\"" << point_name(static_cast<ProfilePoint>(p)) << "\":{"
+           << "\"count\":" << h.count << ",\"total_ticks\":" << h.total_ticks
+           << ",\"max_ticks\":" << h.max_ticks << ",\"buckets\":[";
+        // 省略末尾的空桶
+        int last = kBuckets - 1;
+        while (last > 0 && h.buckets[last] == 0) --last;
+        for (int b = 0; b <= last; ++b) os << (b ? "," : "") << h.buckets[b];
+        os << "]}";
+    }
+    os << "}}\n";
+}
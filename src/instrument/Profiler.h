@@ -0,0 +1,105 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <cstdint>
+#include <iosfwd>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <chrono>
+#endif
+
+/**
+ * 计时点：热路径上的各个被测函数
+ */
+enum class ProfilePoint : uint8_t {
+    COST_CALC,        // CostCalculator::calculate_build_cost
+    TAKE_CARD,        // CardStructure::take_card
+    APPLY_EFFECT,     // Card::apply_effect
+    WONDER_EFFECT,    // 奇迹 Lambda 效果
+    MOVE_GEN,         // Game::legal_moves
+    SEARCH_SELECT,    // AI 搜索：选择
+    SEARCH_EXPAND,    // AI 搜索：扩展
+    SEARCH_ROLLOUT,   // AI 搜索：模拟/叶子评估
+    SEARCH_BACKPROP,  // AI 搜索：回传
+    COUNT
+};
+
+/**
+ * Profiler 类：基于 TSC 的轻量作用域计时 + 按线程的对数分桶延迟直方图
+ *
+ * - 以 CMake 选项 SWD_PROFILING=ON 编译时 SWD_PROFILE_SCOPE 生效，否则完全编译掉
+ * - 每个线程写自己的直方图（单写者，无锁），报告时合并所有线程
+ * - 第 k 个桶记录耗时落在 [2^k, 2^(k+1)) 个 tick 的样本
+ */
+class Profiler {
+public:
+    static constexpr int kBuckets = 48;
+
+    struct Histogram {
+        uint64_t count = 0;
+        uint64_t total_ticks = 0;
+        uint64_t max_ticks = 0;
+        uint64_t buckets[kBuckets] = {};
+    };
+
+    struct Report {
+        Histogram points[static_cast<int>(ProfilePoint::COUNT)];
+        double ns_per_tick = 1.0;
+    };
+
+    static constexpr bool compiled_in() {
+#ifdef SWD_ENABLE_PROFILING
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    static inline uint64_t now_ticks() {
+#if defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+    }
+
+    // 当前线程记录一个样本
+    static void record(ProfilePoint point, uint64_t ticks);
+
+    // 合并所有线程（含已退出线程）的直方图
+    static Report collect();
+
+    static void print_report(std::ostream& os, const Report& report);
+    static void write_json(std::ostream& os, const Report& report);
+    static const char* point_name(ProfilePoint point);
+
+    // tick 与纳秒的换算系数（首次调用时用 steady_clock 标定一次）
+    static double ns_per_tick();
+
+    // 由分桶估算分位数（返回纳秒，取桶上界）
+    static double percentile_ns(const Histogram& h, double q, double ns_per_tick);
+
+    class ScopedTimer {
+    public:
+        explicit ScopedTimer(ProfilePoint p) : point(p), start(now_ticks()) {}
+        ~ScopedTimer() { record(point, now_ticks() - start); }
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+    private:
+        ProfilePoint point;
+        uint64_t start;
+    };
+};
+
+#define SWD_PROFILE_CONCAT_(a, b) a##b
+#define SWD_PROFILE_CONCAT(a, b) SWD_PROFILE_CONCAT_(a, b)
+
+#ifdef SWD_ENABLE_PROFILING
+#define SWD_PROFILE_SCOPE(point) Profiler::ScopedTimer SWD_PROFILE_CONCAT(swd_profile_scope_, __LINE__)(point)
+#else
+#define SWD_PROFILE_SCOPE(point) ((void)0)
+#endif
+
+#endif
@@ -0,0 +1,104 @@
+#include "Sketch.h"
+#include "core/PositionHash.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+// 各行使用不同的种子，把同一个键映射到相互独立的列
+constexpr uint64_t kRowSeeds[] = {
+    0x243F6A8885A308D3ull, 0x13198A2E03707344ull, 0xA4093822299F31D0ull, 0x082EFA98EC4E6C89ull,
+    0x452821E638D01377ull, 0xBE5466CF34E90C6Cull, 0xC0AC29B7C97C50DDull, 0x3F84D5B5B5470917ull,
+};
+constexpr int kMaxDepth = sizeof(kRowSeeds) / sizeof(kRowSeeds[0]);
+}
+
+CountMinSketch::CountMinSketch(int d, int log2_width)
+    : depth(std::min(std::max(d, 1), kMaxDepth)), mask((1ull << log2_width) - 1),
+      table(static_cast<std::size_t>(depth) << log2_width, 0) {}
+
+std::size_t CountMinSketch::index(int row, uint64_t key) const {
+    return (static_cast<std::size_t>(row) * (mask + 1)) + (hash_mix(kRowSeeds[row], key) & mask);
+}
+
+uint32_t CountMinSketch::add(uint64_t key, uint32_t count) {
+    total_count += count;
+    uint32_t result = UINT32_MAX;
+    for (int r = 0; r < depth; ++r) {
+        uint32_t& cell = table[index(r, key)];
+        cell = (cell > UINT32_MAX - count) ? UINT32_MAX : cell + count;   // 饱和加法
+        result = std::min(result, cell);
+    }
+    return result;
+}
+
+uint32_t CountMinSketch::estimate(uint64_t key) const {
+    uint32_t result = UINT32_MAX;
+    for (int r = 0; r < depth; ++r) result = std::min(result, table[index(r, key)]);
+    return result;
+}
+
+void CountMinSketch::merge(const CountMinSketch& other) {
+    if (other.table.size() != table.size()) return;
+    for (std::size_t i = 0; i < table.size(); ++i) {
+        uint64_t sum = static_cast<uint64_t>(table[i]) + other.table[i];
+        table[i] = sum > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(sum);
+    }
+    total_count += other.total_count;
+}
+
+HyperLogLog::HyperLogLog(int p) : precision(std::min(std::max(p, 4), 18)), registers(1u << precision, 0) {}
+
+void HyperLogLog::add(uint64_t key) {
+    uint64_t h = hash_mix(0x5851F42D4C957F2Dull, key);
+    uint32_t idx = static_cast<uint32_t>(h >> (64 - precision));
+    uint64_t rest = (h << precision) | (1ull << (precision - 1));   // 保证有一个 1，避免全零
+    uint8_t rank = static_cast<uint8_t>(__builtin_clzll(rest) + 1);
+    if (rank > registers[idx]) registers[idx] = rank;
+}
+
+double HyperLogLog::estimate() const {
+    const double m = static_cast<double>(registers.size());
+    double sum = 0.0;
+    int zeros = 0;
+    for (uint8_t r : registers) {
+        sum += std::ldexp(1.0, -r);
+        zeros += (r == 0);
+    }
+    const double alpha = 0.7213 / (1.0 + 1.079 / m);
+    double e = alpha * m * m / sum;
+    // 小基数区间改用线性计数
+    if (e <= 2.5 * m && zeros > 0) e = m * std::log(m / zeros);
+    return e;
+}
+
+void HyperLogLog::merge(const HyperLogLog& other) {
+    if (other.registers.size() != registers.size()) return;
+    for (std::size_t i = 0; i < registers.size(); ++i) registers[i] = std::max(registers[i], other.registers[i]);
+}
+
+void HeavyHitters::offer(uint64_t key, uint32_t estimate, uint64_t payload) {
+    int min_idx = -1;
+    for (int i = 0; i < (int)entries.size(); ++i) {
+        if (entries[i].key == key) {
+            entries[i].count = estimate;
+            return;
+        }
+        if (min_idx < 0 || entries[i].count < entries[min_idx].count) min_idx = i;
+    }
+    if ((int)entries.size() < capacity) {
+        entries.push_back({key, estimate, payload});
+    } else if (estimate > entries[min_idx].count) {
+        entries[min_idx] = {key, estimate, payload};
+    }
+}
+
+void HeavyHitters::merge(const HeavyHitters& other, const CountMinSketch& merged) {
+    for (Entry& e : entries) e.count = merged.estimate(e.key);
+    for (const Entry& e : other.entries) offer(e.key, merged.estimate(e.key), e.payload);
+}
+
+std::vector<HeavyHitters::Entry> HeavyHitters::top() const {
+    std::vector<Entry> sorted = entries;
+    std::sort(sorted.begin(), sorted.end(), [](const Entry& a, const Entry& b) { return a.count > b.count; });
+    return sorted;
+}
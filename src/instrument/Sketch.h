@@ -0,0 +1,76 @@
+#ifndef SKETCH_H
+#define SKETCH_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+/**
+ * 定长内存的流式概要结构，均可合并（多线程各写一份，结束时合并）
+ *
+ * - CountMinSketch：频次估计，只会高估；误差约为 总次数 × e / width，置信度 1 - e^-depth
+ * - HyperLogLog   ：基数（不同键个数）估计，相对误差约 1.04 / sqrt(2^precision)
+ * - HeavyHitters  ：借助 CountMinSketch 的估计值维护前 K 个高频键
+ *
+ * 输入键应已是充分混合的 64 位哈希；各行的下标由键再次混合得到。
+ */
+class CountMinSketch {
+public:
+    CountMinSketch(int depth = 4, int log2_width = 16);
+
+    // 计数 +count，返回该键更新后的估计值
+    uint32_t add(uint64_t key, uint32_t count = 1);
+    uint32_t estimate(uint64_t key) const;
+    // 两个概要的形状必须相同
+    void merge(const CountMinSketch& other);
+
+    uint64_t total() const { return total_count; }
+    std::size_t memory_bytes() const { return table.size() * sizeof(uint32_t); }
+
+private:
+    std::size_t index(int row, uint64_t key) const;
+
+    int depth;
+    uint64_t mask;
+    std::vector<uint32_t> table;   // depth 行 × width 列
+    uint64_t total_count = 0;
+};
+
+class HyperLogLog {
+public:
+    explicit HyperLogLog(int precision = 14);
+
+    void add(uint64_t key);
+    double estimate() const;
+    void merge(const HyperLogLog& other);
+
+    std::size_t memory_bytes() const { return registers.size(); }
+
+private:
+    int precision;
+    std::vector<uint8_t> registers;
+};
+
+class HeavyHitters {
+public:
+    struct Entry {
+        uint64_t key = 0;
+        uint32_t count = 0;    // CountMinSketch 估计值
+        uint64_t payload = 0;  // 调用方附带的信息（如局面摘要），随键保存
+    };
+
+    explicit HeavyHitters(int capacity = 32) : capacity(capacity) { entries.reserve(capacity); }
+
+    // estimate 为该键在 CountMinSketch 中的最新估计
+    void offer(uint64_t key, uint32_t estimate, uint64_t payload);
+    // 合并后需用合并后的概要重新估计
+    void merge(const HeavyHitters& other, const CountMinSketch& merged);
+    // 按估计频次降序
+    std::vector<Entry> top() const;
+
+private:
+    int capacity;
+    std::vector<Entry> entries;
+};
+
+#endif
@@ -0,0 +1,97 @@
+#include "Tracer.h"
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+std::atomic<bool> Tracer::enabled_flag{false};
+
+namespace {
+
+struct ThreadRing {
+    std::unique_ptr<Tracer::Event[]> events{new Tracer::Event[Tracer::kRingCapacity]};
+    std::atomic<uint64_t> head{0};   // 已写入的事件总数（单调递增）
+    int tid = 0;
+};
+
+std::mutex registry_mutex;
+// 线程退出后缓冲区仍保留，便于运行结束时统一导出
+std::vector<std::shared_ptr<ThreadRing>> registry;
+
+ThreadRing& local_ring() {
+    static thread_local std::shared_ptr<ThreadRing> ring = [] {
+        auto r = std::make_shared<ThreadRing>();
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        r->tid = static_cast<int>(registry.size()) + 1;
+        registry.push_back(r);
+        return r;
+    }();
+    return *ring;
+}
+
+void write_escaped(std::ostream& os, const char* s) {
+    for (; *s; ++s) {
+        if (*s == '"' || *s == '\\') os << '\\';
+        os << *s;
+    }
+}
+
+} // namespace
+
+void Tracer::record(const char* name, char phase, int64_t arg) {
+    ThreadRing& ring = local_ring();
+    uint64_t h = ring.head.load(std::memory_order_relaxed);
+    Event& e = ring.events[h & (kRingCapacity - 1)];
+    e.name = name;
+    e.ticks = Profiler::now_ticks();
+    e.arg = arg;
+    e.phase = phase;
+    ring.head.store(h + 1, std::memory_order_release);
+}
+
+void Tracer::clear() {
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    for (auto& ring : registry) ring->head.store(0, std::memory_order_relaxed);
+}
+
+void Tracer::write_chrome_json(std::ostream& os) {
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    const double us_per_tick = Profiler::ns_per_tick() / 1000.0;
+
+    // 以全部线程中最早的事件为时间零点
+    uint64_t origin = UINT64_MAX;
+    for (const auto& ring : registry) {
+        uint64_t h = ring->head.load(std::memory_order_acquire);
+        uint64_t first = h > kRingCapacity ? h - kRingCapacity : 0;
+        if (h > first) origin = std::min(origin, ring->events[first & (kRingCapacity - 1)].ticks);
+    }
+
+    os << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    bool first_event = true;
+    for (const auto& ring : registry) {
+        uint64_t h = ring->head.load(std::memory_order_acquire);
+        uint64_t first = h > kRingCapacity ? h - kRingCapacity : 0;
+        // 环形缓冲区被覆盖时，开头可能残留没有 B 的 E 事件，跳过它们
+        int depth = 0;
+        for (uint64_t i = first; i < h; ++i) {
+            const Event& e = ring->events[i & (kRingCapacity - 1)];
+            if (e.phase == 'B') depth++;
+            if (e.phase == 'E') {
+                if (depth == 0) continue;
+                depth--;
+            }
+            if (!first_event) os << ",";
+            first_event = false;
+            os << "\n{\"name\":\"";
+            write_escaped(os, e.name);
+            os << "\",\"ph\":\"" << e.phase << "\",\"ts\":"
+               << static_cast<double>(e.ticks - origin) * us_per_tick
+               << ",\"pid\":1,\"tid\":" << ring->tid;
+            if (e.phase == 'i') os << ",\"s\":\"t\"";
+            if (e.phase != 'E' && e.arg != 0) os << ",\"args\":{\"value\":" << e.arg << "}";
+            os << "}";
+        }
+    }
+    os << "\n]}\n";
+}
@@ -0,0 +1,79 @@
+#ifndef TRACER_H
+#define TRACER_H
+
+#include <atomic>
+#include <cstdint>
+#include <iosfwd>
+#include "Profiler.h"
+
+/**
+ * Tracer 类：时间线事件记录，导出为 Chrome trace-event JSON（chrome://tracing / Perfetto）
+ *
+ * - 以 CMake 选项 SWD_TRACING=ON 编译时 SWD_TRACE_* 宏生效，否则完全编译掉
+ * - 编译进来后仍需运行时 Tracer::set_enabled(true) 才记录，关闭时每个埋点只是一次 relaxed 读
+ * - 每个线程一个定长环形缓冲区（单写者，无锁）；写满后覆盖最旧的事件，内存占用固定
+ * - 事件名必须是字符串字面量（只保存指针）
+ * - dump 应在各工作线程停止记录后调用
+ */
+class Tracer {
+public:
+    static constexpr uint32_t kRingCapacity = 1u << 16;   // 每线程事件数，须为 2 的幂
+
+    struct Event {
+        const char* name;
+        uint64_t ticks;
+        int64_t arg;        // 可选数值参数（如时代编号、迭代次数）
+        char phase;         // 'B' 开始, 'E' 结束, 'i' 瞬时事件
+    };
+
+    static constexpr bool compiled_in() {
+#ifdef SWD_ENABLE_TRACING
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    static void set_enabled(bool on) { enabled_flag.store(on, std::memory_order_relaxed); }
+    static bool enabled() { return enabled_flag.load(std::memory_order_relaxed); }
+
+    static void begin(const char* name, int64_t arg = 0) { record(name, 'B', arg); }
+    static void end(const char* name) { record(name, 'E', 0); }
+    static void instant(const char* name, int64_t arg = 0) { record(name, 'i', arg); }
+
+    // 把所有线程环形缓冲区中的事件写成 Chrome trace-event JSON
+    static void write_chrome_json(std::ostream& os);
+    // 清空所有线程的缓冲区
+    static void clear();
+
+    class Scope {
+    public:
+        explicit Scope(const char* n, int64_t arg = 0) : name(enabled() ? n : nullptr) {
+            if (name) begin(name, arg);
+        }
+        ~Scope() { if (name) end(name); }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    private:
+        const char* name;
+    };
+
+private:
+    static std::atomic<bool> enabled_flag;
+    static void record(const char* name, char phase, int64_t arg);
+};
+
+#define SWD_TRACE_CONCAT_(a, b) a##b
+#define SWD_TRACE_CONCAT(a, b) SWD_TRACE_CONCAT_(a, b)
+
+#ifdef SWD_ENABLE_TRACING
+#define SWD_TRACE_SCOPE(name) Tracer::Scope SWD_TRACE_CONCAT(swd_trace_scope_, __LINE__)(name)
+#define SWD_TRACE_SCOPE_ARG(name, arg) Tracer::Scope SWD_TRACE_CONCAT(swd_trace_scope_, __LINE__)(name, arg)
+#define SWD_TRACE_INSTANT(name, arg) do { if (Tracer::enabled()) Tracer::instant(name, arg); } while (0)
+#else
+#define SWD_TRACE_SCOPE(name) ((void)0)
+#define SWD_TRACE_SCOPE_ARG(name, arg) ((void)0)
+#define SWD_TRACE_INSTANT(name, arg) ((void)0)
+#endif
+
+#endif
@@ -1,8 +1,37 @@
 // main.cpp
+//
+// 用法: SevenWondersDuel [--bot] [--advisor] [--think MS] [--threads N] [存档文件]
+//   --bot        Player 2 由后台思考的机器人执子（不偷看背面牌：隐藏信息每次迭代随机采样）
+//   --advisor    人类回合可输入 -3 查看提示（来自后台一直在进行的搜索）
+//   --think MS   机器人每步的思考时间（默认 2000 毫秒，之前后台思考的结果会被沿用）
+//   --threads N  搜索线程数
 #include "core/Game.h"
+#include "view/Ctrller.h"
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+int main(int argc, char* argv[]) {
+    Game& game = Game::getInstance();
+    ConsoleOptions options;
+    std::string snapshot_path;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--bot") options.bot_seat = 1;
+        else if (arg == "--advisor") options.advisor = true;
+        else if (arg == "--think" && i + 1 < argc) options.think_ms = std::atoll(argv[++i]);
+        else if (arg == "--threads" && i + 1 < argc) options.threads = std::atoi(argv[++i]);
+        else snapshot_path = arg;
+    }
+
+    // 可选参数：快照文件路径，从存档继续对局
+    if (!snapshot_path.empty() && !game.load_from_file(snapshot_path)) {
+        std::cerr << "Failed to load snapshot: " << snapshot_path << std::endl;
+        return 1;
+    }
 
-int main() {
     // 获取单例实例并运行
-    Game::getInstance().run();
+    game.run(options);
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,304 @@
+#include "GameServer.h"
+#include "core/Game.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+bool set_nonblocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+constexpr int kMaxEvents = 256;
+constexpr std::size_t kReadChunk = 16 * 1024;
+// 单连接缓冲的未处理输入上限：攒到这么多就先处理，剩余数据留在内核缓冲区，下一轮事件再读
+constexpr std::size_t kMaxBufferedInput = 4 * kMaxFrameBytes;
+
+} // namespace
+
+GameServer::GameServer(const ServerConfig& cfg)
+    : config(cfg), store(cfg.max_live_games, cfg.max_sessions) {
+    moves.reserve(256);
+}
+
+GameServer::~GameServer() {
+    for (auto& [fd, c] : connections) ::close(fd);
+    if (epoll_fd >= 0) ::close(epoll_fd);
+    if (listen_fd >= 0) {
+        ::close(listen_fd);
+        ::unlink(config.socket_path.c_str());
+    }
+}
+
+bool GameServer::open() {
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    if (config.socket_path.size() >= sizeof(addr.sun_path)) {
+        std::cerr << "[Server] socket path too long: " << config.socket_path << std::endl;
+        return false;
+    }
+    std::strncpy(addr.sun_path, config.socket_path.c_str(), sizeof(addr.sun_path) - 1);
+
+    listen_fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listen_fd < 0) return false;
+    ::unlink(config.socket_path.c_str());
+    if (::bind(listen_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+        ::listen(listen_fd, SOMAXCONN) != 0 || !set_nonblocking(listen_fd)) {
+        std::cerr << "[Server] cannot listen on " << config.socket_path << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    epoll_fd = ::epoll_create1(0);
+    if (epoll_fd < 0) return false;
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.fd = listen_fd;
+    return ::epoll_ctl(epoll_fd, EPOLL_CTL_ADD, listen_fd, &ev) == 0;
+}
+
+void GameServer::run() {
+    running.store(true, std::memory_order_relaxed);
+    epoll_event events[kMaxEvents];
+    while (running.load(std::memory_order_relaxed)) {
+        // 带超时等待，以便及时响应 stop()
+        int n = ::epoll_wait(epoll_fd, events, kMaxEvents, 200);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        for (int i = 0; i < n; ++i) {
+            int fd = events[i].data.fd;
+            if (fd == listen_fd) {
+                accept_clients();
+                continue;
+            }
+            auto it = connections.find(fd);
+            if (it == connections.end()) continue;
+            Connection& c = it->second;
+            if (events[i].events & (EPOLLERR | EPOLLHUP)) {
+                close_connection(fd);
+                continue;
+            }
+            if ((events[i].events & EPOLLOUT) && !flush(c)) {
+                close_connection(fd);
+                continue;
+            }
+            if (events[i].events & EPOLLIN) handle_readable(c);
+        }
+    }
+}
+
+void GameServer::accept_clients() {
+    while (true) {
+        int fd = ::accept(listen_fd, nullptr, nullptr);
+        if (fd < 0) return;   // EAGAIN：已取完
+        if (!set_nonblocking(fd)) {
+            ::close(fd);
+            continue;
+        }
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.fd = fd;
+        if (::epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &ev) != 0) {
+            ::close(fd);
+            continue;
+        }
+        Connection& c = connections[fd];
+        c.fd = fd;
+        c.in.reserve(kReadChunk);
+        c.out.reserve(kReadChunk);
+    }
+}
+
+void GameServer::handle_readable(Connection& c) {
+    const int fd = c.fd;
+    bool peer_closed = false;
+    while (c.in.size() < kMaxBufferedInput) {
+        std::size_t old_size = c.in.size();
+        const std::size_t chunk = std::min(kReadChunk, kMaxBufferedInput - old_size);
+        c.in.resize(old_size + chunk);
+        ssize_t n = ::recv(fd, c.in.data() + old_size, chunk, 0);
+        c.in.resize(old_size + (n > 0 ? n : 0));
+        if (n > 0) continue;
+        if (n == 0) peer_closed = true;
+        else if (errno == EINTR) continue;
+        else if (errno != EAGAIN && errno != EWOULDBLOCK) peer_closed = true;
+        break;
+    }
+
+    // 处理所有完整的帧
+    std::size_t consumed = 0;
+    while (true) {
+        NetMessage type;
+        const uint8_t* payload;
+        std::size_t payload_size;
+        long frame = parse_frame(c.in.data() + consumed, c.in.size() - consumed, type, payload, payload_size);
+        if (frame == 0) break;
+        if (frame < 0 || !handle_frame(c, type, payload, payload_size)) {
+            // 协议错误：回一个 ERROR 后断开
+            FrameWriter w(c.out);
+            write_error(w, 0, NetError::BAD_FRAME);
+            flush(c);
+            close_connection(fd);
+            return;
+        }
+        consumed += static_cast<std::size_t>(frame);
+        // 客户端不读回复却一直发请求：每帧检查积压，不等整批处理完
+        if (c.out.size() - c.out_sent > config.max_pending_output) {
+            close_connection(fd);
+            return;
+        }
+    }
+    c.in.erase(c.in.begin(), c.in.begin() + consumed);
+
+    if (!flush(c) || peer_closed || c.out.size() - c.out_sent > config.max_pending_output) {
+        close_connection(fd);
+        return;
+    }
+    update_interest(c);
+}
+
+bool GameServer::flush(Connection& c) {
+    while (c.out_sent < c.out.size()) {
+        ssize_t n = ::send(c.fd, c.out.data() + c.out_sent, c.out.size() - c.out_sent, MSG_NOSIGNAL);
+        if (n > 0) {
+            c.out_sent += static_cast<std::size_t>(n);
+            continue;
+        }
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+        return false;
+    }
+    if (c.out_sent == c.out.size()) {
+        c.out.clear();
+        c.out_sent = 0;
+    }
+    update_interest(c);
+    return true;
+}
+
+void GameServer::update_interest(Connection& c) {
+    bool want = c.out_sent < c.out.size();
+    if (want == c.want_write) return;
+    c.want_write = want;
+    epoll_event ev{};
+    ev.events = want ? EPOLLIN | EPOLLOUT : EPOLLIN;
+    ev.data.fd = c.fd;
+    ::epoll_ctl(epoll_fd, EPOLL_CTL_MOD, c.fd, &ev);
+}
+
+void GameServer::close_connection(int fd) {
+    ::epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+    ::close(fd);
+    connections.erase(fd);
+}
+
+void GameServer::write_error(FrameWriter& w, uint32_t session, NetError code) {
+    w.begin(NetMessage::ERROR);
+    w.u32(session);
+    w.u8(static_cast<uint8_t>(code));
+    w.end();
+}
+
+bool GameServer::handle_frame(Connection& c, NetMessage type, const uint8_t* payload, std::size_t size) {
+    FrameReader r(payload, size);
+    FrameWriter w(c.out);
+
+    if (type == NetMessage::CREATE) {
+        uint64_t seed = r.u64();
+        if (!r.ok()) return false;
+        uint32_t id = store.create(seed);
+        if (id == 0) {
+            write_error(w, 0, NetError::SESSION_LIMIT);
+            return true;
+        }
+        store.acquire(id)->save_snapshot(after);
+        w.begin(NetMessage::CREATED);
+        w.u32(id);
+        w.u16(static_cast<uint16_t>(sizeof(GameSnapshot)));
+        w.bytes(&after, sizeof(after));
+        w.end();
+        return true;
+    }
+
+    if (type == NetMessage::STATS) {
+        w.begin(NetMessage::STATS_REPLY);
+        w.u32(static_cast<uint32_t>(store.session_count()));
+        w.u32(static_cast<uint32_t>(store.live_count()));
+        w.u64(moves_applied);
+        w.end();
+        return true;
+    }
+
+    uint32_t id = r.u32();
+    if (!r.ok()) return false;
+
+    if (type == NetMessage::CLOSE) {
+        if (!store.close(id)) {
+            write_error(w, id, NetError::UNKNOWN_SESSION);
+            return true;
+        }
+        w.begin(NetMessage::CLOSED);
+        w.u32(id);
+        w.end();
+        return true;
+    }
+
+    Game* game = store.acquire(id);
+    if (!game) {
+        write_error(w, id, NetError::UNKNOWN_SESSION);
+        return true;
+    }
+
+    switch (type) {
+        case NetMessage::LEGAL: {
+            game->legal_moves(moves);
+            w.begin(NetMessage::MOVES);
+            w.u32(id);
+            w.u8(static_cast<uint8_t>(std::min<std::size_t>(moves.size(), 255)));
+            for (std::size_t i = 0; i < moves.size() && i < 255; ++i) w.move(moves[i]);
+            w.end();
+            return true;
+        }
+        case NetMessage::STATE: {
+            game->save_snapshot(after);
+            w.begin(NetMessage::STATE_FULL);
+            w.u32(id);
+            w.u16(static_cast<uint16_t>(sizeof(GameSnapshot)));
+            w.bytes(&after, sizeof(after));
+            w.end();
+            return true;
+        }
+        case NetMessage::MOVE: {
+            Move m = r.move();
+            if (!r.ok()) return false;
+            game->save_snapshot(before);
+            if (!game->apply_move(m)) {
+                write_error(w, id, NetError::ILLEGAL_MOVE);
+                return true;
+            }
+            moves_applied++;
+            game->save_snapshot(after);
+            const Decision& d = game->get_decision();
+            w.begin(NetMessage::DELTA);
+            w.u32(id);
+            w.u8(static_cast<uint8_t>(d.type));
+            w.u8(static_cast<uint8_t>(d.player));
+            w.u8(game->is_over() ? 1 : 0);
+            w.u8(game->is_over() ? static_cast<uint8_t>(game->get_winner()) : kNoWinner);
+            write_snapshot_delta(w, before, after);
+            w.end();
+            return true;
+        }
+        default:
+            return false;
+    }
+}
@@ -0,0 +1,72 @@
+#ifndef GAME_SERVER_H
+#define GAME_SERVER_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Protocol.h"
+#include "SessionStore.h"
+
+struct ServerConfig {
+    std::string socket_path = "/tmp/swd.sock";
+    std::size_t max_live_games = 128;        // 常驻内存的 Game 对象数
+    std::size_t max_sessions = 100000;       // 对局总数上限（其余以快照块保存）
+    std::size_t max_pending_output = 1 << 20; // 单连接未发送数据上限，超出即断开
+};
+
+/**
+ * GameServer 类：Unix 域套接字上的多对局服务器（仅 Linux，epoll）
+ *
+ * - 单线程事件循环，所有连接非阻塞；一个连接可以同时操作任意多局
+ * - 对局不属于某个连接：断线后可用同一会话号从新连接继续
+ * - 每步回复只携带快照的变化字节（见 Protocol.h 的 DELTA）
+ */
+class GameServer {
+public:
+    explicit GameServer(const ServerConfig& config);
+    ~GameServer();
+
+    GameServer(const GameServer&) = delete;
+    GameServer& operator=(const GameServer&) = delete;
+
+    // 创建并监听套接字（已存在的同名套接字文件会被替换）
+    bool open();
+    // 运行事件循环直到 stop()（可在信号处理函数中调用）
+    void run();
+    void stop() { running.store(false, std::memory_order_relaxed); }
+
+    const SessionStore& get_sessions() const { return store; }
+
+private:
+    struct Connection {
+        int fd = -1;
+        std::vector<uint8_t> in;
+        std::vector<uint8_t> out;
+        std::size_t out_sent = 0;
+        bool want_write = false;
+    };
+
+    void accept_clients();
+    void handle_readable(Connection& c);
+    bool flush(Connection& c);       // 返回 false 表示连接已失效
+    void close_connection(int fd);
+    // 处理一帧请求，回复追加到 c.out；返回 false 表示协议错误
+    bool handle_frame(Connection& c, NetMessage type, const uint8_t* payload, std::size_t size);
+    void write_error(FrameWriter& w, uint32_t session, NetError code);
+    void update_interest(Connection& c);
+
+    ServerConfig config;
+    SessionStore store;
+    int listen_fd = -1;
+    int epoll_fd = -1;
+    std::atomic<bool> running{false};
+    std::unordered_map<int, Connection> connections;
+    std::vector<Move> moves;                  // 复用的合法动作缓冲
+    GameSnapshot before;
+    GameSnapshot after;
+    uint64_t moves_applied = 0;
+};
+
+#endif
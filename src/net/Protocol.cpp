@@ -0,0 +1,133 @@
+#include "Protocol.h"
+#include "core/Snapshot.h"
+#include <cstring>
+
+void FrameWriter::begin(NetMessage type) {
+    frame_start = out.size();
+    u32(0);   // 长度占位，end() 回填
+    u8(static_cast<uint8_t>(type));
+}
+
+void FrameWriter::end() {
+    uint32_t len = static_cast<uint32_t>(out.size() - frame_start - 4);
+    for (int i = 0; i < 4; ++i) out[frame_start + i] = static_cast<uint8_t>(len >> (8 * i));
+}
+
+void FrameWriter::u16(uint16_t v) {
+    out.push_back(static_cast<uint8_t>(v));
+    out.push_back(static_cast<uint8_t>(v >> 8));
+}
+
+void FrameWriter::u32(uint32_t v) {
+    for (int i = 0; i < 4; ++i) out.push_back(static_cast<uint8_t>(v >> (8 * i)));
+}
+
+void FrameWriter::u64(uint64_t v) {
+    for (int i = 0; i < 8; ++i) out.push_back(static_cast<uint8_t>(v >> (8 * i)));
+}
+
+void FrameWriter::bytes(const void* data, std::size_t n) {
+    const uint8_t* b = static_cast<const uint8_t*>(data);
+    out.insert(out.end(), b, b + n);
+}
+
+void FrameWriter::move(const Move& m) {
+    u8(static_cast<uint8_t>(m.type));
+    i8(m.pos);
+    i8(m.wonder_idx);
+}
+
+uint8_t FrameReader::u8() {
+    if (p >= end) { good = false; return 0; }
+    return *p++;
+}
+
+uint16_t FrameReader::u16() {
+    uint16_t v = u8();
+    return static_cast<uint16_t>(v | (u8() << 8));
+}
+
+uint32_t FrameReader::u32() {
+    uint32_t v = 0;
+    for (int i = 0; i < 4; ++i) v |= static_cast<uint32_t>(u8()) << (8 * i);
+    return v;
+}
+
+uint64_t FrameReader::u64() {
+    uint64_t v = 0;
+    for (int i = 0; i < 8; ++i) v |= static_cast<uint64_t>(u8()) << (8 * i);
+    return v;
+}
+
+bool FrameReader::bytes(void* dst, std::size_t n) {
+    if (remaining() < n) { good = false; return false; }
+    std::memcpy(dst, p, n);
+    p += n;
+    return true;
+}
+
+Move FrameReader::move() {
+    Move m;
+    m.type = static_cast<Move::Type>(u8());
+    m.pos = i8();
+    m.wonder_idx = i8();
+    return m;
+}
+
+long parse_frame(const uint8_t* data, std::size_t size, NetMessage& type, const uint8_t*& payload, std::size_t& payload_size) {
+    if (size < 4) return 0;
+    uint32_t len = data[0] | (data[1] << 8) | (data[2] << 16) | (static_cast<uint32_t>(data[3]) << 24);
+    if (len == 0 || len > kMaxFrameBytes) return -1;
+    if (size < 4 + static_cast<std::size_t>(len)) return 0;
+    type = static_cast<NetMessage>(data[4]);
+    payload = data + 5;
+    payload_size = len - 1;
+    return 4 + static_cast<long>(len);
+}
+
+namespace {
+// 两段变化相隔不超过该字节数时合并为一段（一段的头部开销是 3 字节）
+constexpr std::size_t kMergeGap = 3;
+constexpr std::size_t kMaxRun = 255;
+}
+
+void write_snapshot_delta(FrameWriter& w, const GameSnapshot& before, const GameSnapshot& after) {
+    const uint8_t* a = reinterpret_cast<const uint8_t*>(&before);
+    const uint8_t* b = reinterpret_cast<const uint8_t*>(&after);
+    constexpr std::size_t n = sizeof(GameSnapshot);
+
+    // 先统计段数再写，避免回填
+    uint16_t runs = 0;
+    for (int pass = 0; pass < 2; ++pass) {
+        if (pass == 1) w.u16(runs);
+        std::size_t i = 0;
+        while (i < n) {
+            if (a[i] == b[i]) { i++; continue; }
+            std::size_t start = i, stop = i + 1, gap = 0;
+            for (std::size_t k = i + 1; k < n && gap <= kMergeGap && k - start < kMaxRun; ++k) {
+                if (a[k] != b[k]) { stop = k + 1; gap = 0; }
+                else gap++;
+            }
+            if (pass == 0) {
+                runs++;
+            } else {
+                w.u16(static_cast<uint16_t>(start));
+                w.u8(static_cast<uint8_t>(stop - start));
+                w.bytes(b + start, stop - start);
+            }
+            i = stop;
+        }
+    }
+}
+
+bool apply_snapshot_delta(FrameReader& r, GameSnapshot& snap) {
+    uint8_t* dst = reinterpret_cast<uint8_t*>(&snap);
+    uint16_t runs = r.u16();
+    for (uint16_t i = 0; i < runs && r.ok(); ++i) {
+        uint16_t offset = r.u16();
+        uint8_t len = r.u8();
+        if (offset + static_cast<std::size_t>(len) > sizeof(GameSnapshot)) return false;
+        r.bytes(dst + offset, len);
+    }
+    return r.ok();
+}
@@ -0,0 +1,120 @@
+#ifndef PROTOCOL_H
+#define PROTOCOL_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include "core/Move.h"
+
+struct GameSnapshot;
+
+/**
+ * 对局服务器的二进制协议（小端序）
+ *
+ * 帧格式：u32 长度（不含长度字段本身）| u8 消息类型 | 负载
+ *
+ * 客户端 -> 服务器
+ *   CREATE  u64 seed（0 = 随机）
+ *   MOVE    u32 session | u8 move_type | i8 pos | i8 wonder_idx
+ *   LEGAL   u32 session
+ *   STATE   u32 session
+ *   CLOSE   u32 session
+ *   STATS
+ * 服务器 -> 客户端
+ *   CREATED u32 session | u16 size | 完整 GameSnapshot
+ *   DELTA   u32 session | 决策头 | u16 run_count | run_count × (u16 offset | u8 len | len 字节)
+ *           决策头 = u8 decision_type | u8 decision_player | u8 game_over | u8 winner（未结束为 0xFF）
+ *           各段是 GameSnapshot 中相对上一次发给客户端的状态发生变化的字节
+ *   MOVES   u32 session | u8 count | count × (u8 move_type | i8 pos | i8 wonder_idx)
+ *   STATE   u32 session | u16 size | 完整 GameSnapshot
+ *   CLOSED  u32 session
+ *   STATS   u32 sessions | u32 live_games | u64 moves_applied
+ *   ERROR   u32 session | u8 NetError
+ */
+enum class NetMessage : uint8_t {
+    CREATE = 0x01,
+    MOVE = 0x02,
+    LEGAL = 0x03,
+    STATE = 0x04,
+    CLOSE = 0x05,
+    STATS = 0x06,
+
+    CREATED = 0x81,
+    DELTA = 0x82,
+    MOVES = 0x83,
+    STATE_FULL = 0x84,
+    CLOSED = 0x85,
+    STATS_REPLY = 0x86,
+    ERROR = 0xFF
+};
+
+enum class NetError : uint8_t {
+    UNKNOWN_SESSION = 1,
+    ILLEGAL_MOVE = 2,
+    BAD_FRAME = 3,
+    SESSION_LIMIT = 4
+};
+
+constexpr uint32_t kMaxFrameBytes = 4096;   // 单帧上限，超出视为协议错误
+constexpr uint8_t kNoWinner = 0xFF;
+
+/**
+ * FrameWriter 类：向输出缓冲区追加一帧
+ * begin() 预留长度字段，end() 回填；缓冲区由调用方持有并复用
+ */
+class FrameWriter {
+public:
+    explicit FrameWriter(std::vector<uint8_t>& buffer) : out(buffer) {}
+
+    void begin(NetMessage type);
+    void end();
+
+    void u8(uint8_t v) { out.push_back(v); }
+    void i8(int8_t v) { out.push_back(static_cast<uint8_t>(v)); }
+    void u16(uint16_t v);
+    void u32(uint32_t v);
+    void u64(uint64_t v);
+    void bytes(const void* data, std::size_t n);
+    void move(const Move& m);
+
+private:
+    std::vector<uint8_t>& out;
+    std::size_t frame_start = 0;
+};
+
+/**
+ * FrameReader 类：按顺序读取一帧的负载，越界后 ok() 返回 false 且后续读取均为 0
+ */
+class FrameReader {
+public:
+    FrameReader(const uint8_t* data, std::size_t size) : p(data), end(data + size) {}
+
+    uint8_t u8();
+    int8_t i8() { return static_cast<int8_t>(u8()); }
+    uint16_t u16();
+    uint32_t u32();
+    uint64_t u64();
+    bool bytes(void* dst, std::size_t n);
+    Move move();
+
+    bool ok() const { return good; }
+    std::size_t remaining() const { return static_cast<std::size_t>(end - p); }
+
+private:
+    const uint8_t* p;
+    const uint8_t* end;
+    bool good = true;
+};
+
+/**
+ * 在缓冲区开头解析一帧
+ * @return 完整帧的总字节数（含长度字段）；数据不足返回 0；长度非法返回 -1
+ */
+long parse_frame(const uint8_t* data, std::size_t size, NetMessage& type, const uint8_t*& payload, std::size_t& payload_size);
+
+// 快照差量：只写出 before -> after 发生变化的字节段（相隔很近的段合并）
+void write_snapshot_delta(FrameWriter& w, const GameSnapshot& before, const GameSnapshot& after);
+// 把差量应用到客户端持有的快照副本上
+bool apply_snapshot_delta(FrameReader& r, GameSnapshot& snap);
+
+#endif
@@ -0,0 +1,77 @@
+#include "SessionStore.h"
+#include "core/Game.h"
+#include <random>
+
+SessionStore::SessionStore(std::size_t max_live, std::size_t max_sessions_limit)
+    : live(max_live == 0 ? 1 : max_live), max_sessions(max_sessions_limit) {
+    sessions.reserve(max_sessions_limit);
+}
+
+SessionStore::~SessionStore() = default;
+
+std::size_t SessionStore::live_count() const {
+    std::size_t n = 0;
+    for (const auto& slot : live) n += slot.session != 0;
+    return n;
+}
+
+SessionStore::LiveSlot& SessionStore::claim_slot() {
+    LiveSlot* victim = &live[0];
+    for (auto& slot : live) {
+        if (slot.session == 0) { victim = &slot; break; }
+        if (slot.last_used < victim->last_used) victim = &slot;
+    }
+    if (victim->session != 0) {
+        // 换出：整局写回快照块
+        Session& old = sessions.at(victim->session);
+        victim->game->save_snapshot(old.blob);
+        old.live_slot = -1;
+        victim->session = 0;
+    }
+    if (!victim->game) victim->game = std::make_unique<Game>();
+    return *victim;
+}
+
+uint32_t SessionStore::create(uint64_t seed) {
+    if (sessions.size() >= max_sessions) return 0;
+    if (seed == 0) {
+        std::random_device rd;
+        seed = (static_cast<uint64_t>(rd()) << 32) | rd();
+    }
+    // 编号回绕后跳过 0 与仍在使用的编号；会话数小于 max_sessions，总能找到空闲编号
+    uint32_t id = next_id;
+    while (id == 0 || sessions.count(id)) id++;
+    next_id = id + 1;
+
+    LiveSlot& slot = claim_slot();
+    slot.game->init(seed);
+    slot.session = id;
+    slot.last_used = ++clock;
+    Session& s = sessions[id];
+    s.live_slot = static_cast<int>(&slot - live.data());
+    return id;
+}
+
+Game* SessionStore::acquire(uint32_t id) {
+    auto it = sessions.find(id);
+    if (it == sessions.end()) return nullptr;
+    if (it->second.live_slot < 0) {
+        LiveSlot& slot = claim_slot();
+        // claim_slot 可能改写 sessions 中其他条目，但不会增删，迭代器仍有效
+        if (!slot.game->load_snapshot(it->second.blob)) return nullptr;
+        slot.session = id;
+        it->second.live_slot = static_cast<int>(&slot - live.data());
+        loads++;
+    }
+    LiveSlot& slot = live[it->second.live_slot];
+    slot.last_used = ++clock;
+    return slot.game.get();
+}
+
+bool SessionStore::close(uint32_t id) {
+    auto it = sessions.find(id);
+    if (it == sessions.end()) return false;
+    if (it->second.live_slot >= 0) live[it->second.live_slot].session = 0;
+    sessions.erase(it);
+    return true;
+}
@@ -0,0 +1,58 @@
+#ifndef SESSION_STORE_H
+#define SESSION_STORE_H
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include "core/Snapshot.h"
+
+class Game;
+
+/**
+ * SessionStore 类：服务器上所有对局的存放处，内存有上限
+ *
+ * - 最多 max_live 局以完整 Game 对象常驻（每局自带 arena），其余对局以
+ *   GameSnapshot 二进制块（约 0.5 KB）保存
+ * - acquire() 访问不在内存中的对局时，把最久未用的常驻对局写回快照块，
+ *   再把目标对局载入腾出的 Game 对象（Game 对象本身复用，不重复分配）
+ * - 对局总数上限为 max_sessions，超出时 create() 失败
+ */
+class SessionStore {
+public:
+    SessionStore(std::size_t max_live, std::size_t max_sessions);
+    ~SessionStore();
+
+    // 新建一局，返回会话号；达到上限时返回 0
+    uint32_t create(uint64_t seed);
+    // 取得可操作的 Game（必要时换入内存）；会话不存在返回 nullptr
+    Game* acquire(uint32_t id);
+    bool close(uint32_t id);
+
+    std::size_t session_count() const { return sessions.size(); }
+    std::size_t live_count() const;
+    uint64_t swap_ins() const { return loads; }
+
+private:
+    struct Session {
+        GameSnapshot blob;      // 不常驻时的完整状态
+        int live_slot = -1;     // 常驻时所在的槽位
+    };
+    struct LiveSlot {
+        std::unique_ptr<Game> game;
+        uint32_t session = 0;   // 0 = 空闲
+        uint64_t last_used = 0;
+    };
+
+    LiveSlot& claim_slot();     // 找空槽，或换出最久未用的对局
+
+    std::unordered_map<uint32_t, Session> sessions;
+    std::vector<LiveSlot> live;
+    std::size_t max_sessions;
+    uint32_t next_id = 1;
+    uint64_t clock = 0;
+    uint64_t loads = 0;
+};
+
+#endif
@@ -1,6 +1,9 @@
 #include "CostCalculator.h"
 #include "player/Player.h"
 #include "cards/Card.h"
+#include "cards/Wonder.h"
+#include "instrument/AllocTracker.h"
+#include "instrument/Profiler.h"
 #include <algorithm>
 #include <map>
 
@@ -21,29 +24,45 @@ int CostCalculator::calculate_trade_cost(const Player& buyer, const Player& sell
 CostCalculator::BuildCostResult CostCalculator::calculate_build_cost(
     const Player& player, const Player& opponent, const Card& card
 ) {
-    BuildCostResult result;
-    result.can_build = true;
-    result.total_coin_cost = 0;
-
+    SWD_ALLOC_PHASE(AllocPhase::COST);
+    SWD_PROFILE_SCOPE(ProfilePoint::COST_CALC);
     // 1. 连锁免费判定
     if (card.can_be_free(player)) {
+        BuildCostResult result;
         result.is_free_by_chain = true;
         return result;
     }
+    return calculate_cost(player, opponent, card.cost);
+}
+
+CostCalculator::BuildCostResult CostCalculator::calculate_wonder_cost(
+    const Player& player, const Player& opponent, const Wonder& wonder
+) {
+    SWD_ALLOC_PHASE(AllocPhase::COST);
+    SWD_PROFILE_SCOPE(ProfilePoint::COST_CALC);
+    return calculate_cost(player, opponent, wonder.cost);
+}
+
+CostCalculator::BuildCostResult CostCalculator::calculate_cost(
+    const Player& player, const Player& opponent, const std::map<Resource, int>& cost
+) {
+    BuildCostResult result;
+    result.can_build = true;
+    result.total_coin_cost = 0;
 
     // 2. 初始金币成本
-    auto it_coin = card.cost.find(Resource::COIN);
-    if (it_coin != card.cost.end()) {
+    auto it_coin = cost.find(Resource::COIN);
+    if (it_coin != cost.end()) {
         result.total_coin_cost += it_coin->second;
     }
 
-    // 3. 建立临时缺口统计 Map
-    std::map<Resource, int> current_shortages;
-    for (auto const& [res, req] : card.cost) {
+    // 3. 建立临时缺口统计表（按 Resource 下标的定长数组，热路径上不分配内存）
+    int current_shortages[kResourceSlots] = {};
+    for (auto const& [res, req] : cost) {
         if (res == Resource::COIN) continue;
         int produced = player.get_resource(res);
         if (produced < req) {
-            current_shortages[res] = req - produced;
+            current_shortages[static_cast<int>(res)] = req - produced;
         }
     }
 
@@ -52,15 +71,17 @@ CostCalculator::BuildCostResult CostCalculator::calculate_build_cost(
     for (const auto& options : wildcards) {
         bool used_this_wildcard = false;
         for (Resource opt : options) {
-            if (!used_this_wildcard && current_shortages.count(opt) && current_shortages[opt] > 0) {
-                current_shortages[opt]--;
+            if (!used_this_wildcard && current_shortages[static_cast<int>(opt)] > 0) {
+                current_shortages[static_cast<int>(opt)]--;
                 used_this_wildcard = true; // 确保一张多选一卡只抵扣一个资源
             }
         }
     }
 
     // 5. 计算剩余缺口的购买费
-    for (auto const& [res, amt] : current_shortages) {
+    for (int i = 0; i < kResourceSlots; ++i) {
+        int amt = current_shortages[i];
+        Resource res = static_cast<Resource>(i);
         if (amt <= 0) continue;
         if (is_tradable_resource(res)) {
             int price = calculate_trade_cost(player, opponent, res);
@@ -92,4 +113,17 @@ bool CostCalculator::execute_build(Player& player, const Player& opponent, const
         if (!player.spend_coins(res.total_coin_cost)) return false;
     }
     return true;
-}
\ No newline at end of file
+}
+
+bool CostCalculator::can_afford_wonder(const Player& player, const Player& opponent, const Wonder& wonder) {
+    return calculate_wonder_cost(player, opponent, wonder).can_build;
+}
+
+bool CostCalculator::execute_wonder_build(Player& player, const Player& opponent, const Wonder& wonder) {
+    BuildCostResult res = calculate_wonder_cost(player, opponent, wonder);
+    if (!res.can_build) return false;
+    if (res.total_coin_cost > 0) {
+        if (!player.spend_coins(res.total_coin_cost)) return false;
+    }
+    return true;
+}
@@ -7,6 +7,7 @@
 // 前向声明，减少物理依赖并防止循环引用
 class Player;
 class Card;
+class Wonder;
 enum class Resource;
 
 /**
@@ -51,7 +52,22 @@ public:
      */
     static bool execute_build(Player& player, const Player& opponent, const Card& card);
 
+    /**
+     * 奇迹的建造成本：与卡牌相同的缺口 -> 多选一抵扣 -> 交易费流程，奇迹没有连锁免费
+     */
+    static BuildCostResult calculate_wonder_cost(const Player& player, const Player& opponent, const Wonder& wonder);
+    static bool can_afford_wonder(const Player& player, const Player& opponent, const Wonder& wonder);
+    static bool execute_wonder_build(Player& player, const Player& opponent, const Wonder& wonder);
+
 private:
+    /**
+     * 按成本表计算金币支出与可负担性（卡牌与奇迹共用，不含连锁判定）
+     */
+    static BuildCostResult calculate_cost(const Player& player, const Player& opponent, const std::map<Resource, int>& cost);
+
+    // 缺口表长度：覆盖 Resource 的全部枚举值 (WOOD .. LAW)
+    static constexpr int kResourceSlots = 14;
+
     /**
      * 辅助函数：判断某种资源是否属于可以通过金币向银行购买的范畴
      * (WOOD, CLAY, STONE, GLASS, PAPYRUS 为 true，其余为 false)
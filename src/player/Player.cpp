@@ -1,33 +1,59 @@
 #include "Player.h"
+#include "cards/Card.h"
+#include "core/Snapshot.h"
+#include "core/GameEvents.h"
+#include "core/PositionHash.h"
+#include <cstring>
 #include <algorithm>
 #include <iostream>
 #include <stdexcept>
+#include <string_view>
 
 // --- 构造函数 ---
 // 初始化所有基础数值，确保不产生随机垃圾值
-Player::Player(const std::string& playerName, PlayerType playerType) 
+Player::Player(const std::string& playerName, PlayerType playerType, std::pmr::memory_resource* memory) 
     : name(playerName), type(playerType), coins(7), 
-      military_tokens(0), victory_points(0), built_wonders_count(0) {
+      military_tokens(0), victory_points(0), built_wonders_count(0),
+      resources(memory), wildcard_resources(memory), fixed_trade_costs(memory),
+      cards_by_color(memory), built_card_names(memory), owned_link_symbols(memory),
+      science_symbols(memory), wonders(memory) {
 }
 
 // --- 经济管理 ---
 
 void Player::add_coins(int amount) {
     // 允许传入负数进行扣款，并确保余额不会低于 0（规则书 P14 保护逻辑）
+    int before = coins;
     coins += amount;
     if (coins < 0) coins = 0; 
+    if (events && coins != before) events->publish(CoinsChanged{seat, coins - before, coins});
 }
 
 bool Player::spend_coins(int amount) {
     if (coins < amount) return false;
     coins -= amount;
+    if (events && amount != 0) events->publish(CoinsChanged{seat, -amount, coins});
     return true;
 }
 
 // --- 资源产出与交易逻辑 ---
 
+void Player::add_victory_points(int amount) {
+    victory_points += amount;
+    if (events && amount != 0) events->publish(VictoryPointsChanged{seat, amount, victory_points});
+}
+
 void Player::add_resource(Resource res, int amount) {
-    if (amount > 0) resources[res] += amount;
+    if (amount <= 0) return;
+    resources[res] += amount;
+    if (events) events->publish(EconomyChanged{seat});
+}
+
+void Player::remove_resource(Resource res, int amount) {
+    auto it = resources.find(res);
+    if (it == resources.end()) return;
+    it->second = std::max(0, it->second - amount);
+    if (events) events->publish(EconomyChanged{seat});
 }
 
 int Player::get_resource(Resource res) const {
@@ -41,12 +67,21 @@ int Player::get_resource(Resource res) const {
 
 void Player::add_resource_choice(const std::set<Resource>& options) {
     if (!options.empty()) {
-        wildcard_resources.push_back(options);
+        wildcard_resources.emplace_back(options.begin(), options.end());
+        if (events) events->publish(EconomyChanged{seat});
+    }
+}
+
+void Player::add_resource_choice(std::initializer_list<Resource> options) {
+    if (options.size() > 0) {
+        wildcard_resources.emplace_back(options.begin(), options.end());
+        if (events) events->publish(EconomyChanged{seat});
     }
 }
 
 void Player::set_fixed_trade_cost(Resource res, int cost) {
     fixed_trade_costs[res] = cost;
+    if (events) events->publish(EconomyChanged{seat});
 }
 
 int Player::get_trade_cost(Resource res) const {
@@ -61,12 +96,22 @@ int Player::get_trade_cost(Resource res) const {
 // --- 卡牌管理与统计 ---
 
 void Player::add_built_card(const std::string& cardName, Color cardColor) {
-    built_card_names.push_back(cardName);
+    built_card_names.emplace_back(cardName.data(), cardName.size());
     cards_by_color[cardColor]++;
 }
 
 bool Player::has_card(const std::string& cardName) const {
-    return std::find(built_card_names.begin(), built_card_names.end(), cardName) != built_card_names.end();
+    return std::find_if(built_card_names.begin(), built_card_names.end(),
+                        [&](const std::pmr::string& n) { return std::string_view(n) == cardName; }) != built_card_names.end();
+}
+
+void Player::remove_built_card(int idx, Color cardColor) {
+    if (idx < 0 || idx >= (int)built_card_names.size()) {
+        throw std::out_of_range("Player::remove_built_card - index out of range");
+    }
+    built_card_names.erase(built_card_names.begin() + idx);
+    auto it = cards_by_color.find(cardColor);
+    if (it != cards_by_color.end() && it->second > 0) it->second--;
 }
 
 int Player::get_card_count_by_color(Color color) const {
@@ -112,6 +157,13 @@ Wonder& Player::get_wonder(int idx) {
     return wonders[idx];
 }
 
+const Wonder& Player::get_wonder(int idx) const {
+    if (idx < 0 || idx >= (int)wonders.size()) {
+        throw std::out_of_range("Player::get_wonder - Index out of range");
+    }
+    return wonders[idx];
+}
+
 int Player::count_wonder_stages() const {
     return built_wonders_count;
 }
@@ -127,6 +179,7 @@ void Player::add_science_symbol(Resource symbol) {
     // 判定是否属于科技符号区间 (COMPASS 到 LAW)
     if (symbol >= Resource::COMPASS && symbol <= Resource::LAW) {
         science_symbols.insert(symbol);
+        if (events) events->publish(ScienceSymbolGained{seat, symbol, get_unique_science_count()});
     }
 }
 
@@ -135,15 +188,6 @@ int Player::get_unique_science_count() const {
     return static_cast<int>(science_symbols.size());
 }
 
-void Player::destroy_card_by_color(Color color) {
-    // 奇迹破坏效果：减少对手某色卡牌计数
-    auto it = cards_by_color.find(color);
-    if (it != cards_by_color.end() && it->second > 0) {
-        it->second--;
-        std::cout << "[Effect] " << name << " lost a card of color " << (int)color << std::endl;
-    }
-}
-
 // --- 最终结算 ---
 
 int Player::calculate_final_score() const {
@@ -152,4 +196,122 @@ int Player::calculate_final_score() const {
     // 2. 现金换分：每 3 元换 1 分 (规则书 P13)
     total += (coins / 3);
     return total;
-}
\ No newline at end of file
+}
+
+// --- 局面哈希 ---
+
+uint64_t Player::hash_state(uint64_t h) const {
+    h = hash_mix(h, static_cast<uint64_t>(coins) | static_cast<uint64_t>(victory_points) << 16 |
+                    static_cast<uint64_t>(military_tokens) << 32 | static_cast<uint64_t>(progress_tokens) << 48);
+    for (auto const& [res, amount] : resources) h = hash_mix(h, (int)res << 8 | amount);
+    for (auto const& [res, cost] : fixed_trade_costs) h = hash_mix(h, 0x100000 | (int)res << 8 | cost);
+    for (auto const& [color, count] : cards_by_color) h = hash_mix(h, 0x200000 | (int)color << 8 | count);
+    uint64_t symbols = 0;
+    for (LinkSymbol sym : owned_link_symbols) symbols |= 1ull << (int)sym;
+    for (Resource sym : science_symbols) symbols |= 1ull << (32 + (int)sym);
+    h = hash_mix(h, symbols);
+    for (const auto& options : wildcard_resources) {
+        uint64_t mask = 0;
+        for (Resource r : options) mask |= 1ull << (int)r;
+        h = hash_mix(h, 0x300000 | mask);
+    }
+    for (const Wonder& w : wonders) h = hash_mix(h, 0x400000 | w.id << 1 | (w.is_built ? 1 : 0));
+    return h;
+}
+
+// --- 快照 ---
+
+void Player::save_state(GameSnapshot& snap, int slot) const {
+    GameSnapshot::PlayerState& ps = snap.players[slot];
+    std::memset(&ps, 0, sizeof(ps));
+    std::strncpy(ps.name, name.c_str(), sizeof(ps.name) - 1);
+    ps.type = static_cast<uint8_t>(type);
+    ps.built_wonders_count = static_cast<uint8_t>(built_wonders_count);
+    ps.coins = static_cast<int16_t>(coins);
+    ps.military_tokens = static_cast<int16_t>(military_tokens);
+    ps.victory_points = static_cast<int16_t>(victory_points);
+    ps.progress_tokens = progress_tokens;
+
+    for (auto const& [res, amount] : resources) ps.resources[(int)res] = static_cast<uint8_t>(amount);
+    for (auto const& [res, cost] : fixed_trade_costs) ps.fixed_trade_costs[(int)res] = static_cast<uint8_t>(cost);
+    for (auto const& [color, count] : cards_by_color) ps.cards_by_color[(int)color] = static_cast<uint8_t>(count);
+    for (LinkSymbol sym : owned_link_symbols) ps.link_symbols |= (1u << (int)sym);
+    for (Resource sym : science_symbols) ps.science_symbols |= static_cast<uint16_t>(1u << (int)sym);
+
+    if (wildcard_resources.size() > GameSnapshot::kMaxWildcards ||
+        built_card_names.size() > GameSnapshot::kMaxBuiltCards ||
+        wonders.size() > GameSnapshot::kMaxWonders) {
+        throw std::runtime_error("Player::save_state - state exceeds snapshot capacity");
+    }
+
+    ps.wildcard_count = static_cast<uint8_t>(wildcard_resources.size());
+    for (int i = 0; i < (int)wildcard_resources.size(); ++i) {
+        for (Resource r : wildcard_resources[i]) ps.wildcards[i] |= static_cast<uint16_t>(1u << (int)r);
+    }
+
+    ps.built_card_count = static_cast<uint8_t>(built_card_names.size());
+    for (int i = 0; i < (int)built_card_names.size(); ++i) {
+        int id = find_card_id(built_card_names[i]);
+        ps.built_cards[i] = (id < 0) ? GameSnapshot::kEmpty : static_cast<uint8_t>(id);
+    }
+
+    ps.wonder_count = static_cast<uint8_t>(wonders.size());
+    for (int i = 0; i < (int)wonders.size(); ++i) {
+        ps.wonders[i] = static_cast<uint8_t>(wonders[i].id);
+        ps.wonder_built[i] = wonders[i].is_built ? 1 : 0;
+        ps.wonder_foundation[i] = wonders[i].foundation < 0 ? GameSnapshot::kEmpty : static_cast<uint8_t>(wonders[i].foundation);
+    }
+}
+
+void Player::load_state(const GameSnapshot& snap, int slot) {
+    const GameSnapshot::PlayerState& ps = snap.players[slot];
+    name.assign(ps.name, strnlen(ps.name, sizeof(ps.name)));
+    type = static_cast<PlayerType>(ps.type);
+    built_wonders_count = ps.built_wonders_count;
+    coins = ps.coins;
+    military_tokens = ps.military_tokens;
+    victory_points = ps.victory_points;
+    progress_tokens = ps.progress_tokens;
+
+    resources.clear();
+    fixed_trade_costs.clear();
+    cards_by_color.clear();
+    owned_link_symbols.clear();
+    science_symbols.clear();
+    for (int r = 0; r < GameSnapshot::kResourceCount; ++r) {
+        if (ps.resources[r]) resources[static_cast<Resource>(r)] = ps.resources[r];
+        if (ps.fixed_trade_costs[r]) fixed_trade_costs[static_cast<Resource>(r)] = ps.fixed_trade_costs[r];
+        if (ps.science_symbols & (1u << r)) science_symbols.insert(static_cast<Resource>(r));
+    }
+    for (int c = 0; c < GameSnapshot::kColorCount; ++c) {
+        if (ps.cards_by_color[c]) cards_by_color[static_cast<Color>(c)] = ps.cards_by_color[c];
+    }
+    for (int l = 0; l < 32; ++l) {
+        if (ps.link_symbols & (1u << l)) owned_link_symbols.insert(static_cast<LinkSymbol>(l));
+    }
+
+    wildcard_resources.clear();
+    for (int i = 0; i < ps.wildcard_count; ++i) {
+        auto& options = wildcard_resources.emplace_back();
+        for (int r = 0; r < GameSnapshot::kResourceCount; ++r) {
+            if (ps.wildcards[i] & (1u << r)) options.insert(static_cast<Resource>(r));
+        }
+    }
+
+    const auto& catalog = card_catalog();
+    built_card_names.clear();
+    for (int i = 0; i < ps.built_card_count; ++i) {
+        uint8_t id = ps.built_cards[i];
+        if (id < catalog.size()) built_card_names.emplace_back(catalog[id]->name.data(), catalog[id]->name.size());
+        else built_card_names.emplace_back();
+    }
+
+    const auto& all_wonders = wonder_catalog();
+    wonders.clear();
+    for (int i = 0; i < ps.wonder_count; ++i) {
+        if (ps.wonders[i] >= all_wonders.size()) continue;
+        wonders.push_back(all_wonders[ps.wonders[i]]);
+        wonders.back().is_built = ps.wonder_built[i] != 0;
+        wonders.back().foundation = ps.wonder_foundation[i] == GameSnapshot::kEmpty ? -1 : ps.wonder_foundation[i];
+    }
+}
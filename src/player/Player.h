@@ -8,6 +8,11 @@
 #include <string>
 #include <set>
 #include <memory>
+#include <memory_resource>
+#include <initializer_list>
+
+struct GameSnapshot;
+class EventBus;
 
 class Player {
 private:
@@ -18,32 +23,46 @@ private:
     int victory_points;
     int built_wonders_count; 
 
-    std::map<Resource, int> resources;                  
-    std::vector<std::set<Resource>> wildcard_resources;  
-    std::map<Resource, int> fixed_trade_costs;          
+    // 以下容器统一从构造时传入的内存资源分配（对局中为该局的 GameArena）
+    std::pmr::map<Resource, int> resources;                  
+    std::pmr::vector<std::pmr::set<Resource>> wildcard_resources;  
+    std::pmr::map<Resource, int> fixed_trade_costs;          
+
+    std::pmr::map<Color, int> cards_by_color;                
+    std::pmr::vector<std::pmr::string> built_card_names;          
+    std::pmr::set<LinkSymbol> owned_link_symbols;            
+    std::pmr::set<Resource> science_symbols;                 
+    std::pmr::vector<Wonder> wonders;                        
+
+    uint16_t progress_tokens = 0;  // 已获得的进步标记（按 ProgressToken 取位）
 
-    std::map<Color, int> cards_by_color;                
-    std::vector<std::string> built_card_names;          
-    std::set<LinkSymbol> owned_link_symbols;            
-    std::set<Resource> science_symbols;                 
-    std::vector<Wonder> wonders;                        
+    EventBus* events = nullptr;   // 金币变化、卡牌被拆等事件的发布目标
+    int seat = 0;                 // 座位号（0 = Player 1, 1 = Player 2）
 
 public:
-    Player(const std::string& playerName = "Player", PlayerType playerType = PlayerType::HUMAN);
+    Player(const std::string& playerName = "Player", PlayerType playerType = PlayerType::HUMAN,
+           std::pmr::memory_resource* memory = std::pmr::get_default_resource());
+
+    // 关联对局的事件总线与座位号
+    void attach_events(EventBus* bus, int seat_index) { events = bus; seat = seat_index; }
+    int get_seat() const { return seat; }
 
     // --- 基础信息 ---
-    std::string get_name() const { return name; } // 短函数可以留在.h
+    const std::string& get_name() const { return name; } // 短函数可以留在.h
     int get_coins() const { return coins; }
     void add_coins(int amount); 
     bool spend_coins(int amount);
-    void add_victory_points(int amount) { victory_points += amount; }
+    void add_victory_points(int amount);
     int get_victory_points() const { return victory_points; }
 
     // --- 资源与交易 ---
     void add_resource(Resource res, int amount);
+    void remove_resource(Resource res, int amount);   // 卡牌被拆时撤销其产出
     int get_resource(Resource res) const;
     void add_resource_choice(const std::set<Resource>& options);
-    const std::vector<std::set<Resource>>& get_wildcard_resources() const { return wildcard_resources; }
+    // 卡牌效果常用的 {A, B} 写法：直接在本局 arena 中建集合，不经过临时 std::set
+    void add_resource_choice(std::initializer_list<Resource> options);
+    const std::pmr::vector<std::pmr::set<Resource>>& get_wildcard_resources() const { return wildcard_resources; }
     
     // 重点：这里只留声明，不要写大括号实现
     void set_fixed_trade_cost(Resource res, int cost);
@@ -53,6 +72,9 @@ public:
     void add_built_card(const std::string& cardName, Color cardColor);
     int get_card_count_by_color(Color color) const;
     bool has_card(const std::string& cardName) const;
+    const std::pmr::vector<std::pmr::string>& get_built_card_names() const { return built_card_names; }
+    // 移除第 idx 张已建卡牌（被对手奇迹拆掉）
+    void remove_built_card(int idx, Color cardColor);
     
     // 重点：只留声明
     void add_chain_symbol(LinkSymbol symbol);
@@ -70,6 +92,8 @@ public:
     // --- 奇迹管理 ---
     void add_wonder(const Wonder& w);
     Wonder& get_wonder(int idx);
+    const Wonder& get_wonder(int idx) const;
+    int get_wonder_count() const { return static_cast<int>(wonders.size()); }
     int count_wonder_stages() const;
     void increment_wonder_count();
 
@@ -78,9 +102,18 @@ public:
     int get_military_tokens() const;
     void add_science_symbol(Resource symbol);
     int get_unique_science_count() const;
-    void destroy_card_by_color(Color color);           
+
+    // --- 进步标记 ---
+    void add_progress_token(ProgressToken token) { progress_tokens |= static_cast<uint16_t>(1u << (int)token); }
+    bool has_progress_token(ProgressToken token) const { return progress_tokens & (1u << (int)token); }
 
     int calculate_final_score() const;
+
+    // --- 快照（slot 为 0/1，对应 GameSnapshot::players 下标）---
+    void save_state(GameSnapshot& snap, int slot) const;
+    void load_state(const GameSnapshot& snap, int slot);
+    // 把全部对局相关字段混入局面哈希（名称除外；已建卡牌由 Game 按卡牌编号与顺序无关地混入）
+    uint64_t hash_state(uint64_t h) const;
 };
 
 #endif
\ No newline at end of file
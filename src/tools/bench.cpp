@@ -0,0 +1,413 @@
+// bench.cpp —— 引擎热路径的微基准：每次操作的耗时与堆分配次数
+//
+// 用法: bench [--filter SUBSTR] [--min-time SEC] [--repeat N] [--json] [--list]
+//   每个基准先预热一批，再重复 N 轮（默认 5），每轮连续执行若干批直到累计计时不少于 SEC 秒（默认 0.2）；
+//   报告各轮 ns/op 的中位数与最小值，以及计时区间内的平均分配次数/字节数（每次操作）。
+//   批与批之间的准备工作（重置对局、重建金字塔）不计时、不计分配。
+//   输入全部由固定种子生成，不同提交之间跑的是同一组操作。
+//   --json    以 JSON 输出（便于脚本跨提交比较），否则打印对齐的表格
+//   --filter  只运行名称包含 SUBSTR 的基准
+//
+// 分配计数：以 -DSWD_ALLOC_TRACKING=ON 编译时取 AllocTracker 的线程计数；
+// 否则本程序自行替换全局 operator new（只计数，不改变分配方式）。
+#include "ai/BatchPlayout.h"
+#include "ai/Playout.h"
+#include "cards/Card.h"
+#include "cards/CardStructure.h"
+#include "cards/Wonder.h"
+#include "core/Game.h"
+#include "core/Snapshot.h"
+#include "instrument/AllocTracker.h"
+#include "player/CostCalculator.h"
+#include "player/Player.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+// --- 分配计数 ---
+
+#ifndef SWD_ENABLE_ALLOC_TRACKING
+namespace {
+uint64_t g_allocs = 0;
+uint64_t g_bytes = 0;
+
+void* counted_alloc(std::size_t size) noexcept {
+    ++g_allocs;
+    g_bytes += size;
+    return std::malloc(size ? size : 1);
+}
+} // namespace
+
+void* operator new(std::size_t size) {
+    void* p = counted_alloc(size);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+void* operator new[](std::size_t size) {
+    void* p = counted_alloc(size);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return counted_alloc(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return counted_alloc(size); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+#endif
+
+namespace {
+
+struct AllocCount {
+    uint64_t allocs = 0;
+    uint64_t bytes = 0;
+};
+
+AllocCount alloc_count() {
+    AllocCount c;
+#ifdef SWD_ENABLE_ALLOC_TRACKING
+    for (int p = 0; p < static_cast<int>(AllocPhase::COUNT); ++p) {
+        const AllocTracker::Counters t = AllocTracker::thread_counters(static_cast<AllocPhase>(p));
+        c.allocs += t.allocs;
+        c.bytes += t.bytes;
+    }
+#else
+    c.allocs = g_allocs;
+    c.bytes = g_bytes;
+#endif
+    return c;
+}
+
+// 防止被测调用的结果被优化掉
+volatile uint64_t g_sink = 0;
+
+// ===== 基准定义 =====
+
+struct Benchmark {
+    std::string name;
+    std::function<void()> prepare;     // 每批之前调用，不计时（可为空）
+    std::function<uint64_t()> batch;   // 执行一批，返回操作数
+};
+
+struct Result {
+    std::string name;
+    double ns_median = 0;
+    double ns_min = 0;
+    double allocs_per_op = 0;
+    double bytes_per_op = 0;
+    uint64_t ops = 0;
+};
+
+// 代表性局面：若干种子各自随机走到开局、第二时代与第三时代
+std::vector<GameSnapshot> sample_positions() {
+    std::vector<GameSnapshot> out;
+    for (uint64_t seed = 1; seed <= 16; ++seed) {
+        for (int plies : {0, 30, 55}) {
+            Game game;
+            game.init(seed);
+            Playout<RandomPolicy, NullSink> playout(RandomPolicy(seed * 1000 + plies));
+            playout.run(game, plies);
+            if (game.is_over()) continue;
+            GameSnapshot snap;
+            game.save_snapshot(snap);
+            out.push_back(snap);
+        }
+    }
+    return out;
+}
+
+std::vector<std::unique_ptr<Game>> load_positions(const std::vector<GameSnapshot>& snaps) {
+    std::vector<std::unique_ptr<Game>> games;
+    for (const GameSnapshot& snap : snaps) {
+        games.push_back(std::make_unique<Game>());
+        games.back()->load_snapshot(snap);
+    }
+    return games;
+}
+
+// 与发牌相同的方式取某时代的 20 张牌（固定种子）
+std::vector<int> age_deck_ids(int age) {
+    std::vector<int> ids;
+    for (const auto& card : card_catalog()) {
+        if (card->age == age) ids.push_back(card->id);
+    }
+    std::mt19937 g = Game::seeded_rng(1, age);
+    std::shuffle(ids.begin(), ids.end(), g);
+    ids.resize(rules::kPyramidSlots);
+    return ids;
+}
+
+std::unique_ptr<CardStructure> build_structure(int age, const std::vector<int>& ids) {
+    std::vector<std::unique_ptr<Card>> deck;
+    deck.reserve(ids.size());
+    for (int id : ids) deck.push_back(clone_card(id));
+    return std::make_unique<CardStructure>(age, std::move(deck));
+}
+
+std::vector<Benchmark> make_benchmarks() {
+    std::vector<Benchmark> list;
+    const std::vector<GameSnapshot> positions = sample_positions();
+
+    // --- CostCalculator：各代表性局面下当前玩家对每张可拿取卡牌的建造成本 ---
+    {
+        auto games = std::make_shared<std::vector<std::unique_ptr<Game>>>(load_positions(positions));
+        struct Query { Player* self; Player* opp; const Card* card; };
+        auto queries = std::make_shared<std::vector<Query>>();
+        for (auto& game : *games) {
+            std::vector<int> open;
+            game->get_structure().collect_accessible(open);
+            for (int pos : open) {
+                queries->push_back(Query{game->get_current_player(), game->get_opponent(), game->get_structure().get_card(pos)});
+            }
+        }
+        list.push_back({"cost/calculate_build_cost", nullptr, [games, queries]() {
+            uint64_t sum = 0;
+            for (const Query& q : *queries) sum += CostCalculator::calculate_build_cost(*q.self, *q.opp, *q.card).total_coin_cost;
+            g_sink = g_sink + sum;
+            return static_cast<uint64_t>(queries->size());
+        }});
+    }
+
+    // --- CardStructure：按各时代布局构建，以及依次拿走全部卡牌 ---
+    for (int age = 1; age <= rules::kAges; ++age) {
+        const std::vector<int> ids = age_deck_ids(age);
+        list.push_back({"structure/build/age" + std::to_string(age), nullptr, [age, ids]() {
+            constexpr int kBuilds = 16;
+            for (int i = 0; i < kBuilds; ++i) g_sink = g_sink + build_structure(age, ids)->is_empty();
+            return static_cast<uint64_t>(kBuilds);
+        }});
+
+        // 每批准备 16 个新金字塔，计时部分每次拿走编号最小的可拿取卡牌，直到拿空
+        auto fresh = std::make_shared<std::vector<std::unique_ptr<CardStructure>>>();
+        auto open = std::make_shared<std::vector<int>>();
+        list.push_back({"structure/take_card/age" + std::to_string(age),
+                        [age, ids, fresh]() {
+                            fresh->clear();
+                            for (int i = 0; i < 16; ++i) fresh->push_back(build_structure(age, ids));
+                        },
+                        [fresh, open]() {
+                            uint64_t taken = 0;
+                            for (auto& s : *fresh) {
+                                for (s->collect_accessible(*open); !open->empty(); s->collect_accessible(*open)) {
+                                    g_sink = g_sink + s->take_card(*std::min_element(open->begin(), open->end()))->id;
+                                    ++taken;
+                                }
+                            }
+                            return taken;
+                        }});
+    }
+
+    // --- 卡牌与奇迹效果：在开局局面上依次结算目录中的每一项（每批重置局面）---
+    {
+        auto game = std::make_shared<Game>();
+        const GameSnapshot start = positions.front();
+        auto reset = [game, start]() { game->load_snapshot(start); };
+        list.push_back({"effect/card_apply_effect", reset, [game]() {
+            Player& self = *game->get_current_player();
+            for (const auto& card : card_catalog()) card->apply_effect(self, *game);
+            return static_cast<uint64_t>(card_catalog().size());
+        }});
+        list.push_back({"effect/wonder", reset, [game]() {
+            Player& self = *game->get_current_player();
+            Player& opp = *game->get_opponent();
+            uint64_t applied = 0;
+            for (const Wonder& w : wonder_catalog()) {
+                if (!w.effect) continue;
+                w.effect(self, opp, *game);
+                ++applied;
+            }
+            return applied;
+        }});
+    }
+
+    // --- Player 查询：第三时代局面下双方的常用只读接口 ---
+    {
+        std::vector<GameSnapshot> late;
+        for (const GameSnapshot& snap : positions) {
+            if (snap.current_age == rules::kAges) late.push_back(snap);
+        }
+        auto games = std::make_shared<std::vector<std::unique_ptr<Game>>>(load_positions(late.empty() ? positions : late));
+        auto players = std::make_shared<std::vector<const Player*>>();
+        for (auto& game : *games) {
+            players->push_back(&game->get_player(0));
+            players->push_back(&game->get_player(1));
+        }
+        constexpr int kFirstLink = static_cast<int>(LinkSymbol::SWORD);
+        constexpr int kLastLink = static_cast<int>(LinkSymbol::CAPITOL);
+        static const Resource kTradable[] = {Resource::WOOD, Resource::CLAY, Resource::STONE, Resource::GLASS, Resource::PAPYRUS};
+        list.push_back({"player/get_resource", nullptr, [games, players]() {
+            uint64_t sum = 0;
+            for (const Player* p : *players) {
+                for (Resource r : kTradable) sum += p->get_resource(r);
+            }
+            g_sink = g_sink + sum;
+            return static_cast<uint64_t>(players->size() * 5);
+        }});
+        list.push_back({"player/get_trade_cost", nullptr, [games, players]() {
+            uint64_t sum = 0;
+            for (const Player* p : *players) {
+                for (Resource r : kTradable) sum += p->get_trade_cost(r);
+            }
+            g_sink = g_sink + sum;
+            return static_cast<uint64_t>(players->size() * 5);
+        }});
+        list.push_back({"player/get_card_count_by_color", nullptr, [games, players]() {
+            uint64_t sum = 0;
+            for (const Player* p : *players) {
+                for (int c = 0; c <= static_cast<int>(Color::PURPLE); ++c) sum += p->get_card_count_by_color(static_cast<Color>(c));
+            }
+            g_sink = g_sink + sum;
+            return static_cast<uint64_t>(players->size() * (static_cast<int>(Color::PURPLE) + 1));
+        }});
+        list.push_back({"player/has_chain_symbol", nullptr, [games, players]() {
+            uint64_t sum = 0;
+            for (const Player* p : *players) {
+                for (int s = kFirstLink; s <= kLastLink; ++s) sum += p->has_chain_symbol(static_cast<LinkSymbol>(s));
+            }
+            g_sink = g_sink + sum;
+            return static_cast<uint64_t>(players->size() * (kLastLink - kFirstLink + 1));
+        }});
+        auto names = std::make_shared<std::vector<std::string>>();
+        for (int id = 0; id < (int)card_catalog().size(); id += 4) names->push_back(card_catalog()[id]->name);
+        list.push_back({"player/has_card", nullptr, [games, players, names]() {
+            uint64_t sum = 0;
+            for (const Player* p : *players) {
+                for (const std::string& n : *names) sum += p->has_card(n);
+            }
+            g_sink = g_sink + sum;
+            return static_cast<uint64_t>(players->size() * names->size());
+        }});
+    }
+
+    // --- 完整随机对局：逐局驱动 Game，以及结构数组批量模拟器 ---
+    {
+        auto game = std::make_shared<Game>();
+        list.push_back({"playout/game_random", nullptr, [game]() {
+            constexpr int kGames = 8;
+            Playout<RandomPolicy, NullSink> playout(RandomPolicy(1));
+            for (int g = 0; g < kGames; ++g) {
+                game->init(1 + g);
+                g_sink = g_sink + playout.run(*game);
+            }
+            return static_cast<uint64_t>(kGames);
+        }});
+        auto batch = std::make_shared<BatchPlayout>();
+        list.push_back({"playout/batch_random", [batch]() { *batch = BatchPlayout(1); }, [batch]() {
+            const BatchPlayout::Stats stats = batch->play_games(1, 0, 1, 2 * BatchPlayout::kLanes);
+            g_sink = g_sink + stats.wins[0];
+            return static_cast<uint64_t>(stats.games);
+        }});
+    }
+    return list;
+}
+
+// ===== 计时 =====
+
+Result measure(const Benchmark& b, double min_time, int repeat) {
+    using clock = std::chrono::steady_clock;
+    Result r;
+    r.name = b.name;
+    if (b.prepare) b.prepare();
+    b.batch();   // 预热：缓存、惰性初始化与复用缓冲区的首次扩容
+
+    std::vector<double> samples;
+    uint64_t total_ops = 0, total_allocs = 0, total_bytes = 0;
+    for (int rep = 0; rep < repeat; ++rep) {
+        double elapsed = 0;
+        uint64_t ops = 0;
+        while (elapsed < min_time || ops == 0) {
+            if (b.prepare) b.prepare();
+            const AllocCount before = alloc_count();
+            const auto t0 = clock::now();
+            ops += b.batch();
+            const auto t1 = clock::now();
+            const AllocCount after = alloc_count();
+            elapsed += std::chrono::duration<double>(t1 - t0).count();
+            total_allocs += after.allocs - before.allocs;
+            total_bytes += after.bytes - before.bytes;
+        }
+        samples.push_back(elapsed * 1e9 / ops);
+        total_ops += ops;
+    }
+    std::sort(samples.begin(), samples.end());
+    r.ns_median = samples[samples.size() / 2];
+    r.ns_min = samples.front();
+    r.allocs_per_op = static_cast<double>(total_allocs) / total_ops;
+    r.bytes_per_op = static_cast<double>(total_bytes) / total_ops;
+    r.ops = total_ops;
+    return r;
+}
+
+struct Options {
+    std::string filter;
+    double min_time = 0.2;
+    int repeat = 5;
+    bool json = false;
+    bool list = false;
+};
+
+bool parse_options(int argc, char* argv[], Options& opt) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const bool has_value = i + 1 < argc;
+        if (std::strcmp(arg, "--filter") == 0 && has_value) opt.filter = argv[++i];
+        else if (std::strcmp(arg, "--min-time") == 0 && has_value) opt.min_time = std::atof(argv[++i]);
+        else if (std::strcmp(arg, "--repeat") == 0 && has_value) opt.repeat = std::atoi(argv[++i]);
+        else if (std::strcmp(arg, "--json") == 0) opt.json = true;
+        else if (std::strcmp(arg, "--list") == 0) opt.list = true;
+        else return false;
+    }
+    return opt.min_time >= 0 && opt.repeat > 0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options opt;
+    if (!parse_options(argc, argv, opt)) {
+        std::cerr << "Usage: bench [--filter SUBSTR] [--min-time SEC] [--repeat N] [--json] [--list]\n";
+        return 2;
+    }
+
+    const std::vector<Benchmark> benchmarks = make_benchmarks();
+    if (opt.list) {
+        for (const Benchmark& b : benchmarks) std::printf("%s\n", b.name.c_str());
+        return 0;
+    }
+
+    if (opt.json) {
+        std::printf("{\n  \"alloc_counter\": \"%s\",\n  \"min_time\": %g,\n  \"repeat\": %d,\n  \"benchmarks\": [",
+                    AllocTracker::compiled_in() ? "AllocTracker" : "operator new", opt.min_time, opt.repeat);
+    } else {
+        std::printf("%-34s %12s %12s %12s %12s %12s\n", "benchmark", "ns/op", "min ns/op", "allocs/op", "bytes/op", "ops");
+    }
+    bool first = true;
+    for (const Benchmark& b : benchmarks) {
+        if (!opt.filter.empty() && b.name.find(opt.filter) == std::string::npos) continue;
+        const Result r = measure(b, opt.min_time, opt.repeat);
+        if (opt.json) {
+            std::printf("%s\n    {\"name\": \"%s\", \"ns_per_op\": %.3f, \"ns_per_op_min\": %.3f, \"allocs_per_op\": %.4f, "
+                        "\"bytes_per_op\": %.1f, \"ops\": %llu}",
+                        first ? "" : ",", r.name.c_str(), r.ns_median, r.ns_min, r.allocs_per_op, r.bytes_per_op,
+                        static_cast<unsigned long long>(r.ops));
+        } else {
+            std::printf("%-34s %12.1f %12.1f %12.3f %12.1f %12llu\n", r.name.c_str(), r.ns_median, r.ns_min,
+                        r.allocs_per_op, r.bytes_per_op, static_cast<unsigned long long>(r.ops));
+        }
+        std::fflush(stdout);
+        first = false;
+    }
+    if (opt.json) std::printf("\n  ]\n}\n");
+    return 0;
+}
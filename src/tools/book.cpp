@@ -0,0 +1,162 @@
+// book.cpp —— 由自对弈生成开局库，以及查询开局库
+//
+// 用法: swd_book build --out FILE [--seed S] [--seeds N] [--games G] [--plies P] [--threads T]
+//                      [--epsilon E] [--evalfile W]
+//       swd_book probe FILE --seed S [--moves m1 m2 ...]
+//   build  对种子 S..S+N-1（默认 1..64）各自对弈共 G 局（默认每个种子 32 局），
+//          双方为一步贪心机器人（--evalfile 指定权重），每步以概率 E（默认 0.3）改走随机动作以覆盖分支；
+//          记录每局前 P 个决策点（默认 12）的 (局面, 动作, 胜负)，合并后写出 FILE
+//   probe  以种子 S 开局、依次走出 moves，打印当前局面在库中的各动作统计
+#include "ai/GreedyBot.h"
+#include "ai/HeuristicEval.h"
+#include "ai/OpeningBook.h"
+#include "core/Game.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct BuildOptions {
+    std::string out_file;
+    uint64_t seed = 1;
+    int seeds = 64;
+    int games = 0;      // 0 = 每个种子 32 局
+    int plies = 12;
+    int threads = 0;    // 0 = 全部核心
+    double epsilon = 0.3;
+    std::string eval_file;
+};
+
+int usage() {
+    std::cerr << "Usage: swd_book build --out FILE [--seed S] [--seeds N] [--games G] [--plies P] [--threads T]\n"
+                 "                      [--epsilon E] [--evalfile W]\n"
+                 "       swd_book probe FILE --seed S [--moves m1 m2 ...]\n";
+    return 2;
+}
+
+int build(int argc, char* argv[]) {
+    BuildOptions opt;
+    for (int i = 2; i < argc; ++i) {
+        const char* arg = argv[i];
+        const bool has_value = i + 1 < argc;
+        if (std::strcmp(arg, "--out") == 0 && has_value) opt.out_file = argv[++i];
+        else if (std::strcmp(arg, "--seed") == 0 && has_value) opt.seed = std::strtoull(argv[++i], nullptr, 10);
+        else if (std::strcmp(arg, "--seeds") == 0 && has_value) opt.seeds = std::atoi(argv[++i]);
+        else if (std::strcmp(arg, "--games") == 0 && has_value) opt.games = std::atoi(argv[++i]);
+        else if (std::strcmp(arg, "--plies") == 0 && has_value) opt.plies = std::atoi(argv[++i]);
+        else if (std::strcmp(arg, "--threads") == 0 && has_value) opt.threads = std::atoi(argv[++i]);
+        else if (std::strcmp(arg, "--epsilon") == 0 && has_value) opt.epsilon = std::atof(argv[++i]);
+        else if (std::strcmp(arg, "--evalfile") == 0 && has_value) opt.eval_file = argv[++i];
+        else return usage();
+    }
+    if (opt.out_file.empty() || opt.seeds <= 0 || opt.plies <= 0) return usage();
+    if (opt.games <= 0) opt.games = opt.seeds * 32;
+    if (opt.threads <= 0) opt.threads = std::max(1u, std::thread::hardware_concurrency());
+
+    EvalWeights weights;
+    std::string error;
+    if (!opt.eval_file.empty() && !weights.load(opt.eval_file, &error)) {
+        std::cerr << error << "\n";
+        return 1;
+    }
+
+    const auto started = std::chrono::steady_clock::now();
+    std::vector<OpeningBookBuilder> builders(opt.threads);
+    std::atomic<int> next{0};
+    auto worker = [&](int index) {
+        OpeningBookBuilder& builder = builders[index];
+        GreedyBot bot(weights);
+        std::mt19937_64 rng(opt.seed * 0x9E3779B97F4A7C15ull + index);
+        std::uniform_real_distribution<double> unit(0.0, 1.0);
+        std::vector<Move> legal;
+        Game game;
+        for (int g = next.fetch_add(1); g < opt.games; g = next.fetch_add(1)) {
+            game.init(opt.seed + g % opt.seeds);
+            for (int ply = 0; !game.is_over(); ++ply) {
+                game.legal_moves(legal);
+                if (legal.empty()) break;
+                Move move;
+                if (unit(rng) < opt.epsilon) move = legal[std::uniform_int_distribution<std::size_t>(0, legal.size() - 1)(rng)];
+                else move = bot.choose(game, legal);
+                if (ply < opt.plies) builder.record(game, move);
+                game.apply_move(move);
+            }
+            builder.finish(game.get_winner());
+        }
+    };
+    std::vector<std::thread> pool;
+    for (int t = 1; t < opt.threads; ++t) pool.emplace_back(worker, t);
+    worker(0);
+    for (auto& t : pool) t.join();
+    for (int t = 1; t < opt.threads; ++t) builders[0].merge(builders[t]);
+
+    if (!builders[0].write(opt.out_file, &error)) {
+        std::cerr << error << "\n";
+        return 1;
+    }
+    const double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    std::printf("Games: %d | Seeds: %d | Entries: %zu | Time: %.1fs\n", opt.games, opt.seeds, builders[0].size(), secs);
+    return 0;
+}
+
+int probe(int argc, char* argv[]) {
+    if (argc < 3) return usage();
+    uint64_t seed = 1;
+    std::vector<std::string> moves;
+    for (int i = 3; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) seed = std::strtoull(argv[++i], nullptr, 10);
+        else if (std::strcmp(argv[i], "--moves") == 0) {
+            while (i + 1 < argc) moves.push_back(argv[++i]);
+        } else return usage();
+    }
+
+    OpeningBook book;
+    std::string error;
+    if (!book.open(argv[2], &error)) {
+        std::cerr << error << "\n";
+        return 1;
+    }
+    Game game;
+    game.init(seed);
+    for (const std::string& text : moves) {
+        Move m;
+        if (!parse_move_text(text, m) || !game.apply_move(m)) {
+            std::cerr << "illegal move " << text << "\n";
+            return 1;
+        }
+    }
+
+    std::vector<BookMove> found;
+    std::printf("Entries: %llu | Position: %016llx\n", static_cast<unsigned long long>(book.entry_count()),
+                static_cast<unsigned long long>(game.visible_hash()));
+    if (!book.probe(game, found)) {
+        std::printf("not in book\n");
+        return 0;
+    }
+    std::sort(found.begin(), found.end(), [](const BookMove& a, const BookMove& b) { return a.visits > b.visits; });
+    for (const BookMove& m : found) {
+        std::printf("%-8s visits %6u  winrate %.3f\n", move_to_text(m.move).c_str(), m.visits,
+                    static_cast<double>(m.wins) / m.visits);
+    }
+    Move best;
+    if (book.best_move(game, best)) std::printf("best %s\n", move_to_text(best).c_str());
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) return usage();
+    if (std::strcmp(argv[1], "build") == 0) return build(argc, argv);
+    if (std::strcmp(argv[1], "probe") == 0) return probe(argc, argv);
+    return usage();
+}
@@ -0,0 +1,34 @@
+// engine.cpp —— 引擎模式：标准输入/输出上的行式文本协议（见 engine/EngineProtocol.h）
+//
+// 用法: swd_engine [--threads T] [--rollout N] [--evalfile FILE] [--book FILE]
+// 例:   printf 'position seed 7\ngo movetime 500\n' | swd_engine
+#include "engine/EngineProtocol.h"
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+int main(int argc, char* argv[]) {
+    std::ios::sync_with_stdio(false);   // 必须在任何输入输出之前
+    EngineProtocol protocol(std::cout);
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            protocol.handle(std::string("setoption threads ") + argv[++i]);
+        } else if (std::strcmp(argv[i], "--rollout") == 0 && i + 1 < argc) {
+            protocol.handle(std::string("setoption rollout ") + argv[++i]);
+        } else if (std::strcmp(argv[i], "--evalfile") == 0 && i + 1 < argc) {
+            protocol.handle(std::string("setoption evalfile ") + argv[++i]);
+        } else if (std::strcmp(argv[i], "--book") == 0 && i + 1 < argc) {
+            protocol.handle(std::string("setoption bookfile ") + argv[++i]);
+        } else {
+            std::cerr << "Usage: swd_engine [--threads T] [--rollout N] [--evalfile FILE] [--book FILE]" << std::endl;
+            return 2;
+        }
+    }
+
+    std::string line;
+    bool running = true;
+    while (running && std::getline(std::cin, line)) running = protocol.handle(line);
+    if (running) protocol.shutdown();
+    return 0;
+}
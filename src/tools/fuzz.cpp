@@ -0,0 +1,297 @@
+// fuzz.cpp —— 差分模糊测试：对象式规则引擎（Game）与平坦状态参考模型（ai/BatchPlayout.h）逐步对照
+//
+// 用法: swd_fuzz [--games N] [--seed S] [--threads T] [--failures K]
+//       swd_fuzz --replay S m1 m2 ...
+//       swd_fuzz --dump-tables > src/ai/ReferenceTableData.cpp
+//   每个线程一个 BatchPlayout（16 个通道同步随机走子）与 16 个 Game。参考模型每走一步，
+//   同一动作喂给对应的 Game，随后比较：
+//     - 走子前的合法动作数，以及所选动作在 Game 中是否合法
+//     - 走子后的完整状态（BatchPlayout::matches：回合、待决策、金字塔、弃牌堆、标记、双方全部数值与已建卡牌）
+//     - 对局结束时的胜者
+//   第 g 局的发牌种子为 S + g（默认 S = 1，N = 1000000）。发现 K 处分歧（默认 1）后停止，
+//   把每处分歧缩减（delta debugging：截到首个分歧点，再反复删去动作片段直到不能更短）成
+//   最短的可复现动作序列，以 swd_engine 的 position 命令格式打印。
+//   --replay 逐步重放给定序列并比较完整的合法动作集合与状态，打印首个分歧或 "no divergence"。
+//
+//
+// 参考模型的卡牌/奇迹参数取自检入的固定表（ai/ReferenceTables.h），不读卡牌目录。启动时先把
+// 当前目录（卡牌签名与实际执行一次的奇迹效果）与固定表逐字段比对，有差异就列出并以 1 退出；
+// 目录的改动确属有意时，用 --dump-tables 重新生成固定表并检入。
+#include "ai/BatchPlayout.h"
+#include "ai/ReferenceTables.h"
+#include "core/Game.h"
+#include "core/Snapshot.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+namespace {
+
+struct Options {
+    long long games = 1000000;
+    uint64_t seed = 1;
+    int threads = 0;      // 0 = 全部核心
+    int failures = 1;
+};
+
+struct Failure {
+    uint64_t seed = 0;
+    std::vector<Move> moves;   // 走到分歧为止的全部动作
+    std::string diff;
+};
+
+bool move_less(const Move& a, const Move& b) {
+    return std::make_tuple(a.type, a.pos, a.wonder_idx) < std::make_tuple(b.type, b.pos, b.wonder_idx);
+}
+
+std::string moves_text(const std::vector<Move>& moves) {
+    std::string text;
+    for (const Move& m : moves) text += (text.empty() ? "" : " ") + move_to_text(m);
+    return text;
+}
+
+// 一局对照：走子前检查合法动作数与所选动作，走子后比较完整状态
+std::string check_step(Game& game, const BatchPlayout& ref, int lane, std::vector<Move>& legal, GameSnapshot& snap) {
+    game.legal_moves(legal);
+    const Move& m = ref.last_move(lane);
+    if ((int)legal.size() != ref.get_choices(lane)) {
+        return "legal move count: reference " + std::to_string(ref.get_choices(lane)) + ", Game " + std::to_string(legal.size());
+    }
+    if (std::find(legal.begin(), legal.end(), m) == legal.end() || !game.apply_move(m)) {
+        return "move " + move_to_text(m) + " rejected by Game";
+    }
+    game.save_snapshot(snap);
+    std::string diff;
+    if (!ref.matches(lane, snap, &diff)) return diff;
+    if (ref.is_over(lane) && ref.get_winner(lane) != game.get_winner()) {
+        return "winner: reference " + std::to_string(ref.get_winner(lane)) + ", Game " + std::to_string(game.get_winner());
+    }
+    return {};
+}
+
+// ===== 重放与缩减 =====
+
+struct Replay {
+    bool valid = true;          // 序列在两边都合法（走到分歧或结尾）
+    int diverged_at = -1;       // 分歧时已走的动作数；-1 = 无分歧
+    std::string diff;
+};
+
+// 从 seed 开局逐步重放：每个决策点比较完整的合法动作集合，每步之后比较状态
+Replay replay(uint64_t seed, const std::vector<Move>& moves) {
+    Replay result;
+    Game game;
+    game.init(seed);
+    BatchPlayout ref;
+    ref.reset_lane(0, seed);
+    std::vector<Move> mine, theirs;
+    GameSnapshot snap;
+    for (std::size_t i = 0;; ++i) {
+        game.save_snapshot(snap);
+        if (!ref.matches(0, snap, &result.diff)) {
+            result.diverged_at = static_cast<int>(i);
+            return result;
+        }
+        if (i == moves.size()) return result;
+
+        ref.legal_moves(0, mine);
+        game.legal_moves(theirs);
+        std::sort(mine.begin(), mine.end(), move_less);
+        std::sort(theirs.begin(), theirs.end(), move_less);
+        if (mine != theirs) {
+            result.diff = "legal moves: reference {" + moves_text(mine) + "}, Game {" + moves_text(theirs) + "}";
+            result.diverged_at = static_cast<int>(i);
+            return result;
+        }
+        if (!std::binary_search(mine.begin(), mine.end(), moves[i], move_less)) {
+            result.valid = false;
+            return result;
+        }
+        ref.apply_move(0, moves[i]);
+        game.apply_move(moves[i]);
+        if (ref.is_over(0) && ref.get_winner(0) != game.get_winner()) {
+            result.diff = "winner: reference " + std::to_string(ref.get_winner(0)) + ", Game " + std::to_string(game.get_winner());
+            result.diverged_at = static_cast<int>(i + 1);
+            return result;
+        }
+    }
+}
+
+// 缩减到最短可复现序列（ddmin：按片段删除，成功则截到新的分歧点并放粗粒度，失败则细分）
+std::vector<Move> shrink(uint64_t seed, std::vector<Move> moves, std::string& diff) {
+    Replay r = replay(seed, moves);
+    if (r.diverged_at < 0) return moves;   // 逐步重放未能复现（不应出现）
+    moves.resize(r.diverged_at);
+    diff = r.diff;
+
+    std::size_t parts = 2;
+    while (!moves.empty()) {
+        const std::size_t chunk = (moves.size() + parts - 1) / parts;
+        bool reduced = false;
+        for (std::size_t start = 0; start < moves.size(); start += chunk) {
+            std::vector<Move> candidate(moves.begin(), moves.begin() + start);
+            candidate.insert(candidate.end(), moves.begin() + std::min(moves.size(), start + chunk), moves.end());
+            const Replay c = replay(seed, candidate);
+            if (!c.valid || c.diverged_at < 0) continue;
+            candidate.resize(c.diverged_at);
+            moves.swap(candidate);
+            diff = c.diff;
+            parts = std::max<std::size_t>(parts - 1, 2);
+            reduced = true;
+            break;
+        }
+        if (reduced) continue;
+        if (parts >= moves.size()) break;
+        parts = std::min(moves.size(), parts * 2);
+    }
+    return moves;
+}
+
+// ===== 批量对照 =====
+
+int run(const Options& opt) {
+    std::atomic<long long> next{0};
+    std::atomic<long long> finished{0};
+    std::atomic<long long> steps{0};
+    std::atomic<bool> stop{false};
+    std::mutex failures_mutex;
+    std::vector<Failure> failures;
+
+    auto worker = [&](int index) {
+        BatchPlayout ref(opt.seed * 0x9E3779B97F4A7C15ull + index);
+        std::vector<std::unique_ptr<Game>> games(BatchPlayout::kLanes);
+        std::vector<std::vector<Move>> history(BatchPlayout::kLanes);
+        std::vector<uint64_t> lane_seed(BatchPlayout::kLanes);
+        std::vector<Move> legal;
+        legal.reserve(256);
+        GameSnapshot snap;
+        long long local_finished = 0, local_steps = 0;
+
+        auto refill = [&](int l) {
+            const long long g = stop.load(std::memory_order_relaxed) ? opt.games : next.fetch_add(1);
+            if (g >= opt.games) {
+                ref.clear_lane(l);
+                return;
+            }
+            lane_seed[l] = opt.seed + g;
+            ref.reset_lane(l, lane_seed[l]);
+            games[l]->init(lane_seed[l]);
+            history[l].clear();
+        };
+        for (int l = 0; l < BatchPlayout::kLanes; ++l) {
+            games[l] = std::make_unique<Game>();
+            refill(l);
+        }
+
+        while (ref.step() > 0) {
+            for (int l = 0; l < BatchPlayout::kLanes; ++l) {
+                if (!ref.is_active(l)) continue;
+                local_steps++;
+                history[l].push_back(ref.last_move(l));
+                std::string diff = check_step(*games[l], ref, l, legal, snap);
+                if (!diff.empty()) {
+                    std::lock_guard<std::mutex> lock(failures_mutex);
+                    if ((int)failures.size() < opt.failures) failures.push_back(Failure{lane_seed[l], history[l], diff});
+                    if ((int)failures.size() >= opt.failures) stop = true;
+                } else if (!ref.is_over(l)) {
+                    continue;
+                } else {
+                    local_finished++;
+                }
+                refill(l);
+            }
+        }
+        finished.fetch_add(local_finished);
+        steps.fetch_add(local_steps);
+    };
+
+    const auto started = std::chrono::steady_clock::now();
+    std::vector<std::thread> pool;
+    for (int t = 1; t < opt.threads; ++t) pool.emplace_back(worker, t);
+    worker(0);
+    for (auto& t : pool) t.join();
+    const double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+
+    std::printf("Games: %lld | Moves: %lld | Divergences: %zu | Time: %.1fs | %.0f games/s\n", finished.load(),
+                steps.load(), failures.size(), secs, secs > 0 ? finished.load() / secs : 0.0);
+    for (const Failure& f : failures) {
+        std::string diff = f.diff;
+        const std::vector<Move> minimal = shrink(f.seed, f.moves, diff);
+        std::printf("\nDIVERGENCE seed %llu after %zu moves: %s\n", static_cast<unsigned long long>(f.seed),
+                    f.moves.size(), f.diff.c_str());
+        std::printf("minimal (%zu moves): %s\n", minimal.size(), diff.c_str());
+        std::printf("  position seed %llu moves %s\n", static_cast<unsigned long long>(f.seed), moves_text(minimal).c_str());
+    }
+    return failures.empty() ? 0 : 1;
+}
+
+int run_replay(int argc, char* argv[]) {
+    if (argc < 3) return 2;
+    const uint64_t seed = std::strtoull(argv[2], nullptr, 10);
+    std::vector<Move> moves;
+    for (int i = 3; i < argc; ++i) {
+        Move m;
+        if (!parse_move_text(argv[i], m)) {
+            std::cerr << "cannot parse move " << argv[i] << "\n";
+            return 2;
+        }
+        moves.push_back(m);
+    }
+    const Replay r = replay(seed, moves);
+    if (r.diverged_at >= 0) {
+        std::printf("divergence after %d moves: %s\n", r.diverged_at, r.diff.c_str());
+        return 1;
+    }
+    std::printf(r.valid ? "no divergence\n" : "no divergence (sequence stops at an illegal move)\n");
+    return 0;
+}
+
+bool parse_options(int argc, char* argv[], Options& opt) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const bool has_value = i + 1 < argc;
+        if (std::strcmp(arg, "--games") == 0 && has_value) opt.games = std::atoll(argv[++i]);
+        else if (std::strcmp(arg, "--seed") == 0 && has_value) opt.seed = std::strtoull(argv[++i], nullptr, 10);
+        else if (std::strcmp(arg, "--threads") == 0 && has_value) opt.threads = std::atoi(argv[++i]);
+        else if (std::strcmp(arg, "--failures") == 0 && has_value) opt.failures = std::atoi(argv[++i]);
+        else return false;
+    }
+    return opt.games > 0 && opt.failures > 0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options opt;
+    if (argc == 2 && std::strcmp(argv[1], "--dump-tables") == 0) {
+        std::cout << reference::dump_catalog_source();
+        return 0;
+    }
+    const bool replaying = argc >= 2 && std::strcmp(argv[1], "--replay") == 0;
+    if (replaying ? argc < 3 : !parse_options(argc, argv, opt)) {
+        std::cerr << "Usage: swd_fuzz [--games N] [--seed S] [--threads T] [--failures K]\n"
+                     "       swd_fuzz --replay S m1 m2 ...\n"
+                     "       swd_fuzz --dump-tables\n";
+        return 2;
+    }
+    std::string table_diff;
+    if (!reference::diff_against_catalog(&table_diff)) {
+        std::cout << "Catalog differs from the reference tables (src/ai/ReferenceTableData.cpp):\n" << table_diff
+                  << "Regenerate with swd_fuzz --dump-tables if the catalog change is intended.\n";
+        return 1;
+    }
+    if (replaying) return run_replay(argc, argv);
+    if (opt.threads <= 0) opt.threads = std::max(1u, std::thread::hardware_concurrency());
+    std::cout << "Seed: " << opt.seed << " | Threads: " << opt.threads << "\n";
+    return run(opt);
+}
@@ -0,0 +1,219 @@
+// netbot.cpp —— 对局服务器的压测客户端：同时开 N 局，随机走子直到全部终局
+//
+// 用法: swd_netbot [--socket PATH] [--games N] [--seed S]
+//   每局在本地维护一份快照副本，只靠 DELTA 更新；终局时向服务器取完整状态逐字节核对。
+#include "net/Protocol.h"
+#include "core/Snapshot.h"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+struct ClientGame {
+    uint32_t session = 0;
+    GameSnapshot state;
+    bool over = false;
+    Move next;
+};
+
+class Connection {
+public:
+    explicit Connection(int socket_fd) : fd(socket_fd) {}
+
+    bool send_all(const std::vector<uint8_t>& data) {
+        std::size_t sent = 0;
+        while (sent < data.size()) {
+            ssize_t n = ::send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+            if (n <= 0) return false;
+            sent += static_cast<std::size_t>(n);
+        }
+        return true;
+    }
+
+    // 读取下一帧；返回 false 表示连接断开
+    bool next_frame(NetMessage& type, std::vector<uint8_t>& payload) {
+        while (true) {
+            const uint8_t* p;
+            std::size_t size;
+            long frame = parse_frame(buffer.data() + consumed, buffer.size() - consumed, type, p, size);
+            if (frame < 0) return false;
+            if (frame > 0) {
+                payload.assign(p, p + size);
+                consumed += static_cast<std::size_t>(frame);
+                return true;
+            }
+            buffer.erase(buffer.begin(), buffer.begin() + consumed);
+            consumed = 0;
+            uint8_t chunk[16 * 1024];
+            ssize_t n = ::recv(fd, chunk, sizeof(chunk), 0);
+            if (n <= 0) return false;
+            buffer.insert(buffer.end(), chunk, chunk + n);
+        }
+    }
+
+private:
+    int fd;
+    std::vector<uint8_t> buffer;
+    std::size_t consumed = 0;
+};
+
+int connect_to(const std::string& path) {
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+    if (fd < 0 || ::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        if (fd >= 0) ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string path = "/tmp/swd.sock";
+    int games = 1000;
+    uint64_t seed = 1;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string arg = argv[i];
+        if (arg == "--socket") path = argv[i + 1];
+        else if (arg == "--games") games = std::atoi(argv[i + 1]);
+        else if (arg == "--seed") seed = std::strtoull(argv[i + 1], nullptr, 10);
+        else {
+            std::cerr << "Unknown option: " << arg << std::endl;
+            return 2;
+        }
+    }
+
+    int fd = connect_to(path);
+    if (fd < 0) {
+        std::cerr << "Cannot connect to " << path << std::endl;
+        return 1;
+    }
+    Connection conn(fd);
+    std::mt19937_64 rng(seed);
+    std::vector<uint8_t> out;
+    std::vector<uint8_t> payload;
+    NetMessage type;
+
+    auto start = std::chrono::steady_clock::now();
+
+    // 1. 批量建局
+    std::vector<ClientGame> table(games);
+    out.clear();
+    for (int i = 0; i < games; ++i) {
+        FrameWriter w(out);
+        w.begin(NetMessage::CREATE);
+        w.u64(seed + i);
+        w.end();
+    }
+    if (!conn.send_all(out)) return 1;
+    for (auto& g : table) {
+        if (!conn.next_frame(type, payload) || type != NetMessage::CREATED) {
+            std::cerr << "CREATE failed" << std::endl;
+            return 1;
+        }
+        FrameReader r(payload.data(), payload.size());
+        g.session = r.u32();
+        r.u16();
+        r.bytes(&g.state, sizeof(g.state));
+    }
+
+    // 2. 每轮：所有未终局的对局先取合法动作，再各走一步（请求流水线化）
+    long long total_moves = 0;
+    long long delta_bytes = 0;
+    int active = games;
+    while (active > 0) {
+        out.clear();
+        for (auto& g : table) {
+            if (g.over) continue;
+            FrameWriter w(out);
+            w.begin(NetMessage::LEGAL);
+            w.u32(g.session);
+            w.end();
+        }
+        if (!conn.send_all(out)) return 1;
+        for (auto& g : table) {
+            if (g.over) continue;
+            if (!conn.next_frame(type, payload) || type != NetMessage::MOVES) return 1;
+            FrameReader r(payload.data(), payload.size());
+            r.u32();
+            int n = r.u8();
+            std::uniform_int_distribution<int> pick(0, n - 1);
+            int k = n > 0 ? pick(rng) : 0;
+            for (int i = 0; i < n; ++i) {
+                Move m = r.move();
+                if (i == k) g.next = m;
+            }
+        }
+
+        out.clear();
+        for (auto& g : table) {
+            if (g.over) continue;
+            FrameWriter w(out);
+            w.begin(NetMessage::MOVE);
+            w.u32(g.session);
+            w.move(g.next);
+            w.end();
+        }
+        if (!conn.send_all(out)) return 1;
+        active = 0;
+        for (auto& g : table) {
+            if (g.over) continue;
+            if (!conn.next_frame(type, payload) || type != NetMessage::DELTA) {
+                std::cerr << "MOVE rejected for session " << g.session << std::endl;
+                return 1;
+            }
+            delta_bytes += static_cast<long long>(payload.size());
+            FrameReader r(payload.data(), payload.size());
+            r.u32();
+            r.u8();
+            r.u8();
+            g.over = r.u8() != 0;
+            r.u8();
+            if (!apply_snapshot_delta(r, g.state)) return 1;
+            total_moves++;
+            active += !g.over;
+        }
+    }
+
+    // 3. 核对：本地按差量维护的副本必须与服务器的完整状态一致，然后关闭对局
+    out.clear();
+    for (auto& g : table) {
+        FrameWriter w(out);
+        w.begin(NetMessage::STATE);
+        w.u32(g.session);
+        w.end();
+        w.begin(NetMessage::CLOSE);
+        w.u32(g.session);
+        w.end();
+    }
+    if (!conn.send_all(out)) return 1;
+    int mismatches = 0;
+    for (auto& g : table) {
+        GameSnapshot server_state;
+        if (!conn.next_frame(type, payload) || type != NetMessage::STATE_FULL) return 1;
+        FrameReader r(payload.data(), payload.size());
+        r.u32();
+        r.u16();
+        r.bytes(&server_state, sizeof(server_state));
+        if (std::memcmp(&server_state, &g.state, sizeof(server_state)) != 0) mismatches++;
+        if (!conn.next_frame(type, payload) || type != NetMessage::CLOSED) return 1;
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Games: " << games << " | Moves: " << total_moves << " | " << (total_moves / seconds) << " moves/s"
+              << " | avg delta " << (total_moves ? delta_bytes / total_moves : 0) << " bytes"
+              << " | state mismatches: " << mismatches << "\n";
+    ::close(fd);
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,233 @@
+// perft.cpp —— 走法树计数：规则引擎的正确性基准与性能基准
+//
+// 用法: swd_perft [--seed S | --snapshot FILE] [--depth N] [--threads T] [--hash MB] [--divide]
+//                 [--expect c1,c2,...]
+//   从种子 S 的开局（默认 1）或快照文件出发，对 d = 1..N（默认 4）分别数出长度恰为 d 的合法动作序列数，
+//   每个深度打印计数、耗时与每秒节点数。每个决策点（含奇迹/进步标记/弃牌堆等后续决策、
+//   额外回合与时代交替）都算一层；对局在 d 层之前结束的序列不计入。
+//   --threads T   按根节点动作分给 T 个线程（默认全部核心）
+//   --hash MB     每个线程一张子树计数缓存（按完整快照内容 + 剩余深度为键，默认 0 = 不用）
+//   --divide      最深一层额外按根动作分别列出计数
+//   --expect      各深度的已知计数（逗号分隔）；任一不符即以非零码退出
+//
+// 走子与回退都在每个线程的同一个 Game 上原地进行：Game 没有撤销操作，
+// 回退即从本线程按层保存的快照栈 load_snapshot（沿用对局自己的 arena，不分配新对象）。
+//
+// 已知计数（用于核对规则改动）：
+//   seed 1: 36 990 20119 260343 3443336
+//   seed 7: 36 768 15798 231731 3008723
+#include "core/Game.h"
+#include "core/PositionHash.h"
+#include "core/Snapshot.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct Options {
+    uint64_t seed = 1;
+    std::string snapshot_file;
+    int depth = 4;
+    int threads = 0;
+    int hash_mb = 0;
+    bool divide = false;
+    std::vector<uint64_t> expect;
+};
+
+// 子树计数缓存：直接映射、总是替换
+class CountCache {
+public:
+    explicit CountCache(std::size_t megabytes) {
+        std::size_t n = 1;
+        while (n * 2 * sizeof(Entry) <= megabytes * 1024 * 1024) n *= 2;
+        if (megabytes > 0) entries.resize(n);
+    }
+    bool enabled() const { return !entries.empty(); }
+    bool find(uint64_t key, uint64_t& count) const {
+        const Entry& e = entries[key & (entries.size() - 1)];
+        if (e.key != key) return false;
+        count = e.count;
+        return true;
+    }
+    void store(uint64_t key, uint64_t count) {
+        entries[key & (entries.size() - 1)] = Entry{key, count};
+    }
+
+private:
+    struct Entry {
+        uint64_t key = 0;
+        uint64_t count = 0;
+    };
+    std::vector<Entry> entries;
+};
+
+uint64_t snapshot_key(const GameSnapshot& snap, int depth) {
+    uint64_t words[sizeof(GameSnapshot) / sizeof(uint64_t)];
+    std::memcpy(words, &snap, sizeof(words));
+    uint64_t h = hash_mix(0, depth);
+    for (uint64_t w : words) h = hash_mix(h, w);
+    return h;
+}
+
+// 单个线程的计数器：一个 Game、按层的快照栈与动作缓冲区
+class Counter {
+public:
+    Counter(int max_depth, std::size_t hash_mb) : stack(max_depth + 1), moves(max_depth + 1), cache(hash_mb) {
+        for (auto& m : moves) m.reserve(256);
+    }
+
+    // game 当前局面下长度恰为 depth 的序列数
+    uint64_t count(int depth, int ply = 0) {
+        std::vector<Move>& legal = moves[ply];
+        game.legal_moves(legal);
+        if (depth == 1 || legal.empty()) return depth == 1 ? legal.size() : 0;
+
+        GameSnapshot& here = stack[ply];
+        game.save_snapshot(here);
+        uint64_t key = 0;
+        if (cache.enabled()) {
+            key = snapshot_key(here, depth);
+            uint64_t cached;
+            if (cache.find(key, cached)) return cached;
+        }
+        uint64_t total = 0;
+        for (std::size_t i = 0; i < legal.size(); ++i) {
+            if (i > 0) game.load_snapshot(here);   // 回退
+            game.apply_move(legal[i]);
+            total += count(depth - 1, ply + 1);
+        }
+        game.load_snapshot(here);
+        if (cache.enabled()) cache.store(key, total);
+        return total;
+    }
+
+    Game game;
+
+private:
+    std::vector<GameSnapshot> stack;
+    std::vector<std::vector<Move>> moves;
+    CountCache cache;
+};
+
+struct DepthResult {
+    uint64_t total = 0;
+    std::vector<uint64_t> per_root;
+    double seconds = 0;
+};
+
+DepthResult run_depth(const GameSnapshot& root, int depth, const Options& opt) {
+    Game probe;
+    probe.load_snapshot(root);
+    std::vector<Move> root_moves;
+    probe.legal_moves(root_moves);
+
+    DepthResult result;
+    result.per_root.assign(root_moves.size(), 0);
+    const auto started = std::chrono::steady_clock::now();
+    if (depth == 1 || root_moves.empty()) {
+        result.total = depth == 1 ? root_moves.size() : 0;
+        std::fill(result.per_root.begin(), result.per_root.end(), 1);
+    } else {
+        std::atomic<std::size_t> next{0};
+        auto worker = [&]() {
+            Counter counter(depth, opt.hash_mb);
+            for (std::size_t i = next.fetch_add(1); i < root_moves.size(); i = next.fetch_add(1)) {
+                counter.game.load_snapshot(root);
+                counter.game.apply_move(root_moves[i]);
+                result.per_root[i] = counter.count(depth - 1);
+            }
+        };
+        const int threads = std::min<int>(opt.threads, static_cast<int>(root_moves.size()));
+        std::vector<std::thread> pool;
+        for (int t = 1; t < threads; ++t) pool.emplace_back(worker);
+        worker();
+        for (auto& t : pool) t.join();
+        for (uint64_t n : result.per_root) result.total += n;
+    }
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    return result;
+}
+
+bool parse_options(int argc, char* argv[], Options& opt) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const bool has_value = i + 1 < argc;
+        if (std::strcmp(arg, "--seed") == 0 && has_value) opt.seed = std::strtoull(argv[++i], nullptr, 10);
+        else if (std::strcmp(arg, "--snapshot") == 0 && has_value) opt.snapshot_file = argv[++i];
+        else if (std::strcmp(arg, "--depth") == 0 && has_value) opt.depth = std::atoi(argv[++i]);
+        else if (std::strcmp(arg, "--threads") == 0 && has_value) opt.threads = std::atoi(argv[++i]);
+        else if (std::strcmp(arg, "--hash") == 0 && has_value) opt.hash_mb = std::atoi(argv[++i]);
+        else if (std::strcmp(arg, "--divide") == 0) opt.divide = true;
+        else if (std::strcmp(arg, "--expect") == 0 && has_value) {
+            std::istringstream list(argv[++i]);
+            std::string item;
+            while (std::getline(list, item, ',')) opt.expect.push_back(std::strtoull(item.c_str(), nullptr, 10));
+        } else {
+            return false;
+        }
+    }
+    return opt.depth > 0 && opt.hash_mb >= 0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options opt;
+    if (!parse_options(argc, argv, opt)) {
+        std::cerr << "Usage: swd_perft [--seed S | --snapshot FILE] [--depth N] [--threads T] [--hash MB] [--divide]\n"
+                     "                 [--expect c1,c2,...]\n";
+        return 2;
+    }
+    if (opt.threads <= 0) opt.threads = std::max(1u, std::thread::hardware_concurrency());
+
+    GameSnapshot root;
+    Game game;
+    if (!opt.snapshot_file.empty()) {
+        if (!read_snapshot_file(opt.snapshot_file, root) || !game.load_snapshot(root)) {
+            std::cerr << "cannot load snapshot " << opt.snapshot_file << "\n";
+            return 1;
+        }
+        std::cout << "Snapshot: " << opt.snapshot_file;
+    } else {
+        game.init(opt.seed);
+        std::cout << "Seed: " << opt.seed;
+    }
+    game.save_snapshot(root);
+    std::cout << " | Threads: " << opt.threads << " | Hash: " << opt.hash_mb << " MB\n";
+
+    bool ok = true;
+    DepthResult last;
+    for (int d = 1; d <= opt.depth; ++d) {
+        last = run_depth(root, d, opt);
+        const double nps = last.seconds > 0 ? last.total / last.seconds : 0.0;
+        std::printf("perft %2d  %14llu  %9.3fs  %12.0f nps", d, static_cast<unsigned long long>(last.total),
+                    last.seconds, nps);
+        if (d <= (int)opt.expect.size()) {
+            const bool match = opt.expect[d - 1] == last.total;
+            ok = ok && match;
+            std::printf("  %s", match ? "ok" : "MISMATCH");
+            if (!match) std::printf(" (expected %llu)", static_cast<unsigned long long>(opt.expect[d - 1]));
+        }
+        std::printf("\n");
+    }
+
+    if (opt.divide) {
+        std::vector<Move> root_moves;
+        game.legal_moves(root_moves);
+        for (std::size_t i = 0; i < root_moves.size(); ++i) {
+            std::printf("%-8s %llu\n", move_to_text(root_moves[i]).c_str(),
+                        static_cast<unsigned long long>(last.per_root[i]));
+        }
+    }
+    return ok ? 0 : 1;
+}
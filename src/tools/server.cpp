@@ -0,0 +1,50 @@
+// server.cpp —— 多对局服务器：Unix 域套接字 + epoll，协议见 net/Protocol.h
+//
+// 用法: swd_server [--socket PATH] [--live N] [--max-sessions N]
+//   --socket PATH       监听的套接字路径（默认 /tmp/swd.sock）
+//   --live N            常驻内存的对局数，其余对局以快照块保存（默认 128）
+//   --max-sessions N    对局总数上限（默认 100000）
+#include "net/GameServer.h"
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+namespace {
+
+GameServer* active_server = nullptr;
+
+void on_signal(int) {
+    if (active_server) active_server->stop();
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    ServerConfig config;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for " << arg << std::endl;
+            return 2;
+        }
+        if (arg == "--socket") config.socket_path = argv[++i];
+        else if (arg == "--live") config.max_live_games = std::strtoul(argv[++i], nullptr, 10);
+        else if (arg == "--max-sessions") config.max_sessions = std::strtoul(argv[++i], nullptr, 10);
+        else {
+            std::cerr << "Unknown option: " << arg << std::endl;
+            return 2;
+        }
+    }
+
+    GameServer server(config);
+    if (!server.open()) return 1;
+    active_server = &server;
+    std::signal(SIGINT, on_signal);
+    std::signal(SIGTERM, on_signal);
+
+    std::cout << "[Server] listening on " << config.socket_path << std::endl;
+    server.run();
+    std::cout << "[Server] stopped, " << server.get_sessions().session_count() << " sessions" << std::endl;
+    return 0;
+}
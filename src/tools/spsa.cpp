@@ -0,0 +1,235 @@
+// spsa.cpp —— 用 SPSA 自动调整一步贪心机器人（ai/GreedyBot.h）的评估权重
+//
+// 用法: swd_spsa [--iterations N] [--games G] [--threads T] [--seed S] [--params a,b,...]
+//                [--start FILE] [--checkpoint FILE] [--checkpoint-every K] [--a a] [--c c] [--stability A]
+//   --games G          每次迭代 θ+ 与 θ- 的对局数（取偶数，同一种子交换座位各下一局）
+//   --params           参与调参的权重名（默认：除 logistic_scale 外全部）
+//   --start FILE       初始权重（缺省为 EvalWeights 默认值）；各参数的步长尺度取 max(|初值|, 0.25)
+//   --checkpoint FILE  每 K 次迭代（默认 1）原子地写出当前权重与迭代号；启动时若文件存在则从中续跑
+//                      （续跑需使用相同的 --seed/--games/--params/--start/--a/--c/--stability，
+//                      --iterations 可以加大）。检查点本身就是合法的权重文件，
+//                      可直接交给 swd_engine --evalfile
+//
+// 每次迭代 k：c_k = c / (k+1)^0.101，a_k = a / (k+1+A)^0.602（A 默认 10），
+// 随机 ±1 方向 Δ，θ± = θ ± c_k·s·Δ；在全部线程上对下 θ+ 与 θ-，
+// r = (θ+ 胜局 - θ- 胜局) / 局数，θ += a_k·s·r·Δ / (2c_k)（s 为各参数的步长尺度）。
+#include "ai/GreedyBot.h"
+#include "ai/HeuristicEval.h"
+#include "ai/Playout.h"
+#include "core/Game.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct Options {
+    int iterations = 200;
+    int games = 200;
+    int threads = 0;   // 0 = 全部核心
+    uint64_t seed = 1;
+    std::string params;
+    std::string start_file;
+    std::string checkpoint_file;
+    int checkpoint_every = 1;
+    double a = 0.5;
+    double c = 0.2;
+    double stability = 10.0;
+};
+
+// 按决策点的座位分派给两个机器人
+struct SeatPolicy {
+    GreedyBot* bots[2];
+    Move choose(const Game& game, const std::vector<Move>& legal) {
+        return bots[game.get_decision().player]->choose(game, legal);
+    }
+};
+
+// θ+ 对 θ- 下 games 局，返回 θ+ 的净胜局数
+int play_match(const EvalWeights& plus, const EvalWeights& minus, int games, uint64_t base_seed, int threads) {
+    std::atomic<int> next{0};
+    std::atomic<int> net{0};
+    auto worker = [&]() {
+        GreedyBot plus_bot(plus);
+        GreedyBot minus_bot(minus);
+        Game game;
+        int local = 0;
+        for (int g = next.fetch_add(1); g < games; g = next.fetch_add(1)) {
+            // 同一种子下两局，θ+ 分别执先后手
+            const int plus_seat = g % 2;
+            SeatPolicy seats;
+            seats.bots[plus_seat] = &plus_bot;
+            seats.bots[1 - plus_seat] = &minus_bot;
+            Playout<SeatPolicy, NullSink> playout(seats);
+            game.init(base_seed + g / 2);
+            local += playout.run(game) == plus_seat ? 1 : -1;
+        }
+        net.fetch_add(local);
+    };
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads; ++t) pool.emplace_back(worker);
+    worker();
+    for (auto& t : pool) t.join();
+    return net.load();
+}
+
+bool write_checkpoint(const std::string& path, const EvalWeights& w, int iteration) {
+    const std::string tmp = path + ".tmp";
+    {
+        std::ofstream out(tmp);
+        if (!out) return false;
+        out << "# swd_spsa checkpoint\n";
+        out << "# iteration " << iteration << "\n";
+        char buf[64];
+        for (int i = 0; i < EvalWeights::field_count(); ++i) {
+            std::snprintf(buf, sizeof(buf), "%.9g", w.field(i));   // float 可精确往返
+            out << EvalWeights::field_name(i) << " = " << buf << "\n";
+        }
+        if (!out) return false;
+    }
+    return std::rename(tmp.c_str(), path.c_str()) == 0;
+}
+
+// 读出检查点中的迭代号；文件不存在时返回 -1
+int read_checkpoint_iteration(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) return -1;
+    std::string line;
+    while (std::getline(in, line)) {
+        int iteration = 0;
+        if (std::sscanf(line.c_str(), "# iteration %d", &iteration) == 1) return iteration;
+    }
+    return 0;
+}
+
+bool parse_options(int argc, char* argv[], Options& opt) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const bool has_value = i + 1 < argc;
+        if (std::strcmp(arg, "--iterations") == 0 && has_value) opt.iterations = std::atoi(argv[++i]);
+        else if (std::strcmp(arg, "--games") == 0 && has_value) opt.games = std::atoi(argv[++i]);
+        else if (std::strcmp(arg, "--threads") == 0 && has_value) opt.threads = std::atoi(argv[++i]);
+        else if (std::strcmp(arg, "--seed") == 0 && has_value) opt.seed = std::strtoull(argv[++i], nullptr, 10);
+        else if (std::strcmp(arg, "--params") == 0 && has_value) opt.params = argv[++i];
+        else if (std::strcmp(arg, "--start") == 0 && has_value) opt.start_file = argv[++i];
+        else if (std::strcmp(arg, "--checkpoint") == 0 && has_value) opt.checkpoint_file = argv[++i];
+        else if (std::strcmp(arg, "--checkpoint-every") == 0 && has_value) opt.checkpoint_every = std::atoi(argv[++i]);
+        else if (std::strcmp(arg, "--a") == 0 && has_value) opt.a = std::atof(argv[++i]);
+        else if (std::strcmp(arg, "--c") == 0 && has_value) opt.c = std::atof(argv[++i]);
+        else if (std::strcmp(arg, "--stability") == 0 && has_value) opt.stability = std::atof(argv[++i]);
+        else return false;
+    }
+    return opt.iterations > 0 && opt.games >= 2 && opt.checkpoint_every > 0 && opt.c > 0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options opt;
+    if (!parse_options(argc, argv, opt)) {
+        std::cerr << "Usage: swd_spsa [--iterations N] [--games G] [--threads T] [--seed S] [--params a,b,...]\n"
+                     "                [--start FILE] [--checkpoint FILE] [--checkpoint-every K] [--a a] [--c c]\n"
+                     "                [--stability A]\n";
+        return 2;
+    }
+    opt.games += opt.games % 2;
+    if (opt.threads <= 0) opt.threads = std::max(1u, std::thread::hardware_concurrency());
+
+    EvalWeights theta;
+    std::string error;
+    if (!opt.start_file.empty() && !theta.load(opt.start_file, &error)) {
+        std::cerr << error << "\n";
+        return 1;
+    }
+
+    // 参与调参的下标
+    std::vector<int> tuned;
+    if (opt.params.empty()) {
+        for (int i = 0; i < EvalWeights::field_count(); ++i) {
+            if (std::strcmp(EvalWeights::field_name(i), "logistic_scale") != 0) tuned.push_back(i);
+        }
+    } else {
+        std::istringstream names(opt.params);
+        std::string name;
+        while (std::getline(names, name, ',')) {
+            const int index = EvalWeights::find_field(name);
+            if (index < 0) {
+                std::cerr << "unknown parameter " << name << "\n";
+                return 2;
+            }
+            tuned.push_back(index);
+        }
+    }
+    std::vector<double> scale(tuned.size());
+    for (std::size_t j = 0; j < tuned.size(); ++j) scale[j] = std::max(0.25, std::fabs((double)theta.field(tuned[j])));
+
+    int first_iteration = 0;
+    if (!opt.checkpoint_file.empty()) {
+        const int done = read_checkpoint_iteration(opt.checkpoint_file);
+        if (done >= 0) {
+            if (!theta.load(opt.checkpoint_file, &error)) {
+                std::cerr << error << "\n";
+                return 1;
+            }
+            first_iteration = done;
+            std::cout << "Resuming from " << opt.checkpoint_file << " at iteration " << done << "\n";
+        }
+    }
+
+    std::cout << "Parameters: " << tuned.size() << " | Games/iteration: " << opt.games
+              << " | Threads: " << opt.threads << " | Seed: " << opt.seed << "\n";
+    const auto started = std::chrono::steady_clock::now();
+
+    for (int k = first_iteration; k < opt.iterations; ++k) {
+        const double ck = opt.c / std::pow(k + 1.0, 0.101);
+        const double ak = opt.a / std::pow(k + 1.0 + opt.stability, 0.602);
+
+        // 方向只由 (seed, k) 决定，续跑时与不中断的运行完全一致
+        std::seed_seq seq{static_cast<uint32_t>(opt.seed), static_cast<uint32_t>(opt.seed >> 32),
+                          static_cast<uint32_t>(k)};
+        std::mt19937 rng(seq);
+        std::bernoulli_distribution coin;
+        std::vector<int> delta(tuned.size());
+        EvalWeights plus = theta, minus = theta;
+        for (std::size_t j = 0; j < tuned.size(); ++j) {
+            delta[j] = coin(rng) ? 1 : -1;
+            const float step = static_cast<float>(ck * scale[j] * delta[j]);
+            plus.field(tuned[j]) += step;
+            minus.field(tuned[j]) -= step;
+        }
+
+        const uint64_t base_seed = opt.seed + static_cast<uint64_t>(k) * (opt.games / 2);
+        const int net = play_match(plus, minus, opt.games, base_seed, opt.threads);
+        const double r = static_cast<double>(net) / opt.games;
+        for (std::size_t j = 0; j < tuned.size(); ++j) {
+            theta.field(tuned[j]) += static_cast<float>(ak * scale[j] * r * delta[j] / (2.0 * ck));
+        }
+
+        const double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+        std::printf("iter %d  r %+.3f  c_k %.4f  a_k %.4f  %.1fs\n", k + 1, r, ck, ak, secs);
+        std::fflush(stdout);
+
+        const bool last = k + 1 == opt.iterations;
+        if (!opt.checkpoint_file.empty() && ((k + 1) % opt.checkpoint_every == 0 || last)) {
+            if (!write_checkpoint(opt.checkpoint_file, theta, k + 1)) {
+                std::cerr << "cannot write checkpoint " << opt.checkpoint_file << "\n";
+                return 1;
+            }
+        }
+    }
+
+    std::cout << "\nTuned weights:\n";
+    for (int index : tuned) std::printf("%s = %.6g\n", EvalWeights::field_name(index), theta.field(index));
+    return 0;
+}
@@ -0,0 +1,363 @@
+// tournament.cpp —— 无界面批量对局：吞吐统计与内存分配报告
+//
+// 用法: tournament [--games N] [--seed S] [--threads T] [--alloc-report] [--check-no-alloc]
+//                   [--profile] [--profile-json FILE] [--trace FILE] [--watch] [--interleave N]
+//                   [--sketch] [--batch] [--dataset DIR] [--net FILE] [--net-sims N]
+//   --alloc-report    打印按引擎阶段归类的分配统计与单局 arena 峰值
+//   --check-no-alloc  若对局循环（时代布局之外）发生任何堆分配则以非零码退出
+//                     （需以 -DSWD_ALLOC_TRACKING=ON 编译）
+//   --profile         打印热路径延迟直方图汇总（需以 -DSWD_PROFILING=ON 编译）
+//   --profile-json    把合并后的直方图导出为 JSON
+//   --trace FILE      记录时间线并导出 Chrome trace-event JSON（需以 -DSWD_TRACING=ON 编译）
+//   --watch           在终端中逐步观看对局（单线程，每步差量重绘一帧）
+//   --interleave N    每个线程同时推进 N 局，按决策点轮流喂入动作
+//   --sketch          统计局面/模式的重复频次与不同局面数（每线程一份定长概要，结束时合并）
+//   --batch           每个线程用结构数组批量模拟器同步推进 BatchPlayout::kLanes 局（同样的发牌种子）
+//   --dataset DIR     把每个决策点的 (特征, 动作, 结果) 写入 DIR 下的训练数据分片
+//   --net FILE        P1 由网络引导的搜索执子（每步 --net-sims 次模拟，默认 64），P2 随机；
+//                     各线程的叶节点评估合批送入同一个推理线程
+#include "core/Game.h"
+#include "instrument/AllocTracker.h"
+#include "instrument/Profiler.h"
+#include "instrument/Tracer.h"
+#include "instrument/PositionSketch.h"
+#include "ai/Playout.h"
+#include "ai/BatchPlayout.h"
+#include "env/DatasetWriter.h"
+#include "ai/NetBot.h"
+#include "ai/NetEvaluator.h"
+#include "view/ConsoleView.h"
+#include "view/ConsoleEventLog.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace {
+
+struct Options {
+    int games = 1000;
+    uint64_t seed = 1;
+    int threads = 1;
+    bool alloc_report = false;
+    bool check_no_alloc = false;
+    bool profile = false;
+    std::string profile_json;
+    std::string trace_file;
+    bool watch = false;
+    int interleave = 1;
+    bool sketch = false;
+    bool batch = false;
+    std::string dataset_dir;
+    std::string net_file;
+    int net_sims = 64;
+};
+
+struct WorkerResult {
+    int wins[2] = {0, 0};
+    long long moves = 0;
+    std::size_t arena_peak = 0;
+    uint64_t loop_allocs = 0;   // 对局循环中（时代布局以外）的堆分配次数
+    std::unique_ptr<PositionSketch> sketch;
+};
+
+// 对局循环关心的阶段：除时代布局外的全部阶段
+uint64_t loop_alloc_count() {
+    uint64_t n = 0;
+    for (AllocPhase p : {AllocPhase::OTHER, AllocPhase::TAKE_CARD, AllocPhase::EFFECT,
+                         AllocPhase::COST, AllocPhase::RENDER}) {
+        n += AllocTracker::thread_counters(p).allocs;
+    }
+    return n;
+}
+
+// 一个交替槽位：持有一局对局，局终后接着开下一局
+struct Slot {
+    std::unique_ptr<Game> game = std::make_unique<Game>();
+    std::unique_ptr<DatasetWriter::Producer> recorder;   // --dataset：每个槽位一份，交替推进的各局互不混杂
+    int game_index = -1;
+    bool warmed_up = false;   // 该槽位的第一局用于预热（全局目录、arena 初始块、各缓冲区容量），之后开始计数
+};
+
+// 随机走子并把每个决策点交给当前槽位的记录器（在动作应用之前，特征对应决策前的局面）
+struct RecordingPolicy {
+    RandomPolicy inner;
+    DatasetWriter::Producer* recorder = nullptr;
+
+    explicit RecordingPolicy(uint64_t seed) : inner(seed) {}
+    Move choose(const Game& game, const std::vector<Move>& legal) {
+        Move move = inner.choose(game, legal);
+        recorder->record(game, move);
+        return move;
+    }
+};
+
+// P1 由网络引导的搜索执子，P2 随机
+struct NetPolicy {
+    NetBot bot;
+    RandomPolicy random;
+
+    NetPolicy(NetEvaluator& evaluator, int simulations, uint64_t seed)
+        : bot(evaluator, NetBot::Options{simulations, 1.5f, seed}), random(seed) {}
+    Move choose(const Game& game, const std::vector<Move>& legal) {
+        return game.get_decision().player == 0 ? bot.choose(game) : random.choose(game, legal);
+    }
+};
+
+template <class Policy>
+void run_slots(const Options& opt, int worker, WorkerResult& result, Playout<Policy, NullSink>& driver,
+               DatasetWriter* dataset) {
+
+    // 同一线程交替推进多局：每轮给每个槽位的对局喂一个决策
+    std::vector<Slot> slots(opt.interleave);
+    int next_game = worker;
+    auto start_next = [&](Slot& slot) {
+        slot.game_index = next_game < opt.games ? next_game : -1;
+        next_game += opt.threads;
+        if (slot.game_index >= 0) slot.game->init(opt.seed + slot.game_index);
+    };
+    for (auto& slot : slots) start_next(slot);
+    if (dataset) {
+        for (auto& slot : slots) slot.recorder = std::make_unique<DatasetWriter::Producer>(dataset->make_producer());
+    }
+
+    // 概要由驱动循环在每步之后直接喂入，不依赖事件总线（SWD_NO_EVENTS 构建中同样有效）
+    if (opt.sketch) result.sketch = std::make_unique<PositionSketch>();
+
+    // 观战：事件写入视图日志，每步之后渲染一帧
+    std::unique_ptr<ConsoleView> view;
+    std::unique_ptr<ConsoleEventLog> event_log;
+    if (opt.watch) {
+        view = std::make_unique<ConsoleView>();
+        event_log = std::make_unique<ConsoleEventLog>(*slots[0].game, *view);
+    }
+
+    int active = static_cast<int>(slots.size());
+    while (active > 0) {
+        active = 0;
+        for (auto& slot : slots) {
+            if (slot.game_index < 0) continue;
+            active++;
+            Game& game = *slot.game;
+            SWD_TRACE_SCOPE_ARG("decision", slot.game_index);
+
+            uint64_t before = slot.warmed_up ? loop_alloc_count() : 0;
+            if constexpr (std::is_same<Policy, RecordingPolicy>::value) driver.get_policy().recorder = slot.recorder.get();
+            const bool moved = driver.step(game);
+            if (moved) {
+                result.moves++;
+                if (result.sketch) result.sketch->observe(game);
+                if (view) view->render_frame(game, game.get_decision().player);
+            }
+            if (slot.warmed_up) result.loop_allocs += loop_alloc_count() - before;
+
+            if (game.is_over() || !moved) {
+                result.wins[game.get_winner()]++;
+                if (slot.recorder) slot.recorder->end_game(game.get_winner());
+                result.arena_peak = std::max(result.arena_peak, game.get_arena().peak_bytes());
+                slot.warmed_up = true;
+                start_next(slot);
+            }
+        }
+    }
+}
+
+void run_worker(const Options& opt, int worker, WorkerResult& result, DatasetWriter* dataset,
+                NetEvaluator* evaluator) {
+    // 大批量对局走编译期特化的驱动循环（随机策略，无观察者）
+    const uint64_t policy_seed = opt.seed * 0x9E3779B97F4A7C15ull + worker;
+    if (evaluator) {
+        Playout<NetPolicy, NullSink> driver{NetPolicy(*evaluator, opt.net_sims, policy_seed)};
+        run_slots(opt, worker, result, driver, dataset);
+    } else if (dataset) {
+        Playout<RecordingPolicy, NullSink> driver{RecordingPolicy(policy_seed)};
+        run_slots(opt, worker, result, driver, dataset);
+    } else {
+        Playout<RandomPolicy, NullSink> driver(RandomPolicy{policy_seed});
+        run_slots(opt, worker, result, driver, nullptr);
+    }
+}
+
+// 批量模式：与逐局驱动分到相同的局号与种子，规则相同，随机走子序列不同
+void run_batch_worker(const Options& opt, int worker, WorkerResult& result, DatasetWriter*, NetEvaluator*) {
+    auto batch = std::make_unique<BatchPlayout>(opt.seed * 0x9E3779B97F4A7C15ull + worker);
+    BatchPlayout::Stats stats = batch->play_games(opt.seed, worker, opt.threads, opt.games);
+    result.wins[0] = stats.wins[0];
+    result.wins[1] = stats.wins[1];
+    result.moves = stats.moves;
+}
+
+bool parse_args(int argc, char* argv[], Options& opt) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto next = [&](const char* name) -> const char* {
+            if (i + 1 >= argc) { std::cerr << "Missing value for " << name << std::endl; std::exit(2); }
+            return argv[++i];
+        };
+        if (arg == "--games") opt.games = std::atoi(next("--games"));
+        else if (arg == "--seed") opt.seed = std::strtoull(next("--seed"), nullptr, 10);
+        else if (arg == "--threads") opt.threads = std::max(1, std::atoi(next("--threads")));
+        else if (arg == "--alloc-report") opt.alloc_report = true;
+        else if (arg == "--check-no-alloc") opt.check_no_alloc = true;
+        else if (arg == "--profile") opt.profile = true;
+        else if (arg == "--profile-json") opt.profile_json = next("--profile-json");
+        else if (arg == "--trace") opt.trace_file = next("--trace");
+        else if (arg == "--watch") opt.watch = true;
+        else if (arg == "--sketch") opt.sketch = true;
+        else if (arg == "--batch") opt.batch = true;
+        else if (arg == "--dataset") opt.dataset_dir = next("--dataset");
+        else if (arg == "--net") opt.net_file = next("--net");
+        else if (arg == "--net-sims") opt.net_sims = std::max(1, std::atoi(next("--net-sims")));
+        else if (arg == "--interleave") opt.interleave = std::max(1, std::atoi(next("--interleave")));
+        else {
+            std::cerr << "Unknown option: " << arg << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options opt;
+    if (!parse_args(argc, argv, opt)) return 2;
+    if (opt.watch) opt.threads = opt.interleave = 1;
+    if (opt.batch && (opt.watch || opt.sketch || opt.alloc_report || opt.check_no_alloc || !opt.dataset_dir.empty() ||
+                      !opt.net_file.empty())) {
+        std::cerr << "--batch cannot be combined with --watch, --sketch, --dataset, --net or allocation reports" << std::endl;
+        return 2;
+    }
+    if (!opt.net_file.empty() && !opt.dataset_dir.empty()) {
+        std::cerr << "--net cannot be combined with --dataset" << std::endl;
+        return 2;
+    }
+
+    if (opt.watch && !EventBus::compiled_in()) {
+        std::cerr << "--watch requires a build without -DSWD_NO_EVENTS=ON" << std::endl;
+        return 2;
+    }
+
+    if (opt.check_no_alloc && !AllocTracker::compiled_in()) {
+        std::cerr << "--check-no-alloc requires a build with -DSWD_ALLOC_TRACKING=ON" << std::endl;
+        return 2;
+    }
+
+    if (!opt.trace_file.empty()) {
+        if (!Tracer::compiled_in()) {
+            std::cerr << "--trace requires a build with -DSWD_TRACING=ON" << std::endl;
+            return 2;
+        }
+        Tracer::set_enabled(true);
+    }
+
+    std::unique_ptr<DatasetWriter> dataset;
+    if (!opt.dataset_dir.empty()) {
+        DatasetWriter::Options dataset_options;
+        dataset_options.directory = opt.dataset_dir;
+        dataset = std::make_unique<DatasetWriter>(dataset_options);
+    }
+
+    std::unique_ptr<NetEvaluator> evaluator;
+    if (!opt.net_file.empty()) {
+        MlpNetwork network;
+        std::string error;
+        if (!network.load(opt.net_file, &error)) {
+            std::cerr << "Cannot load network: " << error << std::endl;
+            return 2;
+        }
+        try {
+            // 每个线程同一时刻只有一条评估在途，批大小取线程数
+            evaluator = std::make_unique<NetEvaluator>(std::move(network), NetEvaluator::Options{opt.threads, 200});
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << std::endl;
+            return 2;
+        }
+    }
+
+    std::vector<WorkerResult> results(opt.threads);
+    auto start = std::chrono::steady_clock::now();
+    {
+        std::vector<std::thread> workers;
+        for (int w = 0; w < opt.threads; ++w) {
+            workers.emplace_back(opt.batch ? run_batch_worker : run_worker, std::cref(opt), w, std::ref(results[w]),
+                                 dataset.get(), evaluator.get());
+        }
+        for (auto& t : workers) t.join();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    WorkerResult total;
+    for (const auto& r : results) {
+        total.wins[0] += r.wins[0];
+        total.wins[1] += r.wins[1];
+        total.moves += r.moves;
+        total.arena_peak = std::max(total.arena_peak, r.arena_peak);
+        total.loop_allocs += r.loop_allocs;
+    }
+
+    std::cout << "Games: " << opt.games << " | Threads: " << opt.threads << " | Seed: " << opt.seed << "\n";
+    std::cout << "Wins: P1 " << total.wins[0] << " / P2 " << total.wins[1] << "\n";
+    std::cout << "Moves: " << total.moves << " | " << (opt.games / seconds) << " games/s | "
+              << (total.moves / seconds) << " moves/s\n";
+
+    if (opt.alloc_report || opt.check_no_alloc) {
+        AllocTracker::print_report(std::cout, AllocTracker::collect());
+        std::cout << "max arena peak per game: " << total.arena_peak << " bytes\n";
+        if (AllocTracker::compiled_in()) {
+            std::cout << "heap allocations in playout loop (after warm-up): " << total.loop_allocs << "\n";
+        }
+    }
+
+    if (opt.sketch) {
+        PositionSketch& merged = *results[0].sketch;
+        for (std::size_t i = 1; i < results.size(); ++i) merged.merge(*results[i].sketch);
+        merged.print_report(std::cout);
+    }
+
+    if (evaluator) {
+        NetEvaluator::Stats ns = evaluator->get_stats();
+        std::cout << "Network: " << ns.requests << " evaluations in " << ns.batches << " batches (avg "
+                  << (ns.batches ? static_cast<double>(ns.requests) / ns.batches : 0.0) << " per forward pass)\n";
+    }
+
+    if (dataset) {
+        const bool ok = dataset->close();
+        DatasetWriter::Stats ds = dataset->get_stats();
+        std::cout << "Dataset: " << ds.records << " records in " << ds.chunks << " chunks, " << ds.shards
+                  << " shard(s) under " << opt.dataset_dir << " | peak queued chunks " << ds.peak_queued << "\n";
+        if (!ok) {
+            std::cerr << "dataset write failed: " << dataset->get_error() << std::endl;
+            return 1;
+        }
+    }
+
+    if (opt.profile || !opt.profile_json.empty()) {
+        Profiler::Report report = Profiler::collect();
+        if (opt.profile) Profiler::print_report(std::cout, report);
+        if (!opt.profile_json.empty()) {
+            std::ofstream out(opt.profile_json);
+            Profiler::write_json(out, report);
+        }
+    }
+
+    if (!opt.trace_file.empty()) {
+        Tracer::set_enabled(false);
+        std::ofstream out(opt.trace_file);
+        Tracer::write_chrome_json(out);
+    }
+
+    if (opt.check_no_alloc && total.loop_allocs != 0) {
+        std::cerr << "FAIL: playout loop allocated " << total.loop_allocs << " times" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,76 @@
+#include "ConsoleEventLog.h"
+#include "ConsoleView.h"
+#include "../core/Game.h"
+#include "../player/Player.h"
+#include "../cards/Card.h"
+#include "../cards/Wonder.h"
+
+namespace {
+
+const char* color_name(Color color) {
+    switch (color) {
+        case Color::BROWN:  return "Brown";
+        case Color::GREY:   return "Grey";
+        case Color::BLUE:   return "Blue";
+        case Color::YELLOW: return "Yellow";
+        case Color::RED:    return "Red";
+        case Color::GREEN:  return "Green";
+        case Color::PURPLE: return "Purple";
+    }
+    return "?";
+}
+
+} // namespace
+
+ConsoleEventLog::ConsoleEventLog(Game& g, ConsoleView& v) : game(g), view(v) {
+    if (!kEnabled) view.log("[INFO] Event log unavailable: built with SWD_NO_EVENTS");
+    game.events().subscribe(*this);
+}
+ConsoleEventLog::~ConsoleEventLog() { game.events().unsubscribe(this); }
+
+void ConsoleEventLog::on(const CardBuilt& e) {
+    view.log("[Game] %s built %s.", name_of(e.player), card_catalog()[e.card_id]->name.c_str());
+}
+
+void ConsoleEventLog::on(const CardDiscarded& e) {
+    view.log("[Game] %s gained %d coins.", name_of(e.player), e.coins_gained);
+}
+
+// 金币余额已显示在玩家面板上，这里不重复记录
+void ConsoleEventLog::on(const CoinsChanged&) {}
+
+void ConsoleEventLog::on(const PawnMoved& e) {
+    view.log("[Board] Conflict pawn moved %d -> %d", e.from, e.to);
+}
+
+void ConsoleEventLog::on(const LootingTokenConsumed& e) {
+    view.log("[Board] %s lost %d coins (Military Penalty)!", name_of(e.player), e.coins_lost);
+}
+
+void ConsoleEventLog::on(const WonderBuilt& e) {
+    view.log("[Game] %s constructed %s!", name_of(e.player), wonder_catalog()[e.wonder_id].name.c_str());
+}
+
+void ConsoleEventLog::on(const CardDestroyed& e) {
+    view.log("[Effect] %s lost a %s card", name_of(e.player), color_name(e.color));
+}
+
+void ConsoleEventLog::on(const ExtraTurn&) {
+    view.log(">>> EXTRA TURN! <<<");
+}
+
+void ConsoleEventLog::on(const AgeChanged& e) {
+    view.log("--- Starting Age %d ---", e.age);
+}
+
+void ConsoleEventLog::on(const ProgressTokenOffered& e) {
+    view.log("[INFO] Progress Token Selection triggered for %s", name_of(e.player));
+}
+
+void ConsoleEventLog::on(const DiscardBuildOffered& e) {
+    view.log("[INFO] Build from Discard triggered for %s", name_of(e.player));
+}
+
+const char* ConsoleEventLog::name_of(int seat) const {
+    return game.get_player(seat).get_name().c_str();
+}
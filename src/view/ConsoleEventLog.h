@@ -0,0 +1,47 @@
+#ifndef CONSOLE_EVENT_LOG_H
+#define CONSOLE_EVENT_LOG_H
+
+#include "../core/GameEvents.h"
+
+class Game;
+class ConsoleView;
+
+/**
+ * ConsoleEventLog 类：把规则事件写入 ConsoleView 事件日志的订阅者
+ * 构造时订阅 Game 的事件总线，析构时自动退订
+ * 以 SWD_NO_EVENTS=ON 编译时不订阅，只在日志里留一行说明（面板仍显示完整局面）
+ */
+class ConsoleEventLog {
+public:
+    static constexpr bool kEnabled = EventBus::compiled_in();
+
+    ConsoleEventLog(Game& g, ConsoleView& v);
+    ~ConsoleEventLog();
+
+    ConsoleEventLog(const ConsoleEventLog&) = delete;
+    ConsoleEventLog& operator=(const ConsoleEventLog&) = delete;
+
+    void on(const CardBuilt& e);
+    void on(const CardDiscarded& e);
+    void on(const CoinsChanged& e);
+    void on(const PawnMoved& e);
+    void on(const LootingTokenConsumed& e);
+    void on(const WonderBuilt& e);
+    void on(const CardDestroyed& e);
+    void on(const ExtraTurn& e);
+    void on(const AgeChanged& e);
+    void on(const ProgressTokenOffered& e);
+    void on(const DiscardBuildOffered& e);
+    void on(const MoveApplied&) {}
+    void on(const VictoryPointsChanged&) {}
+    void on(const ScienceSymbolGained&) {}
+    void on(const EconomyChanged&) {}
+
+private:
+    const char* name_of(int seat) const;
+
+    Game& game;
+    ConsoleView& view;
+};
+
+#endif // CONSOLE_EVENT_LOG_H
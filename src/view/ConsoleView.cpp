@@ -4,97 +4,157 @@
 #include "../player/Player.h"
 #include "../core/Game.h"
 #include "../core/Board.h"
+#include "../instrument/AllocTracker.h"
 #include <iostream>
-#include <iomanip>
-#include <algorithm>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
 
-void ConsoleView::display_structure(const CardStructure& structure) {
-    int age = structure.get_age();
-    std::cout << "\n================ AGE " << age << " STRUCTURE ================\n";
-
-    if (age == 1) {
-        // Age I: 正金字塔 (底部 6 -> 顶部 2)
-        std::cout << std::setw(20) << "" << format_card_slot(18, structure) << " " << format_card_slot(19, structure) << "\n";
-        std::cout << std::setw(17) << "" << format_card_slot(15, structure) << " " << format_card_slot(16, structure) << " " << format_card_slot(17, structure) << "\n";
-        std::cout << std::setw(14) << "" << format_card_slot(11, structure) << " " << format_card_slot(12, structure) << " " << format_card_slot(13, structure) << " " << format_card_slot(14, structure) << "\n";
-        std::cout << std::setw(11) << "" << format_card_slot(6, structure) << " " << format_card_slot(7, structure) << " " << format_card_slot(8, structure) << " " << format_card_slot(9, structure) << " " << format_card_slot(10, structure) << "\n";
-        std::cout << std::setw(8) << "" << format_card_slot(0, structure) << " " << format_card_slot(1, structure) << " " << format_card_slot(2, structure) << " " << format_card_slot(3, structure) << " " << format_card_slot(4, structure) << " " << format_card_slot(5, structure) << "\n";
-    } 
-    else if (age == 2) {
-        // Age II: 倒金字塔 (顶部 2 -> 底部 6)
-        std::cout << std::setw(8) << "" << format_card_slot(14, structure) << " " << format_card_slot(15, structure) << " " << format_card_slot(16, structure) << " " << format_card_slot(17, structure) << " " << format_card_slot(18, structure) << " " << format_card_slot(19, structure) << "\n";
-        std::cout << std::setw(11) << "" << format_card_slot(9, structure) << " " << format_card_slot(10, structure) << " " << format_card_slot(11, structure) << " " << format_card_slot(12, structure) << " " << format_card_slot(13, structure) << "\n";
-        std::cout << std::setw(14) << "" << format_card_slot(5, structure) << " " << format_card_slot(6, structure) << " " << format_card_slot(7, structure) << " " << format_card_slot(8, structure) << "\n";
-        std::cout << std::setw(17) << "" << format_card_slot(2, structure) << " " << format_card_slot(3, structure) << " " << format_card_slot(4, structure) << "\n";
-        std::cout << std::setw(20) << "" << format_card_slot(0, structure) << " " << format_card_slot(1, structure) << "\n";
+namespace {
+
+// 金字塔每一行：缩进、该行首个槽位、槽位数量与行尾标注（各时代的槽位编号在行内是连续的）
+struct LayoutRow {
+    int indent;
+    int first;
+    int count;
+    const char* suffix;
+};
+
+// Age I: 正金字塔 (底部 6 -> 顶部 2)
+const LayoutRow kAge1Layout[] = {
+    {20, 18, 2, ""}, {17, 15, 3, ""}, {14, 11, 4, ""}, {11, 6, 5, ""}, {8, 0, 6, ""},
+};
+// Age II: 倒金字塔 (顶部 2 -> 底部 6)
+const LayoutRow kAge2Layout[] = {
+    {8, 14, 6, ""}, {11, 9, 5, ""}, {14, 5, 4, ""}, {17, 2, 3, ""}, {20, 0, 2, ""},
+};
+// Age III: 括号型布局 (对齐 CardStructure.cpp 的 2-3-4-2-4-3-2 逻辑)
+const LayoutRow kAge3Layout[] = {
+    {20, 18, 2, " (TOP)"}, {17, 15, 3, ""}, {14, 11, 4, ""}, {20, 9, 2, " (MID)"},
+    {14, 5, 4, ""}, {17, 2, 3, ""}, {20, 0, 2, " (START)"},
+};
+
+const char* kRule = "======================================================";
+
+} // namespace
+
+void ConsoleView::render_frame(const Game& game, int viewer) {
+    SWD_ALLOC_PHASE(AllocPhase::RENDER);
+    frame.clear();
+
+    const Player& self = game.get_player(viewer);
+    const Player& opponent = game.get_player((viewer + 1) % 2);
+
+    frame.print(0, 0, "7 WONDERS DUEL | Age %d | %s's turn", game.get_current_age(), self.get_name().c_str());
+    draw_military(1, game);
+    draw_player(3, opponent, false);
+    int row = draw_structure(7, game.get_structure());
+    draw_player(row + 1, self, true);
+    draw_log(row + 5);
+
+    frame.present();
+}
+
+void ConsoleView::draw_military(int row, const Game& game) {
+    int pos = game.get_board()->get_pawn_position();
+    char track[20];
+    for (int i = 0; i <= 18; ++i) {
+        if (i == pos) track[i] = 'X'; // 棋子
+        else if (i == 6 || i == 3 || i == 12 || i == 15) track[i] = '!'; // 惩罚位
+        else if (i == 9) track[i] = '|'; // 中心
+        else track[i] = '.';
     }
-    else if (age == 3) {
-        // Age III: 括号型布局 (对齐 CardStructure.cpp 的 2-3-4-2-4-3-2 逻辑)
-        // 从最顶层 18,19 往下画，直到最底层的初始可选牌 0,1
-        std::cout << std::setw(20) << "" << format_card_slot(18, structure) << " " << format_card_slot(19, structure) << " (TOP)\n";
-        std::cout << std::setw(17) << "" << format_card_slot(15, structure) << " " << format_card_slot(16, structure) << " " << format_card_slot(17, structure) << "\n";
-        std::cout << std::setw(14) << "" << format_card_slot(11, structure) << " " << format_card_slot(12, structure) << " " << format_card_slot(13, structure) << " " << format_card_slot(14, structure) << "\n";
-        std::cout << std::setw(20) << "" << format_card_slot(9, structure) << " " << format_card_slot(10, structure) << " (MID)\n";
-        std::cout << std::setw(14) << "" << format_card_slot(5, structure) << " " << format_card_slot(6, structure) << " " << format_card_slot(7, structure) << " " << format_card_slot(8, structure) << "\n";
-        std::cout << std::setw(17) << "" << format_card_slot(2, structure) << " " << format_card_slot(3, structure) << " " << format_card_slot(4, structure) << "\n";
-        std::cout << std::setw(20) << "" << format_card_slot(0, structure) << " " << format_card_slot(1, structure) << " (START)\n";
+    track[19] = '\0';
+    frame.print(row, 0, "MILITARY: [P1] %s [P2] (Pos:%d)", track, pos);
+}
+
+void ConsoleView::draw_player(int row, const Player& player, bool active) {
+    frame.print(row, 0, "[ PLAYER: %s ]%s", player.get_name().c_str(), active ? "  <== to move" : "");
+    frame.print(row + 1, 0, "Coins: %dg | VP: %d", player.get_coins(), player.get_victory_points());
+    frame.print(row + 2, 0, "Production: W:%d C:%d S:%d G:%d P:%d",
+                player.get_resource(Resource::WOOD), player.get_resource(Resource::CLAY),
+                player.get_resource(Resource::STONE), player.get_resource(Resource::GLASS),
+                player.get_resource(Resource::PAPYRUS));
+}
+
+int ConsoleView::draw_structure(int row, const CardStructure& structure) {
+    // 本帧的金字塔快照：每个槽位只查询一次
+    for (int pos = 0; pos < 20; ++pos) {
+        slots[pos].card = structure.get_card(pos);
+        slots[pos].accessible = slots[pos].card && structure.is_accessible(pos);
     }
 
-    // 打印底部 ID 提示
-    std::cout << "\nAccessible Card IDs: ";
-    auto acc = structure.get_accessible();
-    for (int id : acc) {
-        const Card* c = structure.get_card(id);
-        if(c) std::cout << id << ":" << c->name << "  ";
+    int age = structure.get_age();
+    frame.print(row++, 0, "================ AGE %d STRUCTURE ================", age);
+
+    const LayoutRow* layout = kAge1Layout;
+    int layout_rows = 5;
+    if (age == 2) layout = kAge2Layout;
+    if (age == 3) { layout = kAge3Layout; layout_rows = 7; }
+
+    for (int r = 0; r < layout_rows; ++r, ++row) {
+        const LayoutRow& line = layout[r];
+        int col = line.indent;
+        char cell[6];
+        for (int i = 0; i < line.count; ++i) {
+            format_card_slot(slots[line.first + i], cell);
+            frame.put(row, col, cell);
+            col += 6;
+        }
+        frame.put(row, col - 1, line.suffix);
     }
-    std::cout << "\n======================================================\n";
-}
 
-void ConsoleView::display_player_status(const Player& player) {
-    std::cout << "\n[ PLAYER: " << player.get_name() << " ]\n";
-    std::cout << "Coins: " << player.get_coins() << "g | VP: " << player.get_victory_points() << "\n";
-    std::cout << "Production: W:" << player.get_resource(Resource::WOOD) 
-              << " C:" << player.get_resource(Resource::CLAY) 
-              << " S:" << player.get_resource(Resource::STONE) 
-              << " G:" << player.get_resource(Resource::GLASS) 
-              << " P:" << player.get_resource(Resource::PAPYRUS) << "\n";
+    // 底部 ID 提示（超出一行时折到第二行）
+    row++;
+    frame.put(row, 0, "Accessible Card IDs:");
+    int id_row = row;
+    int col = 21;
+    char entry[48];
+    for (int pos = 0; pos < 20; ++pos) {
+        if (!slots[pos].accessible) continue;
+        int n = std::snprintf(entry, sizeof(entry), "%d:%s", pos, slots[pos].card->name.c_str());
+        if (n < 0) continue;
+        if (col + n > FrameRenderer::kCols && id_row == row) { id_row++; col = 2; }
+        frame.put(id_row, col, entry);
+        col += n + 2;
+    }
+    frame.put(row + 2, 0, kRule);
+    return row + 3;
 }
 
-void ConsoleView::display_board(const Game& game) {
-    // 之前可能调用了 getBoard()，现在统一为 get_board()
-    int pos = const_cast<Game&>(game).get_board()->get_pawn_position();
-    std::cout << "\nMILITARY: [P1] ";
-    for(int i=0; i<=18; ++i) {
-        if(i == pos) std::cout << "X"; // 棋子
-        else if(i == 6 || i == 3 || i == 12 || i == 15) std::cout << "!"; // 惩罚位
-        else if(i == 9) std::cout << "|"; // 中心
-        else std::cout << ".";
+void ConsoleView::draw_log(int row) {
+    frame.put(row, 0, "--- Log ---");
+    // 由旧到新
+    for (int i = 0; i < kLogLines; ++i) {
+        frame.put(row + 1 + i, 0, log_lines[(log_next + i) % kLogLines]);
     }
-    std::cout << " [P2] (Pos:" << pos << ")\n";
+}
+
+void ConsoleView::log(const char* fmt, ...) {
+    char* line = log_lines[log_next];
+    va_list args;
+    va_start(args, fmt);
+    std::vsnprintf(line, FrameRenderer::kCols + 1, fmt, args);
+    va_end(args);
+    log_next = (log_next + 1) % kLogLines;
 }
 
 void ConsoleView::display_message(const std::string& message) {
+    SWD_ALLOC_PHASE(AllocPhase::RENDER);
+    log(">> %s", message.c_str());
     std::cout << ">> MESSAGE: " << message << "\n";
 }
 
-std::string ConsoleView::format_card_slot(int pos, const CardStructure& s) {
-    const Card* card = s.get_card(pos);
-    if (!card) return "[   ]"; 
-
-    auto acc = s.get_accessible();
-    bool is_acc = (std::find(acc.begin(), acc.end(), pos) != acc.end());
-
-    if (!card->is_face_up) return "[ ? ]";
+void ConsoleView::format_card_slot(const SlotView& slot, char out[6]) {
+    const Card* card = slot.card;
+    if (!card) { std::memcpy(out, "[   ]", 6); return; }
+    if (!card->is_face_up) { std::memcpy(out, "[ ? ]", 6); return; }
 
     // 截取名称前三位，如果是可选牌则用星号包围
-    std::string name = card->name.substr(0, 3);
-    return is_acc ? "*" + name + "*" : "[" + name + "]";
+    char open = slot.accessible ? '*' : '[';
+    char close = slot.accessible ? '*' : ']';
+    out[0] = open;
+    for (int i = 0; i < 3; ++i) out[i + 1] = i < (int)card->name.size() ? card->name[i] : ' ';
+    out[4] = close;
+    out[5] = '\0';
 }
-
-void clearScreen() {
-#ifdef _WIN32
-    system("cls");
-#else
-    system("clear");
-#endif
-}
\ No newline at end of file
@@ -1,17 +1,8 @@
 #ifndef CONSOLE_VIEW_H
 #define CONSOLE_VIEW_H
 
-#include <vector>
 #include <string>
-
-
-#ifdef _WIN32
-#include <windows.h>
-#else
-#include <unistd.h>
-#endif
-
-void clearScreen();
+#include "FrameRenderer.h"
 
 // 前向声明，减少物理依赖并加快编译速度
 class CardStructure;
@@ -21,42 +12,64 @@ class Game;
 
 /**
  * ConsoleView 类：负责将游戏逻辑状态渲染为控制台文本
+ *
+ * 整屏（军事条、双方面板、卡牌金字塔、事件日志）在 FrameRenderer 的画布上组合，
+ * 每回合只输出与上一帧不同的字符；输入提示与即时反馈打印在画布下方。
  */
 class ConsoleView {
 public:
-    // --- 结构显示 ---
-    
-    /**
-     * 核心函数：根据当前时代（1, 2, 3）绘制不同的卡牌布局
-     */
-    void display_structure(const CardStructure& structure);
+    static constexpr int kLogLines = 8;
 
-    // --- 状态显示 ---
-    
     /**
-     * 显示玩家面板：金币、胜利点、资源产出以及科技进度
+     * 核心函数：组合并输出一帧
+     * viewer 为当前行动玩家的座位号，其面板画在金字塔下方
      */
-    void display_player_status(const Player& player);
+    void render_frame(const Game& game, int viewer);
 
-    /**
-     * 显示军事冲突条：绘制 0-18 的刻度并标出棋子位置
-     */
-    void display_board(const Game& game);
+    // 下一帧整屏重绘（终端内容被其他输出打乱时使用）
+    void invalidate() { frame.invalidate(); }
 
     /**
      * 通用消息提示：用于显示“建造成功”、“钱不够”等反馈
+     * 立即打印在画布下方，同时记入事件日志
      */
     void display_message(const std::string& message);
 
+    // 向事件日志追加一行（printf 风格），在下一帧中显示
+    void log(const char* fmt, ...)
+#if defined(__GNUC__)
+        __attribute__((format(printf, 2, 3)))
+#endif
+        ;
+
+    const FrameRenderer& get_renderer() const { return frame; }
+
 private:
+    // 单个卡牌位置在本帧中的状态（每帧只从金字塔读取一次）
+    struct SlotView {
+        const Card* card;
+        bool accessible;
+    };
+
+    void draw_military(int row, const Game& game);
+    void draw_player(int row, const Player& player, bool active);
+    // 返回绘制后的下一行
+    int draw_structure(int row, const CardStructure& structure);
+    void draw_log(int row);
+
     /**
-     * 内部辅助：格式化单个卡牌位置的显示
+     * 内部辅助：格式化单个卡牌位置的显示（固定 5 个字符）
      * - 如果牌已取走：显示 "[   ]"
      * - 如果背面朝上：显示 "[ ? ]"
      * - 如果可选牌：显示 "*ABC*" (星号包围)
      * - 如果普通牌：显示 "[ABC]"
      */
-    std::string format_card_slot(int pos, const CardStructure& s);
+    static void format_card_slot(const SlotView& slot, char out[6]);
+
+    FrameRenderer frame;
+    SlotView slots[20] = {};
+    char log_lines[kLogLines][FrameRenderer::kCols + 1] = {};
+    int log_next = 0;
 };
 
-#endif // CONSOLE_VIEW_H
\ No newline at end of file
+#endif // CONSOLE_VIEW_H
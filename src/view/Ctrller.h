@@ -1,11 +1,26 @@
 #pragma once
+#include <cstdint>
 #include <string>
 #include <memory>
+#include <vector>
+#include "../core/Move.h"
 
 // 前向声明，避免循环包含
 class Game;
 class Player;
 class ConsoleView;
+class ConsoleEventLog;
+class PonderBot;
+
+/**
+ * 控制台对局选项：机器人座位、提示顾问与思考参数
+ */
+struct ConsoleOptions {
+    int bot_seat = -1;          // 由机器人执子的座位（-1 表示双方都是人类）
+    bool advisor = false;       // 人类回合可输入 -3 查看提示
+    int64_t think_ms = 2000;    // 机器人每步在已有搜索树上再思考的时间
+    int threads = 1;            // 搜索线程数
+};
 
 /**
  * Controller 类：作为游戏的中枢神经
@@ -17,7 +32,7 @@ class ConsoleView;
 class Controller {
 public:
     // 构造函数：关联单例 Game 引用
-    Controller(Game& g);
+    Controller(Game& g, const ConsoleOptions& options = ConsoleOptions());
     
     // 必须定义析构函数，因为使用了 unique_ptr 指向一个前向声明的类
     ~Controller();
@@ -27,10 +42,11 @@ public:
     Controller& operator=(const Controller&) = delete;
 
     /**
-     * 核心流程：处理一个玩家的回合
-     * 内部逻辑：显示界面 -> 循环等待输入 -> 执行动作 -> 验证成功 -> 退出
+     * 核心流程：回答对局当前停留的决策点
+     * 内部逻辑：显示界面 -> 按决策类型提示并读取输入 -> 交给 Game::apply_move -> 成功后返回
+     * @return false 表示输入已关闭（EOF），调用方应停止驱动
      */
-    void player_turn(Player& player);
+    bool resolve_decision();
 
     /**
      * UI 反馈：由 Game 逻辑层直接调用
@@ -39,6 +55,20 @@ public:
     void show_message(const std::string& msg);
 
 private:
+    // 各决策点的交互，返回 false 表示输入已关闭
+    bool pick_action(Player& player);
+    bool choose_wonder(Player& player, const Decision& decision);
+    bool choose_from_legal_moves(const char* title);
+    bool bot_move();
+    // 用卡牌/奇迹/标记名描述一个动作（机器人落子与提示共用）
+    std::string describe_move(const Move& move);
+    // 读取一个整数，非数字输入会被丢弃并重试
+    bool read_int(int& value);
+
     Game& game;                       // 引用 Game 单例
     std::unique_ptr<ConsoleView> view; // 负责渲染的视图层
+    std::unique_ptr<ConsoleEventLog> event_log; // 订阅规则事件并打印
+    std::vector<Move> options;        // 当前决策点的合法选择
+    ConsoleOptions settings;
+    std::unique_ptr<PonderBot> bot;   // 机器人与提示顾问共用：后台持续思考
 };
\ No newline at end of file
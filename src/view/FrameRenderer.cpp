@@ -0,0 +1,104 @@
+#include "FrameRenderer.h"
+#include <algorithm>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+// 两段变化之间相隔不超过该列数时合并输出，省去一次光标定位
+constexpr int kMergeGap = 4;
+}
+
+FrameRenderer::FrameRenderer(int output_fd) : fd(output_fd) {
+    std::memset(back, ' ', sizeof(back));
+    std::memset(front, ' ', sizeof(front));
+    // 最坏情况：整屏重绘，每行一个定位序列
+    out.reserve(sizeof(back) + kRows * 16 + 64);
+}
+
+void FrameRenderer::clear() {
+    std::memset(back, ' ', sizeof(back));
+}
+
+void FrameRenderer::put(int row, int col, std::string_view text) {
+    if (row < 0 || row >= kRows || col >= kCols) return;
+    for (char ch : text) {
+        if (col >= kCols) break;
+        if (col >= 0) back[row][col] = (ch == '\n' || ch == '\t') ? ' ' : ch;
+        col++;
+    }
+}
+
+void FrameRenderer::print(int row, int col, const char* fmt, ...) {
+    char line[kCols + 1];
+    va_list args;
+    va_start(args, fmt);
+    int n = std::vsnprintf(line, sizeof(line), fmt, args);
+    va_end(args);
+    if (n < 0) return;
+    put(row, col, std::string_view(line, std::min<std::size_t>(n, kCols)));
+}
+
+void FrameRenderer::append_cursor(int row, int col) {
+    char seq[16];
+    int n = std::snprintf(seq, sizeof(seq), "\x1b[%d;%dH", row + 1, col + 1);
+    out.append(seq, n);
+}
+
+void FrameRenderer::present() {
+    out.clear();
+    if (!front_valid) {
+        out += "\x1b[H\x1b[2J";
+        for (int r = 0; r < kRows; ++r) {
+            append_cursor(r, 0);
+            out.append(back[r], kCols);
+        }
+    } else {
+        for (int r = 0; r < kRows; ++r) {
+            int c = 0;
+            while (c < kCols) {
+                if (back[r][c] == front[r][c]) { c++; continue; }
+                // 找到一段变化，向后延伸并吸收较短的未变化间隙
+                int start = c, end = c + 1, gap = 0;
+                for (int k = c + 1; k < kCols && gap <= kMergeGap; ++k) {
+                    if (back[r][k] != front[r][k]) { end = k + 1; gap = 0; }
+                    else gap++;
+                }
+                append_cursor(r, start);
+                out.append(&back[r][start], end - start);
+                c = end;
+            }
+        }
+    }
+    // 光标停在画布下方，清掉上一回合留下的输入提示
+    append_cursor(kRows, 0);
+    out += "\x1b[J";
+
+    flush_output();
+    std::memcpy(front, back, sizeof(back));
+    front_valid = true;
+}
+
+void FrameRenderer::flush_output() {
+    // 先冲掉 stdio 中尚未输出的提示文字，保证顺序
+    std::fflush(stdout);
+    last_bytes = out.size();
+    const char* data = out.data();
+    std::size_t left = out.size();
+    while (left > 0) {
+#ifdef _WIN32
+        int n = _write(fd, data, static_cast<unsigned>(left));
+#else
+        ssize_t n = ::write(fd, data, left);
+#endif
+        if (n <= 0) break;
+        data += n;
+        left -= static_cast<std::size_t>(n);
+    }
+}
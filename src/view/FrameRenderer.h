@@ -0,0 +1,53 @@
+#ifndef FRAME_RENDERER_H
+#define FRAME_RENDERER_H
+
+#include <string>
+#include <string_view>
+
+/**
+ * FrameRenderer 类：双缓冲的终端字符画布
+ *
+ * - 每帧先在后台缓冲区中完整绘制，present() 时与上一帧（即终端当前内容）逐格比较，
+ *   只把变化的片段用 ANSI 光标定位序列输出，并合并为一次 write()
+ * - 两块缓冲区与输出缓冲均为定长/预分配，稳态渲染不分配内存
+ * - 输出完毕后光标停在画布下方并清除其后内容，供输入提示使用
+ * - 终端内容被外部打乱（如滚屏）时调用 invalidate()，下一帧整屏重绘
+ */
+class FrameRenderer {
+public:
+    static constexpr int kRows = 34;
+    static constexpr int kCols = 100;
+
+    explicit FrameRenderer(int fd = 1);
+
+    // 清空后台缓冲区（全部置为空格）
+    void clear();
+    // 在 (row, col) 处写入文本，超出画布的部分被截断
+    void put(int row, int col, std::string_view text);
+    // printf 风格写入
+    void print(int row, int col, const char* fmt, ...)
+#if defined(__GNUC__)
+        __attribute__((format(printf, 4, 5)))
+#endif
+        ;
+
+    // 与上一帧比较并一次性输出差异
+    void present();
+    void invalidate() { front_valid = false; }
+
+    // 最近一次 present() 输出的字节数（便于观察差量效果）
+    std::size_t last_bytes_written() const { return last_bytes; }
+
+private:
+    void append_cursor(int row, int col);
+    void flush_output();
+
+    char back[kRows][kCols];
+    char front[kRows][kCols];
+    bool front_valid = false;
+    int fd;
+    std::string out;
+    std::size_t last_bytes = 0;
+};
+
+#endif // FRAME_RENDERER_H
@@ -1,55 +1,108 @@
 #include "../view/Ctrller.h"
 #include "ConsoleView.h"
+#include "ConsoleEventLog.h"
 #include "../core/Game.h"
+#include "../core/Rules.h"
 #include "../player/Player.h"
 #include "../cards/CardStructure.h"
+#include "../instrument/Tracer.h"
+#include "../ai/PonderBot.h"
+#include <cstdio>
 #include <iostream>
 #include <algorithm>
 #include <string>
-#include <thread> 
-#include <chrono>
 
-Controller::Controller(Game& game) : game(game), view(std::make_unique<ConsoleView>()) {}
+namespace {
+
+const char* token_name(ProgressToken token) {
+    static const char* const names[] = {"Agriculture", "Architecture", "Economy", "Law", "Masonry",
+                                        "Mathematics", "Philosophy", "Strategy", "Theology", "Urbanism"};
+    return names[static_cast<int>(token)];
+}
+
+} // namespace
+
+Controller::Controller(Game& game, const ConsoleOptions& options)
+    : game(game), view(std::make_unique<ConsoleView>()), event_log(std::make_unique<ConsoleEventLog>(game, *view)),
+      settings(options) {
+    if (settings.bot_seat >= 0 || settings.advisor) {
+        bot = std::make_unique<PonderBot>(game, settings.threads, settings.think_ms);
+    }
+}
 Controller::~Controller() = default;
-void Controller::player_turn(Player& player) {
-    bool turn_finished = false;
 
-    
-    // 1. 每一回合开始前，显示当前的全局战况
-    view->display_board(game);
-    view->display_player_status(*game.get_opponent(player)); // 显示对手状态
-    view->display_player_status(player);                   // 显示自己状态
-    view->display_structure(game.get_structure());         // 显示卡牌金字塔
+bool Controller::resolve_decision() {
+    SWD_TRACE_SCOPE("turn");
+    const Decision decision = game.get_decision();
+    Player& player = *game.get_current_player();
+
+    // 每个决策点前显示当前的全局战况（只重绘与上一帧不同的部分）
+    view->render_frame(game, decision.player);
+    if (decision.player == settings.bot_seat && decision.type != Decision::Type::GAME_OVER) return bot_move();
+
+    switch (decision.type) {
+        case Decision::Type::PICK_ACTION:            return pick_action(player);
+        case Decision::Type::CHOOSE_WONDER:          return choose_wonder(player, decision);
+        case Decision::Type::CHOOSE_PROGRESS_TOKEN:  return choose_from_legal_moves("Choose a Progress Token");
+        case Decision::Type::CHOOSE_DISCARDED_CARD:  return choose_from_legal_moves("Choose a discarded card to build for free");
+        case Decision::Type::CHOOSE_CARD_TO_DESTROY: return choose_from_legal_moves("Choose an opponent card to destroy");
+        case Decision::Type::GAME_OVER:              return true;
+    }
+    return true;
+}
+
+bool Controller::read_int(int& value) {
+    while (!(std::cin >> value)) {
+        if (std::cin.eof()) return false;
+        std::cin.clear();
+        std::cin.ignore(1000, '\n');
+    }
+    return true;
+}
 
-    while (!turn_finished) {
+bool Controller::pick_action(Player& player) {
+    while (true) {
         std::cout << "\n[ " << player.get_name() << "'s Turn ]\n";
-        std::cout << "Enter Card ID to select, or -1 to see options: ";
+        std::cout << "Enter Card ID to select, -1 to see options, -2 to save"
+                  << (settings.advisor ? ", -3 for a hint: " : ": ");
         
         int card_pos;
-        if (!(std::cin >> card_pos)) {
-            std::cin.clear();
-            std::cin.ignore(1000, '\n');
+        if (!read_int(card_pos)) return false;
+
+        if (card_pos == -1) {
+            // 整屏重绘布局
+            view->invalidate();
+            view->render_frame(game, player.get_seat());
             continue;
         }
 
-        if (card_pos == -1) {
-            // 重新显示布局
-            view->display_structure(game.get_structure());
+        if (card_pos == -2) {
+            // 存档：写出完整快照，下次可用 `SevenWondersDuel <文件>` 继续
+            const std::string path = "savegame.7wd";
+            view->display_message(game.save_to_file(path) ? "Game saved to " + path : "Save failed: " + path);
+            continue;
+        }
+
+        if (card_pos == -3 && settings.advisor) {
+            // 提示来自后台一直在思考的搜索树，无需等待
+            SearchResult hint = bot->advice();
+            char buf[64];
+            std::snprintf(buf, sizeof(buf), " (win %.0f%%, %llu playouts)", hint.win_rate * 100,
+                          static_cast<unsigned long long>(hint.nodes));
+            view->display_message(hint.has_move ? "Hint: " + describe_move(hint.best) + buf : "Hint: not ready yet");
             continue;
         }
 
         // 验证卡牌是否可取
-        // const Card* selected_card = game.get_structure().get_card(card_pos);
         const CardStructure& structure = game.get_structure();
-        const Card* selected_card = structure.get_card(card_pos);
+        const Card* selected_card = (card_pos >= 0 && card_pos < rules::kPyramidSlots) ? structure.get_card(card_pos) : nullptr;
         if (!selected_card) {
             view->display_message("Invalid ID: Slot is empty.");
             continue;
         }
 
         // 检查是否被压住
-        auto acc = game.get_structure().get_accessible();
-        if (std::find(acc.begin(), acc.end(), card_pos) == acc.end()) {
+        if (!structure.is_accessible(card_pos)) {
             view->display_message("Action Failed: Card is blocked by others!");
             continue;
         }
@@ -62,45 +115,132 @@ void Controller::player_turn(Player& player) {
         std::cout << "Choice: ";
         
         int action;
-        std::cin >> action;
+        if (!read_int(action)) return false;
 
         std :: string selected_card_name = selected_card->name;
 
         switch (action) {
             case 1: // 建造
-                if (game.take_card(card_pos, player)) {
+                if (game.apply_move(Move(Move::Type::BUILD, card_pos))) {
                     view->display_message("Successfully built: " + selected_card_name);
-                    turn_finished = true;
-                } else {
-                    view->display_message("Action Failed: Not enough resources or coins!");
+                    return true;
                 }
+                view->display_message("Action Failed: Not enough resources or coins!");
                 break;
 
             case 2: // 弃牌
-                game.discard_for_coins(card_pos, player);
+                game.apply_move(Move(Move::Type::DISCARD, card_pos));
                 view->display_message("Card discarded. You gained coins.");
-                turn_finished = true;
-                break;
+                return true;
 
-            case 3: // 建奇迹
-                // 暂时简化逻辑，wonderIdx 这里假设为 0，实际应从玩家拥有的奇迹中选
-                game.build_wonder(0, card_pos, player); 
-                view->display_message("Wonder construction attempted.");
-                turn_finished = true;
+            case 3: // 建奇迹：先选定地基，奇迹在下一个决策点选择
+                if (game.apply_move(Move(Move::Type::WONDER, card_pos))) return true;
+                view->display_message("Action Failed: No wonder you can afford (or seven wonders are already built)!");
                 break;
 
             default:
                 view->display_message("Invalid choice. Try again.");
                 break;
         }
-    // 等待5s时间玩家查看结果
-    view->display_message("Wait 5 seconds to view results...");
-    std::this_thread::sleep_for(std::chrono::seconds(5));  // Sleep for 3 seconds
-    clearScreen(); // 清屏以准备下一回合
     }
 }
 
+bool Controller::choose_wonder(Player& player, const Decision& decision) {
+    while (true) {
+        std::cout << "\nChoose a Wonder to construct:\n";
+        for (int i = 0; i < player.get_wonder_count(); ++i) {
+            const Wonder& w = player.get_wonder(i);
+            std::cout << i << ". " << w.name << (w.is_built ? " (built)" : "") << "\n";
+        }
+        std::cout << "Choice: ";
+
+        int idx;
+        if (!read_int(idx)) return false;
+        if (game.apply_move(Move(Move::Type::CHOOSE_WONDER, decision.pos, idx))) {
+            view->display_message("Wonder constructed: " + player.get_wonder(idx).name);
+            return true;
+        }
+        view->display_message("Invalid choice. Try again.");
+    }
+}
+
+bool Controller::choose_from_legal_moves(const char* title) {
+    game.legal_moves(options);
+    std::vector<Card*> discard;
+    game.collect_discard_pile(discard);
+    const auto& opponent_cards = game.get_opponent()->get_built_card_names();
+
+    while (true) {
+        std::cout << "\n" << title << ":\n";
+        for (int i = 0; i < (int)options.size(); ++i) {
+            const Move& m = options[i];
+            std::cout << i << ". ";
+            switch (m.type) {
+                case Move::Type::PICK_TOKEN:      std::cout << token_name(static_cast<ProgressToken>(m.pos)); break;
+                case Move::Type::BUILD_DISCARDED: std::cout << discard[m.pos]->name; break;
+                case Move::Type::DESTROY_CARD:    std::cout << opponent_cards[m.pos]; break;
+                default: break;
+            }
+            std::cout << "\n";
+        }
+        std::cout << "Choice: ";
+
+        int idx;
+        if (!read_int(idx)) return false;
+        if (idx >= 0 && idx < (int)options.size() && game.apply_move(options[idx])) return true;
+        view->display_message("Invalid choice. Try again.");
+    }
+}
+
+bool Controller::bot_move() {
+    uint64_t reused = 0;
+    SearchResult r = bot->think(&reused);
+    if (!r.has_move) {
+        // 搜索没有给出结果时退回第一个合法动作，保证对局能继续
+        game.legal_moves(options);
+        if (options.empty()) return true;
+        r.best = options.front();
+    }
+    const std::string text = describe_move(r.best);
+    if (!game.apply_move(r.best)) return false;
+
+    char buf[96];
+    std::snprintf(buf, sizeof(buf), " (win %.0f%%, %llu new + %llu pondered playouts)", r.win_rate * 100,
+                  static_cast<unsigned long long>(r.nodes), static_cast<unsigned long long>(reused));
+    view->display_message("Bot: " + text + buf);
+    return true;
+}
+
+std::string Controller::describe_move(const Move& move) {
+    const CardStructure& structure = game.get_structure();
+    const Player& self = *game.get_current_player();
+    auto card_at = [&](int pos) -> std::string {
+        const Card* card = (pos >= 0 && pos < rules::kPyramidSlots) ? structure.get_card(pos) : nullptr;
+        return card ? card->name : "?";
+    };
+    switch (move.type) {
+        case Move::Type::BUILD:   return "Build " + card_at(move.pos);
+        case Move::Type::DISCARD: return "Discard " + card_at(move.pos);
+        case Move::Type::WONDER:
+        case Move::Type::CHOOSE_WONDER:
+            if (move.wonder_idx < 0 || move.wonder_idx >= self.get_wonder_count()) return "Wonder with " + card_at(move.pos);
+            return "Wonder " + self.get_wonder(move.wonder_idx).name + " with " + card_at(move.pos);
+        case Move::Type::PICK_TOKEN:
+            return std::string("Token ") + token_name(static_cast<ProgressToken>(move.pos));
+        case Move::Type::BUILD_DISCARDED: {
+            std::vector<Card*> discard;
+            game.collect_discard_pile(discard);
+            return "Build " + (move.pos < (int)discard.size() ? discard[move.pos]->name : std::string("?")) + " from discard";
+        }
+        case Move::Type::DESTROY_CARD: {
+            const auto& names = game.get_opponent()->get_built_card_names();
+            return "Destroy " + (move.pos < (int)names.size() ? std::string(names[move.pos]) : std::string("?"));
+        }
+    }
+    return move_to_text(move);
+}
+
 // 供 Game 触发的特殊交互显示
 void Controller::show_message(const std::string& msg) {
     view->display_message(msg);
-}
\ No newline at end of file
+}